@@ -50,6 +50,15 @@
 #   define __oridebug
 #endif
 
+// value of an oriHandle_t that does not refer to any object.
+#define ORION_NULL_HANDLE 0
+
+// maximum length (including the null terminator) of message ID names stored in oriPerformanceWarning_t structures.
+#define ORION_PERFORMANCE_WARNING_NAME_SIZE 64
+
+// amount of queue roles in the oriQueueRole_t enum.
+#define ORION_QUEUE_ROLE_COUNT 5
+
 // fallback definition for __func__ for maximum code portability
 // (see http://gcc.gnu.org/onlinedocs/gcc-4.8.1/gcc/Function-Names.html)
 #if __STDC_VERSION__ < 199901L
@@ -66,6 +75,28 @@
 // ============================================================================ //
 
 
+// ----[Orion library public interface]---------------------------------------- //
+//                                   Handles                                    //
+
+/**
+ * @brief A compact reference to an object owned by Orion.
+ *
+ * Handles are returned by functions that create library-owned objects, such as @ref oriInit() (instances),
+ * @ref oriCreateLogicalDevice() (logical devices) and @ref oriAllocateMemory() (memory allocations), and are passed to other Orion
+ * functions to refer to those objects. Handles of memory allocations are only meaningful together with the handle of their device.
+ *
+ * A handle is a 32-bit value that can be freely copied and stored. Each handle carries the type of the object and a generation
+ * count, so passing a handle of the wrong type, or one that refers to an object that has since been destroyed, is detected and
+ * reported (as @c ERR_INVALID_OBJECT and @c ERR_STALE_HANDLE respectively) rather than causing undefined behaviour.
+ *
+ * @c ORION_NULL_HANDLE (0) never refers to any object.
+ *
+ * @ingroup grp_core_man
+ *
+ */
+typedef uint32_t oriHandle_t;
+
+
 // ----[Orion library public interface]---------------------------------------- //
 //                                   Enums                                      //
 
@@ -87,6 +118,24 @@ typedef enum oriSeverityBit_t {
     ORION_DEBUG_SEVERITY_VERBOSE_BIT =  0x10    // 0b00010000
 } oriSeverityBit_t;
 
+/**
+ * @brief The category of a debug message.
+ *
+ * Categories describe @b where a debug message came from, as opposed to how severe it is. They can be used alongside
+ * severities to filter the messages recieved by a debug subscriber (see @ref oriAddDebugSubscriber()).
+ *
+ * See the @ref sct_debugging_subscribers "Debugging/Debug subscribers" section for more information.
+ *
+ * @ingroup grp_core_errors
+ *
+ */
+typedef enum oriDebugCategoryBit_t {
+    ORION_DEBUG_CATEGORY_ALL_BIT =          0xFF,   // 0b11111111
+    ORION_DEBUG_CATEGORY_GENERAL_BIT =      0x01,   // 0b00000001
+    ORION_DEBUG_CATEGORY_VULKAN_BIT =       0x02,   // 0b00000010
+    ORION_DEBUG_CATEGORY_PERFORMANCE_BIT =  0x04    // 0b00000100
+} oriDebugCategoryBit_t;
+
 /**
  * @brief The return status of an Orion function.
  *
@@ -112,6 +161,486 @@ typedef enum oriReturnStatus_t {
 } oriReturnStatus_t;
 
 
+/**
+ * @brief A named configuration of the Khronos validation layer.
+ *
+ * Validation profiles can be set with @ref oriSetValidationProfile() before calling @ref oriInit(), and will be applied
+ * to the created instance(s) if @c VK_LAYER_KHRONOS_validation is enabled. They allow validation to be kept on in long-running
+ * tests at a fraction of the overhead of enabling every check.
+ *
+ * Every profile other than @c ORION_VALIDATION_PROFILE_DEFAULT also switches off GPU-assisted validation and debug printf
+ * (if the layer supports @c VK_EXT_layer_settings), as they instrument every shader.
+ *
+ * | Profile                                       | Checks enabled                                                                  |
+ * | --------------------------------------------- | ------------------------------------------------------------------------------- |
+ * | ORION_VALIDATION_PROFILE_DEFAULT              | Whatever the layer is configured to do (Orion changes nothing).                 |
+ * | ORION_VALIDATION_PROFILE_CORE_ONLY            | Core checks, API parameters and object lifetimes.                               |
+ * | ORION_VALIDATION_PROFILE_SYNC                 | Core checks and synchronization validation.                                     |
+ * | ORION_VALIDATION_PROFILE_BEST_PRACTICES_ONLY  | Best practices checks only.                                                     |
+ * | ORION_VALIDATION_PROFILE_GPU_ASSISTED_OFF     | The layer's default CPU-side checks, with GPU-assisted validation switched off. |
+ *
+ * @ingroup grp_core_man
+ *
+ * @sa @ref oriSetValidationProfile()
+ * @sa [Vulkan Docs/VkValidationFeaturesEXT](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkValidationFeaturesEXT.html)
+ *
+ */
+typedef enum oriValidationProfile_t {
+    ORION_VALIDATION_PROFILE_DEFAULT = 0,
+    ORION_VALIDATION_PROFILE_CORE_ONLY = 1,
+    ORION_VALIDATION_PROFILE_SYNC = 2,
+    ORION_VALIDATION_PROFILE_BEST_PRACTICES_ONLY = 3,
+    ORION_VALIDATION_PROFILE_GPU_ASSISTED_OFF = 4,
+} oriValidationProfile_t;
+
+/**
+ * @brief The role of a queue requested from @ref oriSolveQueueFamilies().
+ *
+ * | Role                              | Queue families that can fulfil it                                                       |
+ * | --------------------------------- | --------------------------------------------------------------------------------------- |
+ * | ORION_QUEUE_ROLE_GRAPHICS         | Families with @c VK_QUEUE_GRAPHICS_BIT.                                                 |
+ * | ORION_QUEUE_ROLE_PRESENT          | Families that can present to the surface given to @ref oriSolveQueueFamilies().         |
+ * | ORION_QUEUE_ROLE_ASYNC_COMPUTE    | Families with @c VK_QUEUE_COMPUTE_BIT, preferably without @c VK_QUEUE_GRAPHICS_BIT.     |
+ * | ORION_QUEUE_ROLE_TRANSFER         | Any family that supports transfers, preferably one that supports nothing else.          |
+ * | ORION_QUEUE_ROLE_SPARSE           | Families with @c VK_QUEUE_SPARSE_BINDING_BIT, preferably without @c VK_QUEUE_GRAPHICS_BIT. |
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriQueueRoleRequest_t
+ * @sa @ref oriSolveQueueFamilies()
+ *
+ */
+typedef enum oriQueueRole_t {
+    ORION_QUEUE_ROLE_GRAPHICS = 0,
+    ORION_QUEUE_ROLE_PRESENT = 1,
+    ORION_QUEUE_ROLE_ASYNC_COMPUTE = 2,
+    ORION_QUEUE_ROLE_TRANSFER = 3,
+    ORION_QUEUE_ROLE_SPARSE = 4,
+} oriQueueRole_t;
+
+/**
+ * @brief Performance-related device features that can be enabled with @ref oriBuildDeviceFeatureSet().
+ *
+ * | Feature                                           | Vulkan features enabled                                                     | Core in |
+ * | ------------------------------------------------- | --------------------------------------------------------------------------- | ------- |
+ * | ORION_DEVICE_FEATURE_TIMELINE_SEMAPHORE_BIT       | @c timelineSemaphore                                                        | 1.2     |
+ * | ORION_DEVICE_FEATURE_BUFFER_DEVICE_ADDRESS_BIT    | @c bufferDeviceAddress                                                      | 1.2     |
+ * | ORION_DEVICE_FEATURE_DESCRIPTOR_INDEXING_BIT      | @c descriptorIndexing, @c runtimeDescriptorArray, @c descriptorBindingPartiallyBound, @c descriptorBindingVariableDescriptorCount, @c shaderSampledImageArrayNonUniformIndexing and @c descriptorBindingSampledImageUpdateAfterBind | 1.2 |
+ * | ORION_DEVICE_FEATURE_SYNCHRONIZATION_2_BIT        | @c synchronization2                                                         | 1.3     |
+ * | ORION_DEVICE_FEATURE_DYNAMIC_RENDERING_BIT        | @c dynamicRendering                                                         | 1.3     |
+ * | ORION_DEVICE_FEATURE_MAINTENANCE_4_BIT            | @c maintenance4                                                             | 1.3     |
+ *
+ * A feature is only available if the physical device supports the Vulkan version that it became core in.
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriBuildDeviceFeatureSet()
+ * @sa @ref oriGetEnabledDeviceFeatures()
+ *
+ */
+typedef enum oriDeviceFeatureBit_t {
+    ORION_DEVICE_FEATURE_ALL_BIT =                      0x3F,   // 0b00111111
+    ORION_DEVICE_FEATURE_TIMELINE_SEMAPHORE_BIT =       0x01,   // 0b00000001
+    ORION_DEVICE_FEATURE_BUFFER_DEVICE_ADDRESS_BIT =    0x02,   // 0b00000010
+    ORION_DEVICE_FEATURE_DESCRIPTOR_INDEXING_BIT =      0x04,   // 0b00000100
+    ORION_DEVICE_FEATURE_SYNCHRONIZATION_2_BIT =        0x08,   // 0b00001000
+    ORION_DEVICE_FEATURE_DYNAMIC_RENDERING_BIT =        0x10,   // 0b00010000
+    ORION_DEVICE_FEATURE_MAINTENANCE_4_BIT =            0x20    // 0b00100000
+} oriDeviceFeatureBit_t;
+
+/**
+ * @brief A use of a format, for which @ref oriFindBestFormat() can choose the fastest format supported by a physical device.
+ *
+ * Candidates are listed from most to least preferred; compressed and packed formats come before wider ones, as they take less
+ * memory bandwidth to read and write. All formats are checked with optimal tiling.
+ *
+ * | Usage                                     | Required features                       | Candidates                                                    |
+ * | ----------------------------------------- | --------------------------------------- | ------------------------------------------------------------- |
+ * | ORION_FORMAT_USAGE_COLOR_TEXTURE          | sampled, linear filtering               | BC7, ASTC 4x4, ETC2 RGBA8, R8G8B8A8 (UNORM)                   |
+ * | ORION_FORMAT_USAGE_COLOR_TEXTURE_SRGB     | sampled, linear filtering               | BC7, ASTC 4x4, ETC2 RGBA8, R8G8B8A8 (SRGB)                    |
+ * | ORION_FORMAT_USAGE_NORMAL_MAP             | sampled, linear filtering               | BC5, EAC R11G11, R8G8 (UNORM)                                 |
+ * | ORION_FORMAT_USAGE_HDR_TEXTURE            | sampled, linear filtering               | BC6H, B10G11R11, E5B9G9R9, R16G16B16A16 (float)               |
+ * | ORION_FORMAT_USAGE_COLOR_ATTACHMENT       | color attachment, blending              | B8G8R8A8, R8G8B8A8, A2B10G10R10 (UNORM)                       |
+ * | ORION_FORMAT_USAGE_HDR_COLOR_ATTACHMENT   | color attachment, blending              | B10G11R11, R16G16B16A16, R32G32B32A32 (float)                 |
+ * | ORION_FORMAT_USAGE_DEPTH_ATTACHMENT       | depth/stencil attachment                | D32 (float), X8 D24, D16                                      |
+ * | ORION_FORMAT_USAGE_DEPTH_STENCIL_ATTACHMENT | depth/stencil attachment              | D24 S8, D32 (float) S8, D16 S8                                |
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriFindBestFormat()
+ *
+ */
+typedef enum oriFormatUsage_t {
+    ORION_FORMAT_USAGE_COLOR_TEXTURE = 0,
+    ORION_FORMAT_USAGE_COLOR_TEXTURE_SRGB = 1,
+    ORION_FORMAT_USAGE_NORMAL_MAP = 2,
+    ORION_FORMAT_USAGE_HDR_TEXTURE = 3,
+    ORION_FORMAT_USAGE_COLOR_ATTACHMENT = 4,
+    ORION_FORMAT_USAGE_HDR_COLOR_ATTACHMENT = 5,
+    ORION_FORMAT_USAGE_DEPTH_ATTACHMENT = 6,
+    ORION_FORMAT_USAGE_DEPTH_STENCIL_ATTACHMENT = 7,
+} oriFormatUsage_t;
+
+/**
+ * @brief An intended use of a memory allocation, for which the memory manager of a logical device chooses the fastest memory type.
+ *
+ * The memory types of each usage are ranked once, when the device is created, and can be allocated from with
+ * @ref oriAllocateMemoryForUsage() and @ref oriCreateBufferForUsage().
+ *
+ * | Usage                             | Intended for                                              | Required      | Preferred (most important first)                  |
+ * | --------------------------------- | --------------------------------------------------------- | ------------- | ------------------------------------------------- |
+ * | ORION_MEMORY_USAGE_GPU_ONLY       | render targets, and resources only written by the GPU     |               | device-local, not host-visible                    |
+ * | ORION_MEMORY_USAGE_UPLOAD_ONCE    | resources written once by the CPU (e.g. meshes, textures) |               | device-local, host-visible only with resizable BAR |
+ * | ORION_MEMORY_USAGE_CPU_TO_GPU     | data written by the CPU every frame (e.g. uniforms)       | host-visible  | device-local, host-coherent, not host-cached      |
+ * | ORION_MEMORY_USAGE_GPU_TO_CPU     | data written by the GPU and read back by the CPU          | host-visible  | host-cached, not device-local, host-coherent      |
+ * | ORION_MEMORY_USAGE_STAGING        | staging buffers that the GPU copies from                  | host-visible  | not device-local, host-coherent, not host-cached  |
+ *
+ * Lazily allocated and protected memory types are never chosen, nor are AMD device-coherent types (which are uncached).
+ *
+ * A device counts as having resizable BAR (or as sharing its memory with the host, as integrated GPUs do) if it has a
+ * host-visible, device-local memory heap larger than 1 GiB. Resources with the @c UPLOAD_ONCE usage can then be written to
+ * directly instead of through a staging buffer; check whether the memory type given by @ref oriGetAllocationInfo() is
+ * host-visible to find out which was chosen. Without resizable BAR, the small (usually 256 MiB) host-visible device-local heap
+ * is left to @c CPU_TO_GPU memory such as the ring buffer of @ref oriCreateDeviceRing().
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriFindMemoryTypeForUsage()
+ * @sa @ref oriAllocateMemoryForUsage()
+ *
+ */
+typedef enum oriMemoryUsage_t {
+    ORION_MEMORY_USAGE_GPU_ONLY = 0,
+    ORION_MEMORY_USAGE_UPLOAD_ONCE = 1,
+    ORION_MEMORY_USAGE_CPU_TO_GPU = 2,
+    ORION_MEMORY_USAGE_GPU_TO_CPU = 3,
+    ORION_MEMORY_USAGE_STAGING = 4,
+} oriMemoryUsage_t;
+
+
+// ----[Orion library public interface]---------------------------------------- //
+//                                  Structures                                  //
+
+/**
+ * @brief An entry in the performance warning histogram of an Orion-managed Vulkan debug messenger.
+ *
+ * Each entry corresponds to one distinct validation message ID of type
+ * [VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkDebugUtilsMessageTypeFlagBitsEXT.html).
+ *
+ * @ingroup grp_core_errors
+ *
+ * @sa @ref oriCreateDebugMessenger()
+ * @sa @ref oriEnumeratePerformanceWarnings()
+ *
+ */
+typedef struct oriPerformanceWarning_t {
+    int32_t messageID;                                          ///< the @c messageIdNumber reported by Vulkan
+    char messageName[ORION_PERFORMANCE_WARNING_NAME_SIZE];      ///< the @c pMessageIdName reported by Vulkan (truncated if necessary)
+    uint64_t count;                                             ///< the amount of times the message was reported
+} oriPerformanceWarning_t;
+
+/**
+ * @brief Totals kept by the Orion object tracker.
+ *
+ * @ingroup grp_core_errors
+ *
+ * @sa @ref oriSetObjectTrackingEnabled()
+ * @sa @ref oriGetObjectTrackerStats()
+ *
+ */
+typedef struct oriObjectTrackerStats_t {
+    uint64_t liveObjects;       ///< the amount of tracked objects created but not yet destroyed
+    uint64_t liveBytes;         ///< the sum of the sizes of all live objects
+    uint64_t totalCreated;      ///< the amount of object creations recorded since tracking was first enabled
+    uint64_t totalDestroyed;    ///< the amount of object destructions recorded since tracking was first enabled
+    int64_t growth;             ///< the change in @c liveObjects since the last call to @ref oriReportLiveObjects()
+} oriObjectTrackerStats_t;
+
+/**
+ * @brief Weights of each component of the physical device scoring model used by @ref oriRankPhysicalDevices().
+ *
+ * Each component of the model gives a device a score between 0 and 1; the final score of a device is the sum of the components
+ * multiplied by their weights (plus the result of the custom scoring function, if there is one). Setting a weight to 0 removes
+ * that component from the model.
+ *
+ * | Component       | A device scores higher if...                                                                       |
+ * | --------------- | -------------------------------------------------------------------------------------------------- |
+ * | @c deviceType   | it is a discrete GPU (1.0), then integrated (0.5), virtual (0.35) or CPU (0.1).                    |
+ * | @c localMemory  | it has more device-local heap memory (logarithmically, up to 64 GiB).                              |
+ * | @c queueFamilies| it has dedicated compute and transfer queue families, and sparse binding support.                  |
+ * | @c limits       | it has higher image, compute, descriptor, push constant and anisotropy limits.                     |
+ * | @c extensions   | it supports more of the preferred extensions given in @ref oriPhysicalDeviceRankInfo_t.            |
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriGetDefaultPhysicalDeviceScoreWeights()
+ *
+ */
+typedef struct oriPhysicalDeviceScoreWeights_t {
+    float deviceType;       ///< weight of the device type component
+    float localMemory;      ///< weight of the device-local memory component
+    float queueFamilies;    ///< weight of the queue family richness component
+    float limits;           ///< weight of the device limits component
+    float extensions;       ///< weight of the preferred extension support component
+} oriPhysicalDeviceScoreWeights_t;
+
+/**
+ * @brief A physical device ranked by @ref oriRankPhysicalDevices(), along with the properties that were used to score it.
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriRankPhysicalDevices()
+ *
+ */
+typedef struct oriRankedPhysicalDevice_t {
+    VkPhysicalDevice device;                                ///< the ranked physical device
+    float score;                                            ///< the final score of the device
+    unsigned int enumerationIndex;                          ///< the index of the device as enumerated by Vulkan
+
+    VkPhysicalDeviceProperties properties;                  ///< the properties of the device
+    VkPhysicalDeviceMemoryProperties memoryProperties;      ///< the memory properties of the device
+    VkDeviceSize deviceLocalMemory;                         ///< the total size of the device-local memory heaps of the device
+    unsigned int queueFamilyCount;                          ///< the amount of queue families available to the device
+    VkQueueFlags dedicatedQueueFlags;                       ///< @c VK_QUEUE_COMPUTE_BIT and/or @c VK_QUEUE_TRANSFER_BIT if the device has families dedicated to them
+    unsigned int preferredExtensionCount;                   ///< the amount of preferred extensions supported by the device
+} oriRankedPhysicalDevice_t;
+
+/**
+ * @brief A queue role requested from @ref oriSolveQueueFamilies().
+ *
+ * Roles with a higher priority are given the best queue families first, so if there are not enough dedicated families or
+ * queues to go around, the roles with the lowest priority are the ones that end up sharing.
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriSolveQueueFamilies()
+ *
+ */
+typedef struct oriQueueRoleRequest_t {
+    oriQueueRole_t role;    ///< the requested role
+    float priority;         ///< the priority of the role, between 0 and 1 (this is also used as the Vulkan queue priority)
+    bool required;          ///< if true, @ref oriSolveQueueFamilies() fails if no queue family can fulfil the role
+} oriQueueRoleRequest_t;
+
+/**
+ * @brief The queue assigned to a role by @ref oriSolveQueueFamilies().
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriQueueSolution_t
+ *
+ */
+typedef struct oriQueueAssignment_t {
+    bool assigned;                  ///< false if the role was not requested, or if it was optional and no queue family could fulfil it
+    unsigned int familyIndex;       ///< the index of the queue family of the queue
+    unsigned int queueIndex;        ///< the index of the queue within its family (to be passed to @c vkGetDeviceQueue())
+    bool exclusive;                 ///< true if no other role was assigned the same queue
+    bool dedicated;                 ///< true if the queue family is specialised for the role (e.g. a compute family without graphics support)
+} oriQueueAssignment_t;
+
+/**
+ * @brief The queue families and queues chosen by @ref oriSolveQueueFamilies().
+ *
+ * The @c queueCreateInfos array can be passed directly to @ref oriCreateLogicalDevice().
+ *
+ * @warning The @c pQueuePriorities members of @c queueCreateInfos point into @c queuePriorities, so the structure must not be copied
+ * or moved until the logical device has been created.
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriSolveQueueFamilies()
+ *
+ */
+typedef struct oriQueueSolution_t {
+    oriQueueAssignment_t assignments[ORION_QUEUE_ROLE_COUNT];                       ///< the queue assigned to each role, indexed by @ref oriQueueRole_t
+    unsigned int queueCreateInfoCount;                                              ///< the amount of elements of @c queueCreateInfos in use
+    VkDeviceQueueCreateInfo queueCreateInfos[ORION_QUEUE_ROLE_COUNT];               ///< one create info structure per queue family used
+    float queuePriorities[ORION_QUEUE_ROLE_COUNT][ORION_QUEUE_ROLE_COUNT];          ///< storage for the queue priorities referenced by @c queueCreateInfos
+} oriQueueSolution_t;
+
+/**
+ * @brief A chain of Vulkan feature structures built by @ref oriBuildDeviceFeatureSet().
+ *
+ * To create a logical device with the features in the set, pass @c &features2 as the @c deviceNext parameter of
+ * @ref oriCreateLogicalDevice() (and NULL as @c enabledFeatures, since the core features are in @c features2). You can enable further
+ * features in the structures yourself before doing so.
+ *
+ * @warning The structures are chained to each other, so the set must not be copied or moved until the logical device has been
+ * created.
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriBuildDeviceFeatureSet()
+ *
+ */
+typedef struct oriDeviceFeatureSet_t {
+    VkPhysicalDeviceFeatures2 features2;            ///< the head of the chain, holding the core (1.0) features
+    VkPhysicalDeviceVulkan12Features vulkan12;      ///< the Vulkan 1.2 features (only chained if the device supports Vulkan 1.2)
+    VkPhysicalDeviceVulkan13Features vulkan13;      ///< the Vulkan 1.3 features (only chained if the device supports Vulkan 1.3)
+
+    uint32_t requested;                             ///< the @ref oriDeviceFeatureBit_t flags that were requested
+    uint32_t enabled;                               ///< the @ref oriDeviceFeatureBit_t flags that were supported, and so enabled
+} oriDeviceFeatureSet_t;
+
+/**
+ * @brief A snapshot of the limits of a logical device's physical device that are used when sub-allocating and copying resources.
+ *
+ * The snapshot is taken once by @ref oriCreateLogicalDevice(). Every alignment Vulkan reports here is a power of two, so each one is
+ * also stored as a mask (the alignment minus one) for use with @ref oriAlignUp(), @ref oriAlignDown() and @ref oriIsAligned(), which
+ * need no division.
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriGetDeviceLimits()
+ *
+ */
+typedef struct oriDeviceLimits_t {
+    VkDeviceSize uniformBufferOffsetAlignment;          ///< @c minUniformBufferOffsetAlignment
+    VkDeviceSize uniformBufferOffsetMask;               ///< @c minUniformBufferOffsetAlignment - 1
+    VkDeviceSize storageBufferOffsetAlignment;          ///< @c minStorageBufferOffsetAlignment
+    VkDeviceSize storageBufferOffsetMask;               ///< @c minStorageBufferOffsetAlignment - 1
+    VkDeviceSize texelBufferOffsetAlignment;            ///< @c minTexelBufferOffsetAlignment
+    VkDeviceSize texelBufferOffsetMask;                 ///< @c minTexelBufferOffsetAlignment - 1
+    VkDeviceSize nonCoherentAtomSize;                   ///< @c nonCoherentAtomSize
+    VkDeviceSize nonCoherentAtomMask;                   ///< @c nonCoherentAtomSize - 1
+    VkDeviceSize bufferImageGranularity;                ///< @c bufferImageGranularity
+    VkDeviceSize bufferImageGranularityMask;            ///< @c bufferImageGranularity - 1
+    VkDeviceSize optimalBufferCopyOffsetAlignment;      ///< @c optimalBufferCopyOffsetAlignment
+    VkDeviceSize optimalBufferCopyOffsetMask;           ///< @c optimalBufferCopyOffsetAlignment - 1
+    VkDeviceSize optimalBufferCopyRowPitchAlignment;    ///< @c optimalBufferCopyRowPitchAlignment
+    VkDeviceSize optimalBufferCopyRowPitchMask;         ///< @c optimalBufferCopyRowPitchAlignment - 1
+    VkDeviceSize minMemoryMapAlignment;                 ///< @c minMemoryMapAlignment
+    VkDeviceSize minMemoryMapMask;                      ///< @c minMemoryMapAlignment - 1
+    VkDeviceSize minImportedHostPointerAlignment;       ///< @c minImportedHostPointerAlignment (1 if @c VK_EXT_external_memory_host is not enabled, or without Vulkan 1.1)
+    VkDeviceSize minImportedHostPointerMask;            ///< @c minImportedHostPointerAlignment - 1
+
+    uint32_t maxMemoryAllocationCount;                  ///< @c maxMemoryAllocationCount
+    uint32_t maxUniformBufferRange;                     ///< @c maxUniformBufferRange
+    uint32_t maxStorageBufferRange;                     ///< @c maxStorageBufferRange
+    uint32_t maxPushConstantsSize;                      ///< @c maxPushConstantsSize
+    float timestampPeriod;                              ///< @c timestampPeriod
+} oriDeviceLimits_t;
+
+/**
+ * @brief Where a memory allocation made with @ref oriAllocateMemory() (or one of its variants) is.
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriGetAllocationInfo()
+ *
+ */
+typedef struct oriAllocationInfo_t {
+    VkDeviceMemory memory;      ///< the device memory object that the allocation is part of
+    VkDeviceSize offset;        ///< the offset of the allocation in @c memory
+    VkDeviceSize size;          ///< the size of the allocation (which may be more than was asked for)
+    uint32_t memoryTypeIndex;   ///< the memory type of @c memory
+    VkMemoryPropertyFlags propertyFlags; ///< the properties of the memory type (e.g. whether it can be mapped)
+    VkBuffer buffer;            ///< the buffer that owns the allocation if it was made with @ref oriCreateBuffer() (which may change after @ref oriDefragment()), otherwise VK_NULL_HANDLE
+    bool dedicated;             ///< true if @c memory is dedicated to the allocation (see @ref oriAllocateMemory())
+    void *mappedData;           ///< a pointer to the allocation if its memory is host-visible (which stays valid until it is freed or moved by @ref oriDefragment()), otherwise NULL
+} oriAllocationInfo_t;
+
+/**
+ * @brief Statistics of the defragmenter of a logical device, accumulated over every call to @ref oriDefragment().
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ */
+typedef struct oriDefragmentStats_t {
+    uint64_t movedAllocations;      ///< the amount of allocations that have been moved
+    VkDeviceSize movedBytes;        ///< the amount of memory that has been copied
+    uint32_t releasedBlocks;        ///< the amount of device memory blocks that were released because they were emptied
+    VkDeviceSize releasedBytes;     ///< the size of the released blocks (i.e. how much device memory defragmentation has given back)
+    uint32_t pendingReleases;       ///< the amount of moved allocations whose old memory is waiting for the GPU to finish with it
+} oriDefragmentStats_t;
+
+/**
+ * @brief Memory budget and usage of a single memory heap.
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ */
+typedef struct oriMemoryHeapBudget_t {
+    VkDeviceSize budget;            ///< how much memory the process can use from the heap before allocations may fail or hurt performance
+    VkDeviceSize usage;             ///< an estimate of how much memory the whole process is using from the heap
+    VkDeviceSize blockBytes;        ///< how much device memory the device's memory manager has allocated from the heap
+    VkDeviceSize allocationBytes;   ///< how much of @c blockBytes is taken up by sub-allocations
+} oriMemoryHeapBudget_t;
+
+/**
+ * @brief Memory budget and usage of each memory heap of a logical device, as returned by @ref oriGetMemoryBudget().
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ */
+typedef struct oriMemoryBudget_t {
+    uint32_t heapCount;                                 ///< the amount of memory heaps of the device
+    oriMemoryHeapBudget_t heaps[VK_MAX_MEMORY_HEAPS];   ///< the budget and usage of each memory heap
+    bool budgetExtension;                               ///< true if the budgets were reported by VK_EXT_memory_budget, false if they are estimated
+} oriMemoryBudget_t;
+
+/**
+ * @brief Statistics of a set of device memory blocks of a logical device's memory manager.
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriGetMemoryStatistics()
+ * @sa @ref oriEnumerateMemoryBlocks()
+ *
+ */
+typedef struct oriMemoryStatistics_t {
+    uint32_t blockCount;            ///< the amount of device memory blocks
+    uint32_t allocationCount;       ///< the amount of allocations in the blocks (including moved allocations waiting to be released)
+    VkDeviceSize blockBytes;        ///< the total size of the blocks
+    VkDeviceSize usedBytes;         ///< how much of the blocks is taken up by allocations
+    VkDeviceSize freeBytes;         ///< how much of the blocks is free
+    uint32_t freeRangeCount;        ///< the amount of separate free ranges in the blocks
+    VkDeviceSize largestFreeRange;  ///< the size of the largest free range (roughly the largest allocation that fits without a new block)
+    float fragmentation;            ///< 1 - @c largestFreeRange / @c freeBytes: 0 if the free memory is in a single range, approaching 1 the more it is split up
+} oriMemoryStatistics_t;
+
+/**
+ * @brief Statistics of the memory manager of a logical device, as returned by @ref oriGetMemoryStatistics().
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ */
+typedef struct oriDeviceMemoryStatistics_t {
+    oriMemoryStatistics_t total;                                ///< statistics of every block
+    uint32_t heapCount;                                         ///< the amount of memory heaps of the device
+    oriMemoryStatistics_t heaps[VK_MAX_MEMORY_HEAPS];           ///< statistics of the blocks of each memory heap
+    uint32_t memoryTypeCount;                                   ///< the amount of memory types of the device
+    oriMemoryStatistics_t memoryTypes[VK_MAX_MEMORY_TYPES];     ///< statistics of the blocks of each memory type
+} oriDeviceMemoryStatistics_t;
+
+/**
+ * @brief Statistics of a single device memory block, as returned by @ref oriEnumerateMemoryBlocks().
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ */
+typedef struct oriMemoryBlockStatistics_t {
+    VkDeviceMemory memory;              ///< the device memory object of the block
+    uint32_t memoryTypeIndex;           ///< the memory type of the block
+    bool dedicated;                     ///< true if the block is the dedicated memory of a single allocation
+    bool imported;                      ///< true if the block is host memory imported with @ref oriImportHostMemory()
+    oriMemoryStatistics_t statistics;   ///< statistics of the block (with a @c blockCount of 1)
+} oriMemoryBlockStatistics_t;
+
+/**
+ * @brief A range of the ring buffer of a device, allocated with @ref oriRingAllocate().
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ */
+typedef struct oriRingAllocation_t {
+    VkBuffer buffer;            ///< the ring buffer
+    VkDeviceSize offset;        ///< the offset of the range in @c buffer
+    uint32_t dynamicOffset;     ///< @c offset, for use as a dynamic offset in vkCmdBindDescriptorSets()
+    void *data;                 ///< a host pointer to the range, which can be written to until the range is reclaimed
+} oriRingAllocation_t;
+
+
 // ----[Orion library public interface]---------------------------------------- //
 //                          Function pointer typedefs                           //
 
@@ -175,6 +704,78 @@ typedef bool (* oriPhysicalDeviceSuitabilityCheckfun)(
     const VkPhysicalDevice device
 );
 
+/**
+ * @brief Custom scoring function for physical devices.
+ *
+ * A function of this signature can be given to @ref oriRankPhysicalDevices() to extend the built-in scoring model. The
+ * value it returns is added to the score of the device calculated by the weighted model.
+ *
+ * @param device the device being scored, including its cached properties. @c score holds the score from the weighted model.
+ * @param pointer the user data given in @ref oriPhysicalDeviceRankInfo_t.
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriRankPhysicalDevices()
+ *
+ */
+typedef float (* oriPhysicalDeviceScorefun)(
+    const oriRankedPhysicalDevice_t *device,
+    void *pointer
+);
+
+
+/**
+ * @brief Callback function to evict an allocation from device memory.
+ *
+ * A function of this signature can be given to @ref oriSetAllocationEvictable() to let the memory manager of a device
+ * evict the allocation when a memory heap gets close to its budget. The function is called with no locks held.
+ *
+ * The function should free the allocation (and destroy whatever uses it) once the GPU has finished with it, so that it can be
+ * recreated when it is next needed. The allocation must not be used after the function returns @b true.
+ *
+ * @param device the handle of the logical device that the allocation was made from.
+ * @param allocation the handle of the allocation to evict.
+ * @param size the size of the allocation.
+ * @param userData the user data given in @ref oriSetAllocationEvictable().
+ * @return @b true if the allocation was (or will be) evicted, @b false if it can't be evicted right now.
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriSetAllocationEvictable()
+ * @sa @ref oriEnforceMemoryBudget()
+ *
+ */
+typedef bool (* oriEvictionCallbackfun)(
+    const oriHandle_t device,
+    const oriHandle_t allocation,
+    const VkDeviceSize size,
+    void *userData
+);
+
+// ----[Orion library public interface]---------------------------------------- //
+//                 Structures referencing function pointer types                //
+
+/**
+ * @brief Parameters for ranking physical devices with @ref oriRankPhysicalDevices().
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriRankPhysicalDevices()
+ *
+ */
+typedef struct oriPhysicalDeviceRankInfo_t {
+    oriPhysicalDeviceScoreWeights_t weights;                ///< weights of the scoring model (see @ref oriGetDefaultPhysicalDeviceScoreWeights())
+
+    unsigned int requiredExtensionCount;                    ///< the size of the @c requiredExtensions array
+    const char **requiredExtensions;                        ///< names of device extensions without which a device is excluded
+    unsigned int preferredExtensionCount;                   ///< the size of the @c preferredExtensions array
+    const char **preferredExtensions;                       ///< names of device extensions that count towards the @c extensions component
+
+    oriPhysicalDeviceSuitabilityCheckfun checkFun;          ///< NULL, or a function to exclude unsuitable devices
+    oriPhysicalDeviceScorefun scoreFun;                     ///< NULL, or a function whose result is added to each score
+    void *pointer;                                          ///< user data passed to @c scoreFun
+} oriPhysicalDeviceRankInfo_t;
+
 
 // ----[Orion library public interface]---------------------------------------- //
 //                             Library management                               //
@@ -197,8 +798,13 @@ typedef bool (* oriPhysicalDeviceSuitabilityCheckfun)(
  * @note Specifying the same layer or extension multiple times @b will cause problems, as duplicates are not accounted for. It is on you to avoid
  * duplicates.
  *
+ * If a validation profile was set with @ref oriSetValidationProfile() and @c VK_LAYER_KHRONOS_validation is enabled, the structures
+ * needed for the profile are chained in front of @c instanceNext, and the extensions they require are enabled automatically.
+ *
  * @param instanceCount the amount of instances to create. This should be 1 in almost all cases, and <b>cannot be 0</b>.
  * @param instanceOut if `instanceCount` was 1, then this is a pointer to the VkInstance struct to initialise. Otherwise, it is an array of VkInstance structs.
+ * @param handlesOut NULL or an array of @c instanceCount @ref oriHandle_t variables into which the handles of the instances will be returned.
+ * These handles are used to refer to the instances in other Orion functions.
  * @param instanceFlags a bitmask of [VkInstanceCreateFlagBits](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkInstanceCreateFlagBits.html)
  * indicating the collective behaviour of the instances.
  * @param apiVersion the Vulkan API version.
@@ -212,7 +818,7 @@ typedef bool (* oriPhysicalDeviceSuitabilityCheckfun)(
  * @param enabledInstanceExtensions an array of the names of the extensions to enable for the instances.
  * @param instanceNext NULL or a pointer to a structure to extend the instance creation info structures.
  * @return [OK](@ref oriReturnStatus_t) if executed successfully
- * @return [SKIPPED](@ref oriReturnStatus_t) if the library was already initialised or if an instance was already created to @c instanceOut
+ * @return [SKIPPED](@ref oriReturnStatus_t) if the library was already initialised
  * @return [NO_OUTPUT](@ref oriReturnStatus_t) if @c instanceOut is NULL
  * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c enabledLayers is NULL but @c enabledLayerCount is more than 0, or for the @c enabledInstanceExtension* equivalents
  * @return [ERROR](@ref oriReturnStatus_t) if there was an unspecified error, or if memory for the instance failed to allocate
@@ -222,11 +828,76 @@ typedef bool (* oriPhysicalDeviceSuitabilityCheckfun)(
  * @sa [Vulkan Docs/VkInstance](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkInstance.html)
  * @sa [Vulkan Docs/VkInstanceCreateFlagBits](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkInstanceCreateFlagBits.html)
  * @sa @ref oriTerminate()
+ * @sa @ref oriSetValidationProfile()
  *
  */
 const oriReturnStatus_t oriInit(
     const unsigned int instanceCount,
     VkInstance *instanceOut,
+    oriHandle_t *handlesOut,
+    const VkInstanceCreateFlags instanceFlags,
+    const unsigned int apiVersion,
+    const char *applicationName,
+    const unsigned int applicationVersion,
+    const char *engineName,
+    const unsigned int engineVersion,
+    const unsigned int enabledLayerCount,
+    const char **enabledLayers,
+    const unsigned int enabledInstanceExtensionCount,
+    const char **enabledInstanceExtensions,
+    const void *instanceNext
+);
+
+/**
+ * @brief Initialise the library in a background thread.
+ *
+ * This function does the same as @ref oriInit() (and takes the same parameters), but returns as soon as a thread has been
+ * started to do it. Loading the Vulkan loader and drivers and creating the instance can take hundreds of milliseconds, which
+ * can then be overlapped with the application's own startup work.
+ *
+ * Once the instance(s) have been created, the thread also enumerates the physical devices of each instance and fills their
+ * format property tables (see @ref oriPrefetchFormatProperties()).
+ *
+ * The parameters are copied, except for @c instanceOut, @c handlesOut and @c instanceNext, which must stay valid until the
+ * initialisation has finished. @c instanceOut and @c handlesOut are only written when it finishes, so you must call
+ * @ref oriWaitInit() before reading them.
+ *
+ * Other Orion functions that depend on the library being initialised (such as @ref oriTerminate(), and any function that takes
+ * an Orion handle) wait for the initialisation to finish implicitly. Debug messages and callbacks should be configured before
+ * this function is called.
+ *
+ * If the thread can't be started, the library is initialised before this function returns.
+ *
+ * @param instanceCount see @ref oriInit().
+ * @param instanceOut see @ref oriInit().
+ * @param handlesOut see @ref oriInit().
+ * @param instanceFlags see @ref oriInit().
+ * @param apiVersion see @ref oriInit().
+ * @param applicationName see @ref oriInit().
+ * @param applicationVersion see @ref oriInit().
+ * @param engineName see @ref oriInit().
+ * @param engineVersion see @ref oriInit().
+ * @param enabledLayerCount see @ref oriInit().
+ * @param enabledLayers see @ref oriInit().
+ * @param enabledInstanceExtensionCount see @ref oriInit().
+ * @param enabledInstanceExtensions see @ref oriInit().
+ * @param instanceNext see @ref oriInit().
+ * @return [OK](@ref oriReturnStatus_t) if the initialisation was started successfully
+ * @return [SKIPPED](@ref oriReturnStatus_t) if the library was already initialised
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if @c instanceOut is NULL
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c enabledLayers is NULL but @c enabledLayerCount is more than 0, or for the @c enabledInstanceExtension* equivalents
+ * @return [ERROR](@ref oriReturnStatus_t) if there was a memory error
+ *
+ * @ingroup grp_core_man
+ *
+ * @sa @ref oriInit()
+ * @sa @ref oriWaitInit()
+ *
+ */
+const oriReturnStatus_t oriInitAsync(
+    const unsigned int instanceCount,
+    VkInstance *instanceOut,
+    oriHandle_t *handlesOut,
     const VkInstanceCreateFlags instanceFlags,
     const unsigned int apiVersion,
     const char *applicationName,
@@ -240,12 +911,31 @@ const oriReturnStatus_t oriInit(
     const void *instanceNext
 );
 
+/**
+ * @brief Wait for an initialisation started with @ref oriInitAsync() to finish.
+ *
+ * It is safe to call this function any amount of times, from any thread. Once it returns, the variables given to @ref oriInitAsync()
+ * as @c instanceOut and @c handlesOut can be read.
+ *
+ * @return the value that @ref oriInit() returned for the initialisation
+ * @return [SKIPPED](@ref oriReturnStatus_t) if @ref oriInitAsync() has not been called since the library was last terminated
+ *
+ * @ingroup grp_core_man
+ *
+ * @sa @ref oriInitAsync()
+ *
+ */
+const oriReturnStatus_t oriWaitInit();
+
 /**
  * @brief Terminate the library and destroy the instance that was created with @ref oriInit().
  *
  * This function terminates the Orion library as well as @b destroying the instance that was previously created
  * using @ref oriInit().
  *
+ * Any logical devices created with @ref oriCreateLogicalDevice() that have not been destroyed with @ref oriDestroyLogicalDevice()
+ * are destroyed first. All Orion handles become invalid.
+ *
  * You should be able to initialise the library again after calling this function.
  *
  * @return [OK](@ref oriReturnStatus_t) if executed successfully
@@ -257,6 +947,112 @@ const oriReturnStatus_t oriInit(
  */
 const oriReturnStatus_t oriTerminate();
 
+/**
+ * @brief Optionally set the validation profile to apply to the instance(s) created by @ref oriInit().
+ *
+ * This optional function sets the @ref oriValidationProfile_t that will be applied in the next call to @ref oriInit(), and
+ * so must be called before it. The profile is reset to @c ORION_VALIDATION_PROFILE_DEFAULT by @ref oriTerminate().
+ *
+ * When a profile is set and @c VK_LAYER_KHRONOS_validation is among the enabled layers, @ref oriInit() will chain the
+ * structures needed for the profile into the instance's @c pNext chain, and will enable the instance extensions they require
+ * (@c VK_EXT_validation_features and, if available, @c VK_EXT_layer_settings) automatically.
+ *
+ * If @c instanceNext already contains a [VkValidationFeaturesEXT](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkValidationFeaturesEXT.html)
+ * structure, the profile will not be applied.
+ *
+ * @param profile the validation profile to use.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [SKIPPED](@ref oriReturnStatus_t) if the library is already initialised
+ *
+ * @ingroup grp_core_man
+ *
+ * @sa @ref oriValidationProfile_t
+ * @sa @ref oriGetValidationProfile()
+ *
+ */
+const oriReturnStatus_t oriSetValidationProfile(
+    const oriValidationProfile_t profile
+);
+
+/**
+ * @brief Retrieve the validation profile set with @ref oriSetValidationProfile().
+ *
+ * @return the current validation profile.
+ *
+ * @ingroup grp_core_man
+ *
+ * @sa @ref oriSetValidationProfile()
+ *
+ */
+const oriValidationProfile_t oriGetValidationProfile();
+
+/**
+ * @brief Optionally load a Vulkan driver directly, bypassing the loader's driver discovery.
+ *
+ * Normally, the Vulkan loader reads the manifest file of every installed driver and loads each driver to probe it when an
+ * instance is created. On systems with many drivers installed (such as containers), this can take up most of the time spent
+ * creating the instance.
+ *
+ * This function opens the driver library at @c driverPath, which will be given to the loader with @c VK_LUNARG_direct_driver_loading
+ * in the next call to @ref oriInit(). The structures and extension that this needs are chained and enabled automatically. If
+ * @c exclusive is true, no other drivers will be loaded at all; otherwise, the loader also discovers drivers as usual.
+ *
+ * If no driver is set with this function, the path in the @c ORION_DIRECT_DRIVER environment variable (if it is set) is loaded
+ * exclusively instead. This allows a known-good driver to be configured per machine without changing the application.
+ *
+ * If the Vulkan loader does not support @c VK_LUNARG_direct_driver_loading, @ref oriInit() falls back to driver discovery.
+ *
+ * This function must be called before @ref oriInit(). The driver is reset (and its library closed) by @ref oriTerminate().
+ *
+ * @note Direct driver loading is only supported on Unix-like platforms.
+ *
+ * @param driverPath NULL, or the path of the driver library to load (e.g. @c libvulkan_lvp.so for Mesa's lavapipe).
+ * @param exclusive true to load only this driver, or false to load it as well as any drivers the loader finds.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [SKIPPED](@ref oriReturnStatus_t) if the library is already initialised, or if direct driver loading is not supported on this platform
+ * @return [ERROR](@ref oriReturnStatus_t) if the library could not be opened, or if it is not a Vulkan driver
+ *
+ * @ingroup grp_core_man
+ *
+ * @sa [Vulkan Docs/VkDirectDriverLoadingListLUNARG](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkDirectDriverLoadingListLUNARG.html)
+ *
+ */
+const oriReturnStatus_t oriSetDirectDriver(
+    const char *driverPath,
+    const bool exclusive
+);
+
+/**
+ * @brief Use a persistent cache file to skip the layer, extension and format queries repeated on every start of the application.
+ *
+ * If a startup cache is in use, the results of the queries made by @ref oriCheckLayerAvailability(),
+ * @ref oriCheckInstanceExtensionAvailability(), @ref oriCheckDeviceExtensionAvailability() (and so by @ref oriInit() and
+ * @ref oriCreateLogicalDevice()), and the format property tables (see @ref oriPrefetchFormatProperties()) are stored in the file.
+ * The file is mapped into memory by this function, and the stored results are used instead of querying Vulkan again.
+ *
+ * Stored results are only used if nothing that could change them has changed since they were stored: the Vulkan loader version,
+ * the driver and layer manifest files that the loader searches (and their sizes and modification times), the environment variables
+ * that affect the loader, and the driver version and pipeline cache UUID of each physical device. Otherwise, the file is rebuilt.
+ *
+ * Results that were not in the file are written to it in @ref oriTerminate(). The file is replaced atomically, so several processes
+ * can share it.
+ *
+ * This function must be called before @ref oriInit(). Pass NULL to stop using the cache.
+ *
+ * @note The startup cache is only supported on Unix-like platforms.
+ *
+ * @param path NULL, or the path of the cache file (it does not need to exist yet).
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [SKIPPED](@ref oriReturnStatus_t) if the library is already initialised, or if the startup cache is not supported on this platform
+ * @return [ERROR](@ref oriReturnStatus_t) if there was a memory error
+ *
+ * @ingroup grp_core_man
+ *
+ */
+const oriReturnStatus_t oriSetStartupCachePath(
+    const char *path
+);
+
 /**
  * @brief Optionally define the memory allocation functions to be used in Vulkan functions.
  *
@@ -300,6 +1096,19 @@ const oriReturnStatus_t oriSetVulkanAllocators(
  */
 const VkAllocationCallbacks *oriGetVulkanAllocators();
 
+/**
+ * @brief Retrieve the [VkInstance](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkInstance.html) that an instance handle refers to.
+ *
+ * @param instance the handle of the instance (see @ref oriInit()).
+ * @return the Vulkan handle of the instance, or @c VK_NULL_HANDLE if @c instance is invalid or stale.
+ *
+ * @ingroup grp_core_man
+ *
+ */
+const VkInstance oriGetVkInstance(
+    const oriHandle_t instance
+);
+
 
 // ----[Orion library public interface]---------------------------------------- //
 //                                   Debugging                                  //
@@ -395,6 +1204,247 @@ const oriDebugCallbackfun oriGetDebugCallback();
  */
 const void *oriGetDebugCallbackUserData();
 
+/**
+ * @brief Register an additional debug subscriber with its own severity and category filters.
+ *
+ * This function registers a debug subscriber: a callback that will recieve every debug message matching @b both
+ * @c severities and @c categories. Any amount of subscribers can be registered alongside the global debug callback
+ * (see @ref oriSetDebugCallback()), which allows, for instance, a console logger, a file sink, and a metrics counter
+ * to each recieve only the messages they are interested in.
+ *
+ * Unlike the global debug callback, subscribers are not affected by @ref oriConfigureDebugMessages(), and errors are
+ * @b not forced through to them - if a subscriber does not request errors, it will not recieve them.
+ *
+ * A message is only formatted if the global debug callback or at least one subscriber will recieve it.
+ *
+ * Subscribers are removed on @ref oriTerminate().
+ *
+ * @param callback the callback function to register, definition specified as @ref oriDebugCallbackfun.
+ * @param severities a bit field of @ref oriSeverityBit_t enumerators to be recieved.
+ * @param categories a bit field of @ref oriDebugCategoryBit_t enumerators to be recieved.
+ * @param pointer NULL or specified user data that will be sent to the callback.
+ * @param idOut NULL or a pointer to the variable into which the ID of the subscriber will be returned, to be later
+ * passed to @ref oriRemoveDebugSubscriber().
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c callback is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if memory for the subscriber list failed to allocate
+ *
+ * @ingroup grp_core_errors
+ *
+ * @sa @ref oriDebugCallbackfun
+ * @sa @ref oriRemoveDebugSubscriber()
+ *
+ */
+const oriReturnStatus_t oriAddDebugSubscriber(
+    const oriDebugCallbackfun callback,
+    const oriSeverityBit_t severities,
+    const oriDebugCategoryBit_t categories,
+    void *pointer,
+    unsigned int *idOut
+);
+
+/**
+ * @brief Remove a debug subscriber that was registered with @ref oriAddDebugSubscriber().
+ *
+ * This function removes the debug subscriber with the given ID. Once it returns, the subscriber will not be sent any
+ * further messages by the library (a message that was already being dispatched on another thread may still reach it).
+ *
+ * @param id the ID of the subscriber, as returned by @ref oriAddDebugSubscriber().
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [SKIPPED](@ref oriReturnStatus_t) if there was no subscriber with the given ID
+ * @return [ERROR](@ref oriReturnStatus_t) if memory for the subscriber list failed to allocate
+ *
+ * @ingroup grp_core_errors
+ *
+ * @sa @ref oriAddDebugSubscriber()
+ *
+ */
+const oriReturnStatus_t oriRemoveDebugSubscriber(
+    const unsigned int id
+);
+
+/**
+ * @brief Create a Vulkan debug messenger, managed by Orion, that forwards Vulkan messages to the Orion debug output.
+ *
+ * This function creates a [VkDebugUtilsMessengerEXT](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkDebugUtilsMessengerEXT.html)
+ * for the specified instance, which requires the @c VK_EXT_debug_utils extension to be enabled for it.
+ *
+ * Messages are filtered by Vulkan itself according to @c severities and @c types, so filtered-out messages cost nothing.
+ * Messages that get through are forwarded to the global debug callback (with the name @c "VULKAN_DEBUG_MESSENGER" and the code
+ * @c 0xA1) and to any interested [debug subscribers](@ref sct_debugging_subscribers), in the @c ORION_DEBUG_CATEGORY_VULKAN_BIT
+ * category, or @c ORION_DEBUG_CATEGORY_PERFORMANCE_BIT for performance messages. The message string from Vulkan is passed
+ * through as-is, and is only forwarded if something will recieve it.
+ *
+ * The message ID of every performance message is also counted in a histogram that can be retrieved with
+ * @ref oriEnumeratePerformanceWarnings() or reported with @ref oriDumpPerformanceWarnings().
+ *
+ * The messenger is destroyed along with the instance in @ref oriTerminate(). Only one messenger can be created for each instance.
+ *
+ * @param instance the handle of the instance to create the messenger for (see @ref oriInit()).
+ * @param severities a bitmask of [VkDebugUtilsMessageSeverityFlagBitsEXT](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkDebugUtilsMessageSeverityFlagBitsEXT.html)
+ * of the messages to be reported.
+ * @param types a bitmask of [VkDebugUtilsMessageTypeFlagBitsEXT](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkDebugUtilsMessageTypeFlagBitsEXT.html)
+ * of the messages to be reported.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c instance is @c ORION_NULL_HANDLE
+ * @return [SKIPPED](@ref oriReturnStatus_t) if a messenger was already created for @c instance
+ * @return [ERROR](@ref oriReturnStatus_t) if @c instance is invalid or stale, if @c VK_EXT_debug_utils is not enabled for it, or if
+ * the messenger failed to be created
+ *
+ * @ingroup grp_core_errors
+ *
+ * @sa [Vulkan Docs/VK_EXT_debug_utils](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VK_EXT_debug_utils.html)
+ * @sa @ref oriEnumeratePerformanceWarnings()
+ * @sa @ref oriDumpPerformanceWarnings()
+ *
+ */
+const oriReturnStatus_t oriCreateDebugMessenger(
+    const oriHandle_t instance,
+    const VkDebugUtilsMessageSeverityFlagsEXT severities,
+    const VkDebugUtilsMessageTypeFlagsEXT types
+);
+
+/**
+ * @brief Retrieve the most frequently reported Vulkan performance warnings for an instance.
+ *
+ * This function retrieves the entries of the performance warning histogram kept by the Orion-managed debug messenger
+ * of the specified instance (see @ref oriCreateDebugMessenger()), sorted by descending count.
+ *
+ * If @c warningsOut is NULL, then the amount of distinct performance warnings reported so far is returned into @c countOut.
+ * Otherwise, at most @c maxCount entries are written to @c warningsOut, and the amount written is returned into @c countOut.
+ *
+ * @param instance the handle of the instance to query (see @ref oriInit()).
+ * @param maxCount the size of the @c warningsOut array.
+ * @param countOut NULL or a pointer to the variable into which the amount of entries will be returned
+ * @param warningsOut NULL or an array of at least @c maxCount elements into which the entries will be returned
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c instance is @c ORION_NULL_HANDLE
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if both @c countOut @b and @c warningsOut are NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c instance is invalid or stale or has no Orion-managed debug messenger
+ *
+ * @ingroup grp_core_errors
+ *
+ * @sa @ref oriCreateDebugMessenger()
+ * @sa @ref oriDumpPerformanceWarnings()
+ *
+ */
+const oriReturnStatus_t oriEnumeratePerformanceWarnings(
+    const oriHandle_t instance,
+    const unsigned int maxCount,
+    unsigned int *countOut,
+    oriPerformanceWarning_t *warningsOut
+);
+
+/**
+ * @brief Report the most frequently reported Vulkan performance warnings for an instance through the Orion debug output.
+ *
+ * This function sends a report of the (at most) @c maxCount most frequent performance warnings reported to the Orion-managed
+ * debug messenger of the specified instance. The report is sent as a single _NOTIF_ message in the
+ * @c ORION_DEBUG_CATEGORY_PERFORMANCE_BIT category.
+ *
+ * @param instance the handle of the instance to query (see @ref oriInit()).
+ * @param maxCount the maximum amount of entries to report.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c instance is @c ORION_NULL_HANDLE
+ * @return [ERROR](@ref oriReturnStatus_t) if @c instance is invalid or stale or has no Orion-managed debug messenger
+ *
+ * @ingroup grp_core_errors
+ *
+ * @sa @ref oriCreateDebugMessenger()
+ * @sa @ref oriEnumeratePerformanceWarnings()
+ *
+ */
+const oriReturnStatus_t oriDumpPerformanceWarnings(
+    const oriHandle_t instance,
+    const unsigned int maxCount
+);
+
+/**
+ * @brief Enable or disable the Orion object lifetime tracker.
+ *
+ * The object tracker records the creation and destruction of Vulkan objects managed by Orion (such as the instances created by
+ * @ref oriInit()), along with the handle, type, size and [caller tag](@ref oriSetObjectTrackerTag()) of each object. It is
+ * disabled by default.
+ *
+ * Events are appended to a buffer owned by the calling thread without taking any locks, so the tracker is cheap enough to be
+ * left on in production builds. The buffers are only read when statistics or a report are requested, and when the library is
+ * terminated, at which point any objects still alive are reported as leaks.
+ *
+ * Objects created while tracking is disabled are not tracked.
+ *
+ * @param enabled whether or not objects should be tracked.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ *
+ * @ingroup grp_core_errors
+ *
+ * @sa @ref oriReportLiveObjects()
+ * @sa @ref oriGetObjectTrackerStats()
+ *
+ */
+const oriReturnStatus_t oriSetObjectTrackingEnabled(
+    const bool enabled
+);
+
+/**
+ * @brief Set the tag attached to objects created by the calling thread.
+ *
+ * This function sets the caller tag that the object tracker will attach to any objects subsequently created by the calling thread,
+ * making it possible to tell which part of an application leaked an object. Only the pointer is stored, so @c tag must remain valid
+ * until the library is terminated (a string literal is ideal).
+ *
+ * @param tag NULL or a null-terminated string to identify the caller.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ *
+ * @ingroup grp_core_errors
+ *
+ * @sa @ref oriSetObjectTrackingEnabled()
+ *
+ */
+const oriReturnStatus_t oriSetObjectTrackerTag(
+    const char *tag
+);
+
+/**
+ * @brief Retrieve the totals kept by the object tracker.
+ *
+ * This function reads any events recorded by all threads since the last query and returns the resulting totals into @c statsOut.
+ *
+ * @param statsOut the @ref oriObjectTrackerStats_t structure into which the totals will be returned.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if @c statsOut is NULL
+ *
+ * @ingroup grp_core_errors
+ *
+ * @sa @ref oriSetObjectTrackingEnabled()
+ * @sa @ref oriReportLiveObjects()
+ *
+ */
+const oriReturnStatus_t oriGetObjectTrackerStats(
+    oriObjectTrackerStats_t *statsOut
+);
+
+/**
+ * @brief Report the objects currently alive through the Orion debug output.
+ *
+ * This function sends a report of the objects that the tracker has seen created but not destroyed, as a single _NOTIF_ message.
+ * The report lists the amount of live objects of each type along with the growth since the previous report, followed by (at most)
+ * @c maxCount of the live objects themselves.
+ *
+ * The same report is sent automatically by @ref oriTerminate() (as a _WARNING_) if any tracked objects have not been destroyed.
+ *
+ * @param maxCount the maximum amount of individual objects to list.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ *
+ * @ingroup grp_core_errors
+ *
+ * @sa @ref oriSetObjectTrackingEnabled()
+ * @sa @ref oriGetObjectTrackerStats()
+ *
+ */
+const oriReturnStatus_t oriReportLiveObjects(
+    const unsigned int maxCount
+);
+
 /**
  * @brief Convert an oriReturnStatus_t enum into a more descriptive string.
  *
@@ -449,7 +1499,7 @@ const bool oriCheckLayerAvailability(
  * This function checks if the given layer is enabled for the specified
  * [VkInstance](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkInstance.html) object.
  *
- * @param instance the [VkInstance](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkInstance.html) object to query.
+ * @param instance the handle of the instance to query (see @ref oriInit()).
  * @param layer the name of the layer to search for
  * @return true if the layer was found
  * @return false if the layer was @b not found, <b>or if there was an error.</b>
@@ -462,7 +1512,7 @@ const bool oriCheckLayerAvailability(
  *
  */
 const bool oriCheckLayerEnabled(
-    const VkInstance *instance,
+    const oriHandle_t instance,
     const char *layer
 );
 
@@ -471,13 +1521,13 @@ const bool oriCheckLayerEnabled(
  *
  * This function retrieves the array of enabled layers for the specified instance.
  *
- * @param instance the [VkInstance](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkInstance.html) object to query.
+ * @param instance the handle of the instance to query (see @ref oriInit()).
  * @param layerCountOut NULL or a pointer to the variable into which the amount of layers will be returned
  * @param layerNamesOut NULL or a pointer to the array of strings into which the list of layer names will be returned
  * @return [OK](@ref oriReturnStatus_t) if executed successfully
- * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c instance is NULL
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c instance is @c ORION_NULL_HANDLE
  * @return [NO_OUTPUT](@ref oriReturnStatus_t) if both @c layerCountOut @b and @c layerNamesOut are NULL
- * @return [ERROR](@ref oriReturnStatus_t) if @c instance was invalid or if it was not created with Orion
+ * @return [ERROR](@ref oriReturnStatus_t) if @c instance is invalid or stale
  *
  * @ingroup grp_core_vkapi_ext
  *
@@ -487,7 +1537,7 @@ const bool oriCheckLayerEnabled(
  *
  */
 const oriReturnStatus_t oriEnumerateEnabledLayers(
-    const VkInstance *instance,
+    const oriHandle_t instance,
     unsigned int *layerCountOut,
     char ***layerNamesOut
 );
@@ -525,7 +1575,7 @@ const bool oriCheckInstanceExtensionAvailability(
  * This function checks if the given instance extension is enabled for the specified
  * [VkInstance](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkInstance.html) object.
  *
- * @param instance the [VkInstance](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkInstance.html) object to query.
+ * @param instance the handle of the instance to query (see @ref oriInit()).
  * @param extension the name of the instance extension to search for
  * @return true if the instance extension was found
  * @return false if the instance extension was @b not found, <b>or if there was an error.</b>
@@ -538,7 +1588,7 @@ const bool oriCheckInstanceExtensionAvailability(
  *
  */
 const bool oriCheckInstanceExtensionEnabled(
-    const VkInstance *instance,
+    const oriHandle_t instance,
     const char *extension
 );
 
@@ -547,13 +1597,13 @@ const bool oriCheckInstanceExtensionEnabled(
  *
  * This function retrieves the array of enabled instance extensions for the specified instance.
  *
- * @param instance the [VkInstance](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkInstance.html) object to query.
+ * @param instance the handle of the instance to query (see @ref oriInit()).
  * @param extCountOut NULL or a pointer to the variable into which the amount of instance extensions will be returned
  * @param extNamesOut NULL or a pointer to the array of strings into which the list of instance extension names will be returned
  * @return [OK](@ref oriReturnStatus_t) if executed successfully
- * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c instance is NULL
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c instance is @c ORION_NULL_HANDLE
  * @return [NO_OUTPUT](@ref oriReturnStatus_t) if both @c extCountOut @b and @c extNamesOut are NULL
- * @return [ERROR](@ref oriReturnStatus_t) if @c instance was invalid or if it was not created with Orion
+ * @return [ERROR](@ref oriReturnStatus_t) if @c instance is invalid or stale
  *
  * @ingroup grp_core_vkapi_ext
  *
@@ -563,7 +1613,7 @@ const bool oriCheckInstanceExtensionEnabled(
  *
  */
 const oriReturnStatus_t oriEnumerateEnabledInstanceExtensions(
-    const VkInstance *instance,
+    const oriHandle_t instance,
     unsigned int *extCountOut,
     char ***extNamesOut
 );
@@ -615,8 +1665,17 @@ const bool oriCheckDeviceExtensionAvailability(
  * and, occasionally,
  * [Vulkan Docs/VkDeviceGroupDeviceCreateInfo](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkDeviceGroupDeviceCreateInfo.html)
  * for more info.
+ *
+ * If the physical device supports VK_EXT_memory_budget, and both the instance and the physical device have Vulkan 1.1 (which
+ * the extension's queries need), it is enabled automatically (whether or not it is in @c extensionNames) so that the device's
+ * memory manager can track the budget of each memory heap (see @ref oriGetMemoryBudget()).
+ *
+ * @warning The resulting device must be destroyed with @ref oriDestroyLogicalDevice() (or left to @ref oriTerminate()), <b>not
+ * vkDestroyDevice()</b>.
+ *
  * @param deviceOut pointer to the [VkDevice](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkDevice.html)
  * into which the resulting device will be returned.
+ * @param handleOut NULL or a pointer to the variable into which the handle of the device will be returned.
  * @param deviceFlags a bitmask of [VkDeviceCreateFlags](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkDeviceCreateFlags.html)
  * indicating the behaviour of the logical device.
  * @param physicalDevice the physical device to interface with.
@@ -633,7 +1692,6 @@ const bool oriCheckDeviceExtensionAvailability(
  * @return [OK](@ref oriReturnStatus_t) if executed successfully
  * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c physicalDevice is NULL or if @c queueCreateInfos is NULL but @c queueCreateInfoCount is more than 0, or
  * the extension equivalents
- * @return [SKIPPED](@ref oriReturnStatus_t) if a device has already been allocated by Orion at @c deviceOut.
  * @return [ERROR](@ref oriReturnStatus_t) if the device failed to be created by Vulkan.
  *
  * @ingroup grp_core_vkapi_core_devices
@@ -643,10 +1701,12 @@ const bool oriCheckDeviceExtensionAvailability(
  * @sa [Vulkan Docs/VkDeviceGroupDeviceCreateInfo](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkDeviceGroupDeviceCreateInfo.html)
  * @sa [Vulkan Docs/VkDeviceQueueCreateInfo](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkDeviceQueueCreateInfo.html)
  * @sa [Vulkan Docs/VkPhysicalDeviceFeatures](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkPhysicalDeviceFeatures.html)
+ * @sa @ref oriDestroyLogicalDevice()
  *
  */
 const oriReturnStatus_t oriCreateLogicalDevice(
     VkDevice *deviceOut,
+    oriHandle_t *handleOut,
     const VkDeviceCreateFlags deviceFlags,
     const VkPhysicalDevice physicalDevice,
     const unsigned int queueCreateInfoCount,
@@ -657,6 +1717,131 @@ const oriReturnStatus_t oriCreateLogicalDevice(
     const void *deviceNext
 );
 
+/**
+ * @brief Destroy a logical device created with @ref oriCreateLogicalDevice().
+ *
+ * This function destroys the logical device referred to by @c device, and invalidates the handle (and any copies of it).
+ *
+ * @param device the handle of the logical device to destroy.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c device is @c ORION_NULL_HANDLE
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid or stale
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriCreateLogicalDevice()
+ *
+ */
+const oriReturnStatus_t oriDestroyLogicalDevice(
+    const oriHandle_t device
+);
+
+/**
+ * @brief Retrieve the [VkDevice](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkDevice.html) that a device handle refers to.
+ *
+ * @param device the handle of the logical device.
+ * @return the Vulkan handle of the logical device, or @c VK_NULL_HANDLE if @c device is invalid or stale.
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ */
+const VkDevice oriGetVkDevice(
+    const oriHandle_t device
+);
+
+/**
+ * @brief Build a chain of feature structures that enables a set of performance-related features, as far as they are supported.
+ *
+ * This function queries the features supported by @c physicalDevice with
+ * [vkGetPhysicalDeviceFeatures2()](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/vkGetPhysicalDeviceFeatures2.html),
+ * and enables each of the @c requestedFeatures that is supported (see @ref oriDeviceFeatureBit_t). Requested features that are not
+ * supported are left out of the set rather than causing device creation to fail, so check the @c enabled member of the set (or call
+ * @ref oriGetEnabledDeviceFeatures() after creating the device) before taking the code paths that depend on them.
+ *
+ * The core features in @c baseFeatures are also enabled, as far as they are supported.
+ *
+ * @note The instance and the device must support Vulkan 1.1 or later. Features of Vulkan 1.2 and 1.3 are only enabled if both the
+ * instance (see the @c apiVersion parameter of @ref oriInit()) and the device support that version.
+ *
+ * @param physicalDevice the physical device that the logical device will be created for.
+ * @param requestedFeatures a bitmask of @ref oriDeviceFeatureBit_t flags.
+ * @param baseFeatures NULL, or the core Vulkan features to enable.
+ * @param setOut a pointer to the structure into which the feature set will be built.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c physicalDevice is NULL
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if @c setOut is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if the instance or the device doesn't support Vulkan 1.1
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriDeviceFeatureSet_t
+ * @sa @ref oriCreateLogicalDevice()
+ *
+ */
+const oriReturnStatus_t oriBuildDeviceFeatureSet(
+    const VkPhysicalDevice physicalDevice,
+    const uint32_t requestedFeatures,
+    const VkPhysicalDeviceFeatures *baseFeatures,
+    oriDeviceFeatureSet_t *setOut
+);
+
+/**
+ * @brief Retrieve the performance-related features that a logical device was created with.
+ *
+ * The features are recorded by @ref oriCreateLogicalDevice() from the
+ * [VkPhysicalDeviceVulkan12Features](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkPhysicalDeviceVulkan12Features.html) and
+ * [VkPhysicalDeviceVulkan13Features](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkPhysicalDeviceVulkan13Features.html)
+ * structures in its @c deviceNext chain, so this works whether or not the chain was built with @ref oriBuildDeviceFeatureSet().
+ *
+ * @param device the handle of the logical device.
+ * @return a bitmask of @ref oriDeviceFeatureBit_t flags, or 0 if @c device is invalid or stale.
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriIsDeviceFeatureEnabled()
+ *
+ */
+const uint32_t oriGetEnabledDeviceFeatures(
+    const oriHandle_t device
+);
+
+/**
+ * @brief Check if all of a set of performance-related features were enabled on a logical device.
+ *
+ * @param device the handle of the logical device.
+ * @param features a bitmask of @ref oriDeviceFeatureBit_t flags.
+ * @return true if every feature in @c features is enabled, false otherwise (or if @c device is invalid or stale).
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriGetEnabledDeviceFeatures()
+ *
+ */
+const bool oriIsDeviceFeatureEnabled(
+    const oriHandle_t device,
+    const uint32_t features
+);
+
+/**
+ * @brief Retrieve the limits snapshot taken when a logical device was created.
+ *
+ * @param device the handle of the logical device.
+ * @param limitsOut a pointer to the structure into which the limits will be returned.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c device is @c ORION_NULL_HANDLE
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if @c limitsOut is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid or stale
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriDeviceLimits_t
+ *
+ */
+const oriReturnStatus_t oriGetDeviceLimits(
+    const oriHandle_t device,
+    oriDeviceLimits_t *limitsOut
+);
+
 /**
  * @brief Retrieve an array of physical devices accessible to a Vulkan instance that are considered suitable for the application.
  *
@@ -670,12 +1855,12 @@ const oriReturnStatus_t oriCreateLogicalDevice(
  *
  * @warning The @c devicesOut array will be @b allocated by this function and <b>it is up to you to free it.</b>
  *
- * @param instance the [VkInstance](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkInstance.html) object to query.
+ * @param instance the handle of the instance to query (see @ref oriInit()).
  * @param checkFun NULL, or a @ref oriPhysicalDeviceSuitabilityCheckfun function to determine device suitability on your terms.
  * @param countOut NULL or a pointer to the variable into which the amount of devices will be returned
  * @param devicesOut NULL or a pointer to the array into which the Vulkan physical device objects will be returned
  * @return [OK](@ref oriReturnStatus_t) if executed successfully
- * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c instance is NULL
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c instance is @c ORION_NULL_HANDLE
  * @return [NO_OUTPUT](@ref oriReturnStatus_t) if both @c countOut @b and @c devicesOut are NULL
  * @return [ERROR](@ref oriReturnStatus_t) if there was an unspecified error, or if memory for the device failed to allocate
  *
@@ -686,43 +1871,1319 @@ const oriReturnStatus_t oriCreateLogicalDevice(
  *
  */
 const oriReturnStatus_t oriEnumerateSuitablePhysicalDevices(
-    const VkInstance *instance,
+    const oriHandle_t instance,
     const oriPhysicalDeviceSuitabilityCheckfun checkFun,
     unsigned int *countOut,
     VkPhysicalDevice **devicesOut
 );
 
 /**
- * @brief Retrieve an array of properties of queue families accessible to a physical device.
+ * @brief Retrieve the physical devices accessible to a Vulkan instance that are considered suitable for the application, into
+ * caller-provided storage.
  *
- * This function retrieves an array of properties of queue families accessible to the specified
- * [VkPhysicalDevice](https://khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkPhysicalDevice.html) structure.
+ * This function is equivalent to @ref oriEnumerateSuitablePhysicalDevices(), but follows the two-call idiom of Vulkan's own
+ * enumeration functions instead of allocating the output array, so it makes no heap allocations at all.
  *
- * @note If there are no available queue families, then @c familiesOut will be set to @b NULL.
- * @c countOut will, of course, be set to 0.
+ * If @c devices is NULL, the amount of suitable devices is returned into @c count. Otherwise, @c count must point to the size of
+ * the @c devices array; up to that many devices are written to it, and @c count is overwritten with the amount actually written.
  *
- * @warning The @c familiesOut array will be @b allocated by this function and <b>it is up to you to free it.</b>
+ * @note @c checkFun is called for each available device on every call, so it will be called twice per device if this function is
+ * used to query the count first.
  *
- * @param physicalDevice the [VkPhysicalDevice](https://khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkPhysicalDevice.html) structure
- * to query.
- * @param countOut NULL or a pointer to the variable into which the amount of queue families will be returned
- * @param familiesOut NULL or a pointer to the array into which the Vulkan queue family properties objects will be returned
+ * @param instance the handle of the instance to query (see @ref oriInit()).
+ * @param checkFun NULL, or a @ref oriPhysicalDeviceSuitabilityCheckfun function to determine device suitability on your terms.
+ * @param count a pointer to the amount of devices, as described above.
+ * @param devices NULL or an array of at least @c *count elements into which the Vulkan physical device objects will be written
  * @return [OK](@ref oriReturnStatus_t) if executed successfully
- * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c physicalDevice is NULL
- * @return [NO_OUTPUT](@ref oriReturnStatus_t) if both @c countOut @b and @c familiesOut are NULL
- * @return [ERROR](@ref oriReturnStatus_t) if there was an unspecified or memory error
+ * @return [SKIPPED](@ref oriReturnStatus_t) if @c devices was too small to hold every suitable device (like @c VK_INCOMPLETE)
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c instance is @c ORION_NULL_HANDLE or @c count is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c instance is invalid or stale, or if Vulkan failed to enumerate the devices
  *
  * @ingroup grp_core_vkapi_core_devices
  *
- * @sa [Vulkan Docs/VkPhysicalDevice](https://khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkPhysicalDevice.html)
+ * @sa @ref oriEnumerateSuitablePhysicalDevices()
  *
  */
-const oriReturnStatus_t oriEnumerateAvailableQueueFamilies(
-    const VkPhysicalDevice *physicalDevice,
+const oriReturnStatus_t oriEnumerateSuitablePhysicalDevicesInto(
+    const oriHandle_t instance,
+    const oriPhysicalDeviceSuitabilityCheckfun checkFun,
+    unsigned int *count,
+    VkPhysicalDevice *devices
+);
+
+/**
+ * @brief Retrieve the default weights of the physical device scoring model.
+ *
+ * The default weights favour discrete GPUs with more device-local memory, which is normally what you want on hosts with
+ * both an integrated and a discrete GPU.
+ *
+ * @return the default @ref oriPhysicalDeviceScoreWeights_t.
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriRankPhysicalDevices()
+ *
+ */
+const oriPhysicalDeviceScoreWeights_t oriGetDefaultPhysicalDeviceScoreWeights();
+
+/**
+ * @brief Score the physical devices accessible to an instance and retrieve them sorted from best to worst.
+ *
+ * This function scores each physical device accessible to the instance with the weighted model described by
+ * @ref oriPhysicalDeviceScoreWeights_t, and returns them sorted by descending score. Devices that do not support every one of
+ * the required extensions, or that are rejected by the check function, are excluded.
+ *
+ * The order is deterministic: ties are broken by device type, device-local memory, vendor and device IDs and finally the order
+ * in which Vulkan enumerated the devices. This means that the first device in @c devicesOut can be used directly as the device
+ * to create a logical device with.
+ *
+ * The properties queried to score each device are returned alongside it in the @ref oriRankedPhysicalDevice_t structures, so
+ * there is no need to query them again.
+ *
+ * @note If there are no suitable devices, then @c devicesOut will be set to @b NULL and @c countOut to 0.
+ *
+ * @warning The @c devicesOut array will be @b allocated by this function and <b>it is up to you to free it.</b>
+ *
+ * @param instance the handle of the instance to query (see @ref oriInit()).
+ * @param rankInfo NULL (to use the default weights with no other requirements), or a pointer to a @ref oriPhysicalDeviceRankInfo_t
+ * structure.
+ * @param countOut NULL or a pointer to the variable into which the amount of ranked devices will be returned
+ * @param devicesOut NULL or a pointer to the array into which the ranked devices will be returned
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c instance is @c ORION_NULL_HANDLE, or if an extension array in @c rankInfo is NULL
+ * but its count is more than 0
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if both @c countOut @b and @c devicesOut are NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c instance is invalid or stale, or if there was a Vulkan or memory error
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriPhysicalDeviceRankInfo_t
+ * @sa @ref oriRankedPhysicalDevice_t
+ * @sa @ref oriEnumerateSuitablePhysicalDevices()
+ *
+ */
+const oriReturnStatus_t oriRankPhysicalDevices(
+    const oriHandle_t instance,
+    const oriPhysicalDeviceRankInfo_t *rankInfo,
+    unsigned int *countOut,
+    oriRankedPhysicalDevice_t **devicesOut
+);
+
+/**
+ * @brief Retrieve an array of properties of queue families accessible to a physical device.
+ *
+ * This function retrieves an array of properties of queue families accessible to the specified
+ * [VkPhysicalDevice](https://khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkPhysicalDevice.html) structure.
+ *
+ * @note If there are no available queue families, then @c familiesOut will be set to @b NULL.
+ * @c countOut will, of course, be set to 0.
+ *
+ * @warning The @c familiesOut array will be @b allocated by this function and <b>it is up to you to free it.</b>
+ *
+ * @param physicalDevice the [VkPhysicalDevice](https://khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkPhysicalDevice.html) structure
+ * to query.
+ * @param countOut NULL or a pointer to the variable into which the amount of queue families will be returned
+ * @param familiesOut NULL or a pointer to the array into which the Vulkan queue family properties objects will be returned
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c physicalDevice is NULL
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if both @c countOut @b and @c familiesOut are NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if there was an unspecified or memory error
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa [Vulkan Docs/VkPhysicalDevice](https://khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkPhysicalDevice.html)
+ *
+ */
+const oriReturnStatus_t oriEnumerateAvailableQueueFamilies(
+    const VkPhysicalDevice *physicalDevice,
     unsigned int *countOut,
     VkQueueFamilyProperties **familiesOut
 );
 
+/**
+ * @brief Retrieve the properties of queue families accessible to a physical device, into caller-provided storage.
+ *
+ * This function is equivalent to @ref oriEnumerateAvailableQueueFamilies(), but follows the two-call idiom of Vulkan's own
+ * enumeration functions instead of allocating the output array, so it makes no heap allocations at all.
+ *
+ * If @c families is NULL, the amount of queue families is returned into @c count. Otherwise, @c count must point to the size of
+ * the @c families array; up to that many families are written to it, and @c count is overwritten with the amount actually written.
+ *
+ * @param physicalDevice the physical device to query.
+ * @param count a pointer to the amount of queue families, as described above.
+ * @param families NULL or an array of at least @c *count elements into which the queue family properties will be written
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [SKIPPED](@ref oriReturnStatus_t) if @c families was too small to hold every queue family (like @c VK_INCOMPLETE)
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c physicalDevice or @c count is NULL
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriEnumerateAvailableQueueFamilies()
+ *
+ */
+const oriReturnStatus_t oriEnumerateAvailableQueueFamiliesInto(
+    const VkPhysicalDevice physicalDevice,
+    unsigned int *count,
+    VkQueueFamilyProperties *families
+);
+
+/**
+ * @brief Choose the queue families and queues that a logical device should be created with to fulfil a set of queue roles.
+ *
+ * This function assigns a queue to each requested role (see @ref oriQueueRole_t) so as to let as much work as possible run
+ * in parallel on the hardware: async compute and transfer roles are placed on families dedicated to them where possible (which
+ * usually map to separate hardware engines), and every role is given its own queue while the family has queues to spare.
+ *
+ * Roles are solved in order of priority. The present role is always solved last: it is given the graphics queue if the graphics
+ * family can present to @c surface, as presenting from the graphics queue needs no queue family ownership transfers.
+ *
+ * If a role is requested more than once, only its first request is used.
+ *
+ * @param physicalDevice the physical device that the logical device will be created for.
+ * @param surface the surface that will be presented to. This is only used for the present role, and may be @c VK_NULL_HANDLE
+ * otherwise.
+ * @param requestCount the amount of elements in @c requests.
+ * @param requests an array of requested queue roles.
+ * @param solutionOut a pointer to the structure into which the solution will be returned.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c physicalDevice is NULL, if @c requests is NULL but @c requestCount is more than
+ * 0, or if the present role was requested but @c surface is @c VK_NULL_HANDLE
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if @c solutionOut is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if no queue family could fulfil a required role, or if there was a Vulkan or memory error
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriQueueSolution_t
+ * @sa @ref oriCreateLogicalDevice()
+ *
+ */
+const oriReturnStatus_t oriSolveQueueFamilies(
+    const VkPhysicalDevice physicalDevice,
+    const VkSurfaceKHR surface,
+    const unsigned int requestCount,
+    const oriQueueRoleRequest_t *requests,
+    oriQueueSolution_t *solutionOut
+);
+
+
+// ----[Orion library public interface]---------------------------------------- //
+//                              Vulkan format support                           //
+
+/**
+ * @brief Fill the format property table of a physical device, optionally in a background thread.
+ *
+ * Orion keeps a table of the properties of every core format for each physical device that it is asked about, so that format
+ * queries made during resource creation (@ref oriGetFormatProperties(), @ref oriFindSupportedFormat() and @ref oriFindBestFormat())
+ * never call into the driver. The table is filled the first time that any of those functions is used with the physical device, or
+ * by this function.
+ *
+ * If @c background is true, the table is filled by a new thread so that the queries (one per core format) overlap with the rest
+ * of the application's start-up. A format query made while the thread is still running waits for it to finish.
+ *
+ * @param physicalDevice the physical device whose format properties to query.
+ * @param background true to fill the table in a background thread, false to fill it before this function returns.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [SKIPPED](@ref oriReturnStatus_t) if the table has already been (or is being) filled
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c physicalDevice is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if there was a memory error
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ */
+const oriReturnStatus_t oriPrefetchFormatProperties(
+    const VkPhysicalDevice physicalDevice,
+    const bool background
+);
+
+/**
+ * @brief Retrieve the properties of a format on a physical device from its format property table.
+ *
+ * This is the equivalent of
+ * [vkGetPhysicalDeviceFormatProperties()](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/vkGetPhysicalDeviceFormatProperties.html),
+ * but the result comes from the table described in @ref oriPrefetchFormatProperties(). Formats added by extensions are not in the
+ * table, and are queried from the driver directly.
+ *
+ * @param physicalDevice the physical device to query.
+ * @param format the format to query.
+ * @param propertiesOut a pointer to the structure into which the properties will be returned.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c physicalDevice is NULL
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if @c propertiesOut is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if there was a memory error
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriPrefetchFormatProperties()
+ *
+ */
+const oriReturnStatus_t oriGetFormatProperties(
+    const VkPhysicalDevice physicalDevice,
+    const VkFormat format,
+    VkFormatProperties *propertiesOut
+);
+
+/**
+ * @brief Find the first format in a list of candidates that supports a set of features on a physical device.
+ *
+ * @param physicalDevice the physical device to query.
+ * @param tiling the tiling that the format will be used with (@c VK_IMAGE_TILING_LINEAR or @c VK_IMAGE_TILING_OPTIMAL).
+ * @param features the format features that are required.
+ * @param candidateCount the amount of elements in @c candidates.
+ * @param candidates an array of formats, from most to least preferred.
+ * @param formatOut a pointer to the variable into which the chosen format (or @c VK_FORMAT_UNDEFINED) will be returned.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [SKIPPED](@ref oriReturnStatus_t) if none of the candidates support @c features
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c physicalDevice is NULL, or if @c candidates is NULL but @c candidateCount is more than 0
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if @c formatOut is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if there was a memory error
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriFindBestFormat()
+ *
+ */
+const oriReturnStatus_t oriFindSupportedFormat(
+    const VkPhysicalDevice physicalDevice,
+    const VkImageTiling tiling,
+    const VkFormatFeatureFlags features,
+    const unsigned int candidateCount,
+    const VkFormat *candidates,
+    VkFormat *formatOut
+);
+
+/**
+ * @brief Find the fastest format supported by a physical device for a common use.
+ *
+ * See @ref oriFormatUsage_t for the candidates considered for each use.
+ *
+ * @param physicalDevice the physical device to query.
+ * @param usage the use of the format.
+ * @param formatOut a pointer to the variable into which the chosen format (or @c VK_FORMAT_UNDEFINED) will be returned.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [SKIPPED](@ref oriReturnStatus_t) if none of the candidates are supported
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c physicalDevice is NULL
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if @c formatOut is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c usage is invalid, or if there was a memory error
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ * @sa @ref oriFindSupportedFormat()
+ *
+ */
+const oriReturnStatus_t oriFindBestFormat(
+    const VkPhysicalDevice physicalDevice,
+    const oriFormatUsage_t usage,
+    VkFormat *formatOut
+);
+
+
+// ----[Orion library public interface]---------------------------------------- //
+//                           Vulkan memory management                           //
+
+/**
+ * @brief Allocate device memory for a resource from the memory manager of a logical device.
+ *
+ * Instead of calling [vkAllocateMemory()](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/vkAllocateMemory.html)
+ * for every resource, which is slow and limited to @c maxMemoryAllocationCount allocations, each logical device created with
+ * @ref oriCreateLogicalDevice() allocates large blocks of memory and sub-allocates resources from them. Allocating and freeing
+ * take constant time.
+ *
+ * The memory type is chosen from those allowed by @c requirements that have all of @c requiredFlags, preferring those with the
+ * most of @c preferredFlags. If a block can't be allocated from the best memory type (e.g. because its heap is full), the next
+ * best is used.
+ *
+ * If @c linear is false, the allocation is padded so that it doesn't share a page of @c bufferImageGranularity with any other
+ * allocation.
+ *
+ * Allocations of at least 64 MiB are given their own (dedicated) device memory instead of being sub-allocated from a shared
+ * block. @ref oriAllocateBufferMemory(), @ref oriAllocateImageMemory() and @ref oriCreateBuffer() also give dedicated memory to
+ * resources that the driver prefers or requires to have it (see
+ * [VkMemoryDedicatedRequirements](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkMemoryDedicatedRequirements.html)),
+ * which lets it apply optimisations such as compression to them; the memory is then allocated with a
+ * [VkMemoryDedicatedAllocateInfo](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkMemoryDedicatedAllocateInfo.html).
+ * The driver can only be asked about dedicated memory on Vulkan 1.1 devices (with an instance created for 1.1 or later); on
+ * Vulkan 1.0, only the size of the allocation decides whether it is dedicated.
+ * Dedicated memory is freed along with the allocation. If it can't be allocated (and isn't required), the allocation is
+ * sub-allocated instead.
+ *
+ * @note A device can have at most 65536 memory allocations at once.
+ *
+ * @param device the handle of the logical device to allocate memory from.
+ * @param requirements the memory requirements of the resource (from e.g.
+ * [vkGetBufferMemoryRequirements()](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/vkGetBufferMemoryRequirements.html)).
+ * @param requiredFlags the memory properties that the memory must have.
+ * @param preferredFlags the memory properties that the memory should have, if possible.
+ * @param linear true if the memory will be bound to a buffer or linearly tiled image, false if it will be bound to an optimally
+ * tiled image.
+ * @param allocationOut a pointer to the variable into which the handle of the allocation will be returned.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c requirements is NULL
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if @c allocationOut is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid, if no memory type is suitable, or if the memory could not be allocated
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriAllocateBufferMemory()
+ * @sa @ref oriAllocateImageMemory()
+ * @sa @ref oriFreeMemory()
+ *
+ */
+const oriReturnStatus_t oriAllocateMemory(
+    const oriHandle_t device,
+    const VkMemoryRequirements *requirements,
+    const VkMemoryPropertyFlags requiredFlags,
+    const VkMemoryPropertyFlags preferredFlags,
+    const bool linear,
+    oriHandle_t *allocationOut
+);
+
+/**
+ * @brief Allocate device memory for a buffer and bind the buffer to it.
+ *
+ * This function queries the memory requirements of @c buffer, allocates memory for it as described in @ref oriAllocateMemory(),
+ * and binds it to the memory.
+ *
+ * @param device the handle of the logical device that the buffer was created with.
+ * @param buffer the buffer to allocate memory for.
+ * @param requiredFlags the memory properties that the memory must have.
+ * @param preferredFlags the memory properties that the memory should have, if possible.
+ * @param allocationOut NULL or a pointer to the variable into which the handle of the allocation will be returned. Note that
+ * the memory can't be freed without the handle.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c buffer is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid, if no memory type is suitable, or if the memory could not be
+ * allocated or bound
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriAllocateMemory()
+ *
+ */
+const oriReturnStatus_t oriAllocateBufferMemory(
+    const oriHandle_t device,
+    const VkBuffer buffer,
+    const VkMemoryPropertyFlags requiredFlags,
+    const VkMemoryPropertyFlags preferredFlags,
+    oriHandle_t *allocationOut
+);
+
+/**
+ * @brief Allocate device memory for an image and bind the image to it.
+ *
+ * This function queries the memory requirements of @c image, allocates memory for it as described in @ref oriAllocateMemory()
+ * (as an optimally tiled image), and binds it to the memory.
+ *
+ * @param device the handle of the logical device that the image was created with.
+ * @param image the image to allocate memory for.
+ * @param requiredFlags the memory properties that the memory must have.
+ * @param preferredFlags the memory properties that the memory should have, if possible.
+ * @param allocationOut NULL or a pointer to the variable into which the handle of the allocation will be returned. Note that
+ * the memory can't be freed without the handle.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c image is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid, if no memory type is suitable, or if the memory could not be
+ * allocated or bound
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriAllocateMemory()
+ *
+ */
+const oriReturnStatus_t oriAllocateImageMemory(
+    const oriHandle_t device,
+    const VkImage image,
+    const VkMemoryPropertyFlags requiredFlags,
+    const VkMemoryPropertyFlags preferredFlags,
+    oriHandle_t *allocationOut
+);
+
+/**
+ * @brief Create a buffer that is owned by a new memory allocation.
+ *
+ * This function creates a buffer, allocates memory for it as described in @ref oriAllocateMemory(), and binds it to the memory.
+ * The buffer is destroyed when the allocation is freed with @ref oriFreeMemory().
+ *
+ * Buffers created with this function can be moved by @ref oriDefragment() if they were created with both
+ * @c VK_BUFFER_USAGE_TRANSFER_SRC_BIT and @c VK_BUFFER_USAGE_TRANSFER_DST_BIT usage and @c VK_SHARING_MODE_EXCLUSIVE, and without
+ * @c VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT usage, sparse binding or a @c pNext chain, unless they were given dedicated memory.
+ *
+ * @param device the handle of the logical device to create the buffer with.
+ * @param createInfo the parameters of the buffer.
+ * @param requiredFlags the memory properties that the memory must have.
+ * @param preferredFlags the memory properties that the memory should have, if possible.
+ * @param allocationOut a pointer to the variable into which the handle of the allocation will be returned.
+ * @param bufferOut NULL or a pointer to the variable into which the buffer will be returned. If the buffer can be moved, use
+ * @ref oriGetAllocationInfo() to get the buffer instead of storing it.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c createInfo is NULL
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if @c allocationOut is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid, if the buffer could not be created, if no memory type is
+ * suitable, or if the memory could not be allocated or bound
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriDefragment()
+ *
+ */
+const oriReturnStatus_t oriCreateBuffer(
+    const oriHandle_t device,
+    const VkBufferCreateInfo *createInfo,
+    const VkMemoryPropertyFlags requiredFlags,
+    const VkMemoryPropertyFlags preferredFlags,
+    oriHandle_t *allocationOut,
+    VkBuffer *bufferOut
+);
+
+/**
+ * @brief Find the best memory type of a logical device for a usage.
+ *
+ * The memory type is the first of those ranked for @c usage (see @ref oriMemoryUsage_t) that is allowed by @c memoryTypeBits.
+ *
+ * @param device the handle of the logical device.
+ * @param usage the intended use of the memory.
+ * @param memoryTypeBits the memory types allowed by a resource (from its VkMemoryRequirements), or ~0 for any.
+ * @param memoryTypeIndexOut a pointer to the variable into which the index of the memory type will be returned.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if @c memoryTypeIndexOut is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device or @c usage is invalid, or if no memory type is suitable
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ */
+const oriReturnStatus_t oriFindMemoryTypeForUsage(
+    const oriHandle_t device,
+    const oriMemoryUsage_t usage,
+    const uint32_t memoryTypeBits,
+    uint32_t *memoryTypeIndexOut
+);
+
+/**
+ * @brief Allocate device memory for a resource, choosing the memory type by its intended use.
+ *
+ * This function behaves like @ref oriAllocateMemory(), except that the memory types are tried in the order ranked for
+ * @c usage (see @ref oriMemoryUsage_t) instead of by property flags.
+ *
+ * @param device the handle of the logical device to allocate memory from.
+ * @param requirements the memory requirements of the resource.
+ * @param usage the intended use of the memory.
+ * @param linear true if the memory will be bound to a buffer or linearly tiled image, false if it will be bound to an optimally
+ * tiled image.
+ * @param allocationOut a pointer to the variable into which the handle of the allocation will be returned.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c requirements is NULL
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if @c allocationOut is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device or @c usage is invalid, if no memory type is suitable, or if the memory
+ * could not be allocated
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriAllocateMemory()
+ *
+ */
+const oriReturnStatus_t oriAllocateMemoryForUsage(
+    const oriHandle_t device,
+    const VkMemoryRequirements *requirements,
+    const oriMemoryUsage_t usage,
+    const bool linear,
+    oriHandle_t *allocationOut
+);
+
+/**
+ * @brief Create a buffer that is owned by a new memory allocation, choosing the memory type by its intended use.
+ *
+ * This function behaves like @ref oriCreateBuffer(), except that the memory types are tried in the order ranked for @c usage
+ * (see @ref oriMemoryUsage_t) instead of by property flags.
+ *
+ * @param device the handle of the logical device to create the buffer with.
+ * @param createInfo the parameters of the buffer.
+ * @param usage the intended use of the memory.
+ * @param allocationOut a pointer to the variable into which the handle of the allocation will be returned.
+ * @param bufferOut NULL or a pointer to the variable into which the buffer will be returned.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c createInfo is NULL
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if @c allocationOut is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device or @c usage is invalid, if the buffer could not be created, if no
+ * memory type is suitable, or if the memory could not be allocated or bound
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriCreateBuffer()
+ *
+ */
+const oriReturnStatus_t oriCreateBufferForUsage(
+    const oriHandle_t device,
+    const VkBufferCreateInfo *createInfo,
+    const oriMemoryUsage_t usage,
+    oriHandle_t *allocationOut,
+    VkBuffer *bufferOut
+);
+
+/**
+ * @brief Bind a buffer to (part of) a memory allocation.
+ *
+ * @param device the handle of the logical device that the allocation was made from.
+ * @param allocation the handle of the allocation.
+ * @param buffer the buffer to bind.
+ * @param offset the offset of the buffer in the allocation.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c buffer is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device or @c allocation is invalid, if the buffer doesn't fit in the allocation at
+ * @c offset, if @c offset is not aligned to the buffer's memory requirements, or if Vulkan failed to bind the buffer
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ */
+const oriReturnStatus_t oriBindBufferMemory(
+    const oriHandle_t device,
+    const oriHandle_t allocation,
+    const VkBuffer buffer,
+    const VkDeviceSize offset
+);
+
+/**
+ * @brief Bind an image to (part of) a memory allocation.
+ *
+ * @param device the handle of the logical device that the allocation was made from.
+ * @param allocation the handle of the allocation.
+ * @param image the image to bind.
+ * @param offset the offset of the image in the allocation.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c image is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device or @c allocation is invalid, if the image doesn't fit in the allocation at
+ * @c offset, if @c offset is not aligned to the image's memory requirements, or if Vulkan failed to bind the image
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ */
+const oriReturnStatus_t oriBindImageMemory(
+    const oriHandle_t device,
+    const oriHandle_t allocation,
+    const VkImage image,
+    const VkDeviceSize offset
+);
+
+/**
+ * @brief Free a memory allocation.
+ *
+ * Any resources bound to the allocation must have been destroyed (or must not be used again), except a buffer created with the
+ * allocation by @ref oriCreateBuffer(), which is destroyed by this function. The handle becomes invalid.
+ *
+ * Allocations that are not freed are freed when their device is destroyed.
+ *
+ * @param device the handle of the logical device that the allocation was made from.
+ * @param allocation the handle of the allocation to free.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c allocation is @c ORION_NULL_HANDLE
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device or @c allocation is invalid
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ */
+const oriReturnStatus_t oriFreeMemory(
+    const oriHandle_t device,
+    const oriHandle_t allocation
+);
+
+/**
+ * @brief Retrieve the device memory object, offset, and size of a memory allocation.
+ *
+ * @param device the handle of the logical device that the allocation was made from.
+ * @param allocation the handle of the allocation.
+ * @param infoOut a pointer to the structure into which the information will be returned.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if @c infoOut is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device or @c allocation is invalid
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ */
+const oriReturnStatus_t oriGetAllocationInfo(
+    const oriHandle_t device,
+    const oriHandle_t allocation,
+    oriAllocationInfo_t *infoOut
+);
+
+/**
+ * @brief Import memory allocated by the application on the host as a memory allocation, so that the GPU can read and write it
+ * directly, without it being copied into a staging buffer first.
+ *
+ * @c VK_EXT_external_memory_host must be enabled on the device, and both the instance and the device must support Vulkan 1.1.
+ * Host pointers can only be imported from a multiple of
+ * @c minImportedHostPointerAlignment (see @ref oriDeviceLimits_t), which is normally the page size, so the pages around the data
+ * are imported along with it; the allocation itself starts at @c hostPointer, so offsets into it (and the @c mappedData pointer
+ * returned by @ref oriGetAllocationInfo()) are relative to the data. Memory allocated with page alignment (such as with
+ * @c mmap()) wastes nothing.
+ *
+ * If @c bufferUsage is not 0, a buffer covering the data is created and bound to the allocation, in the same way as
+ * @ref oriCreateBuffer(): it is destroyed along with the allocation, and is never moved by @ref oriDefragment(). Transfers from it
+ * read straight from the application's memory. Host-coherent memory types are preferred, so the data doesn't have to be flushed.
+ *
+ * The allocation is freed with @ref oriFreeMemory() (or when its device is destroyed), after which the application may free
+ * or reuse the host memory. The host memory must stay allocated until then, and until the GPU has finished with it.
+ *
+ * @param device the handle of the logical device to import the memory into.
+ * @param hostPointer a pointer to the start of the data to import.
+ * @param size the size of the data, in bytes.
+ * @param bufferUsage the usage flags of the buffer to create over the data (e.g. @c VK_BUFFER_USAGE_TRANSFER_SRC_BIT), or 0 to
+ * create no buffer.
+ * @param allocationOut a pointer to where the handle of the allocation will be returned.
+ * @param bufferOut a pointer to where the buffer will be returned (this may be NULL).
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c hostPointer is NULL
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if @c allocationOut is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid, if @c VK_EXT_external_memory_host is not enabled or Vulkan 1.1
+ * is not available, if @c size
+ * is 0, if the data is not aligned well enough for the buffer, or if the memory could not be imported
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriFreeMemory()
+ *
+ */
+const oriReturnStatus_t oriImportHostMemory(
+    const oriHandle_t device,
+    void *hostPointer,
+    const VkDeviceSize size,
+    const VkBufferUsageFlags bufferUsage,
+    oriHandle_t *allocationOut,
+    VkBuffer *bufferOut
+);
+
+/**
+ * @brief Do a pass of incremental defragmentation of the memory of a logical device.
+ *
+ * For each memory type with more than one block of memory, the block with the least memory in use is chosen, and movable buffers
+ * (see @ref oriCreateBuffer()) are moved out of it into free space in the other blocks, until @c maxBytes bytes have been moved
+ * in this pass. Calling this function every frame with a small budget eventually empties blocks, which are then released, so the
+ * amount of device memory in use stays close to what is actually allocated.
+ *
+ * A moved buffer is replaced by a new buffer, which is copied from the old one by commands recorded into @c commandBuffer. The
+ * allocation's handle stays the same, but @ref oriGetAllocationInfo() returns the new buffer from then on. The application must
+ * use the new buffer in any commands recorded after this call, and update anything that refers to the old one (e.g. descriptor
+ * sets). @c commandBuffer must execute before any of those commands, on a queue family that supports transfers.
+ *
+ * The old buffers and their memory are kept until a later call to this function with a @c completedValue of at least
+ * @c frameValue, so @c frameValue should be a value that is reached once @c commandBuffer and any work that uses the old buffers
+ * have completed (e.g. a frame index or timeline semaphore value, as in @ref oriRingEndFrame()).
+ *
+ * @param device the handle of the logical device whose memory to defragment.
+ * @param commandBuffer a command buffer in the recording state, into which the copies are recorded.
+ * @param maxBytes the maximum amount of memory to copy in this pass.
+ * @param frameValue the value that will be reached once the GPU has finished with the buffers moved in this pass.
+ * @param completedValue the value of the last frame that the GPU has finished with.
+ * @param statsOut NULL or a pointer to the structure into which the device's defragmentation statistics will be returned.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c commandBuffer is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ */
+const oriReturnStatus_t oriDefragment(
+    const oriHandle_t device,
+    const VkCommandBuffer commandBuffer,
+    const VkDeviceSize maxBytes,
+    const uint64_t frameValue,
+    const uint64_t completedValue,
+    oriDefragmentStats_t *statsOut
+);
+
+/**
+ * @brief Retrieve the memory budget and usage of each memory heap of a logical device.
+ *
+ * If the device supports VK_EXT_memory_budget (which is enabled automatically by @ref oriCreateLogicalDevice() with Vulkan 1.1), the budgets
+ * and usage are those reported by the implementation, and so include memory allocated by other processes and by the
+ * application outside of the memory manager. Otherwise, the budget of each heap is taken to be 80% of its size, and the usage
+ * is only what the memory manager has allocated.
+ *
+ * @param device the handle of the logical device to query.
+ * @param budgetOut a pointer to the structure into which the budgets will be returned.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if @c budgetOut is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriEnforceMemoryBudget()
+ *
+ */
+const oriReturnStatus_t oriGetMemoryBudget(
+    const oriHandle_t device,
+    oriMemoryBudget_t *budgetOut
+);
+
+/**
+ * @brief Mark an allocation as evictable, so that it can be evicted when its memory heap gets close to its budget.
+ *
+ * An allocation counts as used when it is marked as evictable and whenever @ref oriTouchAllocation() is called on it. When a heap
+ * goes over 90% of its budget, @c callback is called on every allocation in the blocks of device memory whose allocations are
+ * all evictable, starting from the least recently used block (a block is as recently used as the most recently used allocation
+ * in it), until enough memory would be released to get back under it. Evicting allocations that share a block with one that is not evictable would release
+ * nothing, so they are never evicted; the last block of each memory type is kept, so it is never evicted from either.
+ *
+ * The budget isn't enforced again until the usage of the heap has changed.
+ *
+ * Allocations are not evicted by the library itself, as only the application knows how to recreate what was in them.
+ *
+ * @param device the handle of the logical device that the allocation was made from.
+ * @param allocation the handle of the allocation.
+ * @param callback the function to call to evict the allocation, or NULL to make the allocation no longer evictable.
+ * @param userData a pointer passed to @c callback.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device or @c allocation is invalid
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriEvictionCallbackfun
+ * @sa @ref oriTouchAllocation()
+ *
+ */
+const oriReturnStatus_t oriSetAllocationEvictable(
+    const oriHandle_t device,
+    const oriHandle_t allocation,
+    const oriEvictionCallbackfun callback,
+    void *userData
+);
+
+/**
+ * @brief Mark an evictable allocation as just used, so that it is the last to be evicted.
+ *
+ * This should be called whenever the allocation is used in a frame (e.g. when a streamed texture is drawn). It has no effect on
+ * allocations that are not evictable.
+ *
+ * @param device the handle of the logical device that the allocation was made from.
+ * @param allocation the handle of the allocation.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device or @c allocation is invalid
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriSetAllocationEvictable()
+ *
+ */
+const oriReturnStatus_t oriTouchAllocation(
+    const oriHandle_t device,
+    const oriHandle_t allocation
+);
+
+/**
+ * @brief Evict allocations from any memory heap that is close to its budget.
+ *
+ * See @ref oriSetAllocationEvictable() for which allocations are evicted.
+ *
+ * This is also done automatically after an allocation once a heap has gone over 90% of its budget, but may be called (e.g. once
+ * a frame) to also account for memory allocated by other processes.
+ *
+ * @param device the handle of the logical device.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriSetAllocationEvictable()
+ * @sa @ref oriGetMemoryBudget()
+ *
+ */
+const oriReturnStatus_t oriEnforceMemoryBudget(
+    const oriHandle_t device
+);
+
+/**
+ * @brief Retrieve statistics of the memory manager of a logical device, per memory heap and memory type.
+ *
+ * Statistics only cover the blocks that allocations are sub-allocated from; they are gathered by walking every block, so
+ * this function should not be called every frame on a device with many allocations. The ring buffer (see
+ * @ref oriCreateDeviceRing()) and the uploader's staging buffer (see @ref oriCreateDeviceUploader()) have device memory of their
+ * own, outside of the blocks, so they are not included; they are only counted in the usage returned by
+ * @ref oriGetMemoryBudget().
+ *
+ * @param device the handle of the logical device to query.
+ * @param statisticsOut a pointer to the structure into which the statistics will be returned.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if @c statisticsOut is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriEnumerateMemoryBlocks()
+ * @sa @ref oriWriteMemoryMap()
+ *
+ */
+const oriReturnStatus_t oriGetMemoryStatistics(
+    const oriHandle_t device,
+    oriDeviceMemoryStatistics_t *statisticsOut
+);
+
+/**
+ * @brief Retrieve statistics of each device memory block of the memory manager of a logical device.
+ *
+ * If @c blocksOut is NULL, then the amount of blocks is returned into @c countOut. Otherwise, at most @c maxCount entries are
+ * written to @c blocksOut, and the amount written is returned into @c countOut.
+ *
+ * As with @ref oriGetMemoryStatistics(), the memory of the ring buffer and the uploader's staging buffer is not listed.
+ *
+ * @param device the handle of the logical device to query.
+ * @param maxCount the size of the @c blocksOut array.
+ * @param countOut NULL or a pointer to the variable into which the amount of entries will be returned
+ * @param blocksOut NULL or an array of at least @c maxCount elements into which the entries will be returned
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [SKIPPED](@ref oriReturnStatus_t) if @c blocksOut was too small to hold every block (like @c VK_INCOMPLETE)
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if both @c countOut @b and @c blocksOut are NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriGetMemoryStatistics()
+ *
+ */
+const oriReturnStatus_t oriEnumerateMemoryBlocks(
+    const oriHandle_t device,
+    const unsigned int maxCount,
+    unsigned int *countOut,
+    oriMemoryBlockStatistics_t *blocksOut
+);
+
+/**
+ * @brief Write the layout of every device memory block of a logical device to a JSON file, to be visualised offline.
+ *
+ * The file holds an object with the following members:
+ *  - @c total: the statistics of every block, as in @ref oriMemoryStatistics_t.
+ *  - @c heaps: the @c index, @c size, @c flags, last known @c budget, @c allocated bytes (including memory not sub-allocated,
+ *    such as the ring buffer and the uploader's staging buffer) and @c statistics of each memory heap. The ring and staging
+ *    memory is not part of any block, so it appears in no statistics and in no entry of @c blocks.
+ *  - @c memoryTypes: the @c index, @c heapIndex, @c propertyFlags and @c statistics of each memory type.
+ *  - @c blocks: the @c memoryType, @c size, whether it is @c dedicated or @c imported and the @c statistics of each block, and its @c ranges
+ *    in offset order. Each range has an
+ *    @c offset, a @c size and whether it is @c free; allocated ranges also say whether the allocation @c ownsBuffer (see
+ *    @ref oriCreateBuffer()), is @c movable by @ref oriDefragment(), is @c retired (moved, and waiting to be released) and is
+ *    @c evictable.
+ *
+ * Allocations made from the device on other threads wait until the file has been written.
+ *
+ * @param device the handle of the logical device to dump.
+ * @param path the path of the file to write, which is overwritten if it exists.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c path is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid or if the file could not be written
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriGetMemoryStatistics()
+ *
+ */
+const oriReturnStatus_t oriWriteMemoryMap(
+    const oriHandle_t device,
+    const char *path
+);
+
+/**
+ * @brief Record that the host has written to a range of a memory allocation, so that it is flushed by the next call to
+ * @ref oriFlushAllocations().
+ *
+ * Host-visible memory is mapped for as long as it is allocated, and can be written through the @c mappedData pointer returned by
+ * @ref oriGetAllocationInfo(). If the memory is not host-coherent, the writes must be flushed before the GPU reads them: rather
+ * than flushing them one at a time, the written ranges are recorded by this function (rounded out to @c nonCoherentAtomSize,
+ * and merged with each other), and all of them are flushed at once by @ref oriFlushAllocations(). Nothing is recorded for
+ * host-coherent memory or for memory imported with @ref oriImportHostMemory() (which the application writes directly, and
+ * which is not mapped through Vulkan), so this function can always be called.
+ *
+ * @param device the handle of the logical device that the allocation was made from.
+ * @param allocation the handle of the allocation that was written to.
+ * @param offset the offset of the written range from the start of the allocation.
+ * @param size the size of the written range, or @c VK_WHOLE_SIZE to cover the rest of the allocation.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device or @c allocation is invalid, if the allocation is not in host-visible
+ * memory, or if the range is not within it
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriFlushAllocations()
+ *
+ */
+const oriReturnStatus_t oriMarkAllocationWritten(
+    const oriHandle_t device,
+    const oriHandle_t allocation,
+    const VkDeviceSize offset,
+    const VkDeviceSize size
+);
+
+/**
+ * @brief Flush every range of memory recorded with @ref oriMarkAllocationWritten() since the last call, in a single
+ * @c vkFlushMappedMemoryRanges() call.
+ *
+ * This should be called once before each queue submission that reads memory written by the host.
+ *
+ * @param device the handle of the logical device whose memory to flush.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [SKIPPED](@ref oriReturnStatus_t) if no ranges were waiting to be flushed
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid, or if the memory could not be flushed
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriMarkAllocationWritten()
+ *
+ */
+const oriReturnStatus_t oriFlushAllocations(
+    const oriHandle_t device
+);
+
+/**
+ * @brief Make writes by the GPU to a range of a memory allocation visible to the host, before reading it through the
+ * @c mappedData pointer returned by @ref oriGetAllocationInfo().
+ *
+ * The range is rounded out to @c nonCoherentAtomSize. Nothing is done for host-coherent memory, or for imported host memory.
+ *
+ * @param device the handle of the logical device that the allocation was made from.
+ * @param allocation the handle of the allocation to read.
+ * @param offset the offset of the range from the start of the allocation.
+ * @param size the size of the range, or @c VK_WHOLE_SIZE to cover the rest of the allocation.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device or @c allocation is invalid, if the allocation is not in host-visible
+ * memory, if the range is not within it, or if the memory could not be invalidated
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ */
+const oriReturnStatus_t oriInvalidateAllocation(
+    const oriHandle_t device,
+    const oriHandle_t allocation,
+    const VkDeviceSize offset,
+    const VkDeviceSize size
+);
+
+/**
+ * @brief Create the ring buffer of a logical device, for data that only lives for one frame.
+ *
+ * The ring buffer is a single persistently mapped, host-visible and host-coherent buffer, allocated as
+ * @ref ORION_MEMORY_USAGE_CPU_TO_GPU memory (so in device-local memory, where possible). Allocating from it with @ref oriRingAllocate() only bumps a pointer, so it can replace the thousands of small buffers
+ * that would otherwise be created every frame for uniforms, dynamic vertices and indirect arguments.
+ *
+ * Allocations are grouped into frames with @ref oriRingEndFrame(), and the space of a frame is reclaimed with
+ * @ref oriRingReclaim() once the GPU has finished with it.
+ *
+ * The ring buffer is destroyed along with its device.
+ *
+ * @note The ring buffer must be created before any other thread uses it.
+ *
+ * @param device the handle of the logical device to create the ring buffer for.
+ * @param size the size of the ring buffer, in bytes. This must be at most 4 GiB (so that offsets can be used as dynamic
+ * offsets), and should be at least the amount of data allocated per frame, multiplied by the amount of frames in flight.
+ * @param usage the usage flags of the ring buffer (e.g. @c VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT).
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [SKIPPED](@ref oriReturnStatus_t) if the device already has a ring buffer
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid, if @c size is 0 or too large, or if the buffer or its memory
+ * could not be created
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ */
+const oriReturnStatus_t oriCreateDeviceRing(
+    const oriHandle_t device,
+    const VkDeviceSize size,
+    const VkBufferUsageFlags usage
+);
+
+/**
+ * @brief Allocate a range of the ring buffer of a logical device.
+ *
+ * The range is aligned to @c minUniformBufferOffsetAlignment (and at least 4 bytes). It can be written through the returned
+ * pointer without flushing, and stays valid until the frame that it was allocated in is reclaimed.
+ *
+ * @param device the handle of the logical device whose ring buffer to allocate from.
+ * @param size the size of the range, in bytes.
+ * @param allocationOut a pointer to the structure into which the range will be returned.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if the device has no ring buffer
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if @c allocationOut is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid, or if there is not enough space left in the ring buffer
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriCreateDeviceRing()
+ *
+ */
+const oriReturnStatus_t oriRingAllocate(
+    const oriHandle_t device,
+    const VkDeviceSize size,
+    oriRingAllocation_t *allocationOut
+);
+
+/**
+ * @brief End a frame of ring buffer allocations.
+ *
+ * Every range allocated from the ring buffer since the last call will be reclaimed when @ref oriRingReclaim() is called with a
+ * value of at least @c value. The value can be a frame index or the value that a timeline semaphore is signalled with once the
+ * frame's commands have executed; either way, it must not be less than the value of the previous frame.
+ *
+ * @param device the handle of the logical device whose ring buffer to use.
+ * @param value the value that marks the frame as complete.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if the device has no ring buffer
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ */
+const oriReturnStatus_t oriRingEndFrame(
+    const oriHandle_t device,
+    const uint64_t value
+);
+
+/**
+ * @brief Reclaim the ring buffer space of every frame that the GPU has finished with.
+ *
+ * @param device the handle of the logical device whose ring buffer to use.
+ * @param completedValue the value of the last completed frame (e.g. the value of a timeline semaphore, from
+ * [vkGetSemaphoreCounterValue()](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/vkGetSemaphoreCounterValue.html)).
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if the device has no ring buffer
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriRingEndFrame()
+ *
+ */
+const oriReturnStatus_t oriRingReclaim(
+    const oriHandle_t device,
+    const uint64_t completedValue
+);
+
+/**
+ * @brief Create the uploader of a logical device, which batches copies of data into buffers and images on a transfer queue.
+ *
+ * Uploads added with @ref oriUploadToBuffer() and @ref oriUploadToImage() are copied into a pooled staging buffer straight away,
+ * and recorded into a single command buffer when @ref oriSubmitUploads() is called: copies to the same resource are recorded as
+ * one command, with adjacent regions merged. This avoids creating a staging buffer and waiting for the queue to go idle for
+ * every resource. The staging buffer is allocated as @ref ORION_MEMORY_USAGE_STAGING memory, so it doesn't take up device-local
+ * memory.
+ *
+ * Each submission is given an increasing value. If timeline semaphores are enabled on the device (see
+ * @ref ORION_DEVICE_FEATURE_TIMELINE_SEMAPHORE_BIT), a timeline semaphore (see @ref oriGetUploadSemaphore()) is signalled with
+ * the value, which other queues can wait on; otherwise, a fence is used, and only the host can wait (with
+ * @ref oriWaitForUploads()).
+ *
+ * The queue family should be the one assigned to @ref ORION_QUEUE_ROLE_TRANSFER by @ref oriSolveQueueFamilies() (or found with
+ * @ref oriEnumerateAvailableQueueFamilies()), and the queue must have been created with the device. If the family is not the one
+ * that will use the resources, the resources should be created with @c VK_SHARING_MODE_CONCURRENT, or ownership of them must be
+ * transferred by the application.
+ *
+ * The uploader is destroyed along with its device (after waiting for its submissions to complete).
+ *
+ * @note The uploader must be created before any other thread uses it.
+ *
+ * @param device the handle of the logical device to create the uploader for.
+ * @param familyIndex the index of the queue family to submit uploads to.
+ * @param queueIndex the index of the queue in the family to submit uploads to.
+ * @param stagingSize the size of the staging buffer, in bytes. Every image upload must fit in it; buffer uploads larger than
+ * half of it are split.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [SKIPPED](@ref oriReturnStatus_t) if the device already has an uploader
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid, or if the Vulkan objects or staging buffer could not be created
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ */
+const oriReturnStatus_t oriCreateDeviceUploader(
+    const oriHandle_t device,
+    const unsigned int familyIndex,
+    const unsigned int queueIndex,
+    const VkDeviceSize stagingSize
+);
+
+/**
+ * @brief Add an upload of data to a buffer to the next upload submission.
+ *
+ * The data is copied into the staging buffer before this function returns, so it can be freed or reused straight away. If there
+ * is not enough staging memory left, pending uploads are submitted, and the oldest submissions are waited for, until there is.
+ * Uploads submitted like this are complete once the value returned by the next call to @ref oriSubmitUploads() is reached (the
+ * same as those it submits itself).
+ *
+ * As this function may submit to the uploader's queue, the application must not submit work to that queue from another thread
+ * while it runs, as with @ref oriSubmitUploads().
+ *
+ * @param device the handle of the logical device whose uploader to use.
+ * @param buffer the buffer to upload to. It must have been created with @c VK_BUFFER_USAGE_TRANSFER_DST_BIT.
+ * @param offset the offset in @c buffer to upload to.
+ * @param data the data to upload.
+ * @param size the size of @c data, in bytes.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c buffer or @c data is NULL, or if the device has no uploader
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid, or if pending uploads could not be submitted
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriSubmitUploads()
+ *
+ */
+const oriReturnStatus_t oriUploadToBuffer(
+    const oriHandle_t device,
+    const VkBuffer buffer,
+    const VkDeviceSize offset,
+    const void *data,
+    const VkDeviceSize size
+);
+
+/**
+ * @brief Add an upload of tightly packed texel data to an image to the next upload submission.
+ *
+ * The data is copied into the staging buffer as in @ref oriUploadToBuffer(). Staging data is aligned to 16 bytes (or
+ * @c optimalBufferCopyOffsetAlignment, if larger), so formats with texel blocks of 3, 6 or 12 bytes are not supported.
+ *
+ * Like @ref oriUploadToBuffer(), this function may submit pending uploads to the uploader's queue if there is not enough
+ * staging memory left, so the application must not submit work to that queue from another thread while it runs. Uploads
+ * submitted like this are complete once the value returned by the next call to @ref oriSubmitUploads() is reached.
+ *
+ * @param device the handle of the logical device whose uploader to use.
+ * @param image the image to upload to. It must have been created with @c VK_IMAGE_USAGE_TRANSFER_DST_BIT, and it must be in
+ * the @c VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL layout when the upload is executed.
+ * @param subresource the subresource of @c image to upload to.
+ * @param offset the offset in the subresource to upload to, in texels.
+ * @param extent the size of the region to upload to, in texels.
+ * @param data the data to upload.
+ * @param size the size of @c data, in bytes.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if @c image, @c subresource or @c data is NULL, or if the device has no uploader
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid, if @c size is larger than the staging buffer, or if pending
+ * uploads could not be submitted
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ * @sa @ref oriSubmitUploads()
+ *
+ */
+const oriReturnStatus_t oriUploadToImage(
+    const oriHandle_t device,
+    const VkImage image,
+    const VkImageSubresourceLayers *subresource,
+    const VkOffset3D offset,
+    const VkExtent3D extent,
+    const void *data,
+    const VkDeviceSize size
+);
+
+/**
+ * @brief Submit all pending uploads of a logical device to its transfer queue.
+ *
+ * The application must not submit work to the uploader's queue from another thread while this function runs.
+ *
+ * The returned value also covers uploads that @ref oriUploadToBuffer() or @ref oriUploadToImage() submitted on their own since
+ * the last call, as submissions to the queue complete in order.
+ *
+ * @param device the handle of the logical device whose uploader to use.
+ * @param signalSemaphore VK_NULL_HANDLE or a binary semaphore to be signalled when the uploads are complete (e.g. to be waited on
+ * by the graphics queue when timeline semaphores are not available). If there are no pending uploads, it is still signalled.
+ * @param valueOut NULL or a pointer to the variable into which the value of the submission will be returned. The uploads are
+ * complete once the upload semaphore reaches this value, or when @ref oriWaitForUploads() returns.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [SKIPPED](@ref oriReturnStatus_t) if there were no pending uploads and no semaphore to signal (in which case the value
+ * of the last submission is returned)
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if the device has no uploader
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid, or if the uploads could not be recorded or submitted
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ */
+const oriReturnStatus_t oriSubmitUploads(
+    const oriHandle_t device,
+    const VkSemaphore signalSemaphore,
+    uint64_t *valueOut
+);
+
+/**
+ * @brief Retrieve the timeline semaphore signalled by the upload submissions of a logical device.
+ *
+ * To make another queue wait for uploads, wait on this semaphore with the value returned by @ref oriSubmitUploads() (and a
+ * stage mask including the stages that use the uploaded resources).
+ *
+ * @param device the handle of the logical device whose uploader to use.
+ * @param semaphoreOut a pointer to the variable into which the semaphore will be returned. It is VK_NULL_HANDLE if timeline
+ * semaphores are not enabled on the device.
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if the device has no uploader
+ * @return [NO_OUTPUT](@ref oriReturnStatus_t) if @c semaphoreOut is NULL
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ */
+const oriReturnStatus_t oriGetUploadSemaphore(
+    const oriHandle_t device,
+    VkSemaphore *semaphoreOut
+);
+
+/**
+ * @brief Wait on the host for an upload submission of a logical device to complete.
+ *
+ * @param device the handle of the logical device whose uploader to use.
+ * @param value the value of the submission, as returned by @ref oriSubmitUploads().
+ * @return [OK](@ref oriReturnStatus_t) if executed successfully
+ * @return [NULL_POINTER](@ref oriReturnStatus_t) if the device has no uploader
+ * @return [ERROR](@ref oriReturnStatus_t) if @c device is invalid
+ *
+ * @ingroup grp_core_vkapi_core_memory
+ *
+ */
+const oriReturnStatus_t oriWaitForUploads(
+    const oriHandle_t device,
+    const uint64_t value
+);
+
+
+// ----[Orion library public interface]---------------------------------------- //
+//                               Alignment helpers                              //
+
+/**
+ * @brief Round a value up to the next multiple of a power-of-two alignment, given as a mask (the alignment minus one).
+ *
+ * @param value the value to round up.
+ * @param mask the alignment minus one (e.g. a mask from @ref oriDeviceLimits_t).
+ * @return the smallest multiple of the alignment that is not less than @c value.
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ */
+static inline VkDeviceSize oriAlignUp(
+    const VkDeviceSize value,
+    const VkDeviceSize mask
+) {
+    return (value + mask) & ~mask;
+}
+
+/**
+ * @brief Round a value down to a multiple of a power-of-two alignment, given as a mask (the alignment minus one).
+ *
+ * @param value the value to round down.
+ * @param mask the alignment minus one (e.g. a mask from @ref oriDeviceLimits_t).
+ * @return the largest multiple of the alignment that is not more than @c value.
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ */
+static inline VkDeviceSize oriAlignDown(
+    const VkDeviceSize value,
+    const VkDeviceSize mask
+) {
+    return value & ~mask;
+}
+
+/**
+ * @brief Check if a value is a multiple of a power-of-two alignment, given as a mask (the alignment minus one).
+ *
+ * @param value the value to check.
+ * @param mask the alignment minus one (e.g. a mask from @ref oriDeviceLimits_t).
+ * @return true if @c value is aligned, false otherwise.
+ *
+ * @ingroup grp_core_vkapi_core_devices
+ *
+ */
+static inline bool oriIsAligned(
+    const VkDeviceSize value,
+    const VkDeviceSize mask
+) {
+    return !(value & mask);
+}
+
 #ifdef __cplusplus
     }
 #endif // __cplusplus
@@ -65,6 +65,17 @@ typedef enum _oriErrorCode_t {
     ORIERR_INVALID_OBJECT = 0x04,
     ORIERR_VULKAN_QUERY_FAIL = 0x05,
     ORIERR_DEVICE_CREATION_FAIL = 0x06,
+    ORIERR_EXTENSION_NOT_ENABLED = 0x07,
+    ORIERR_OBJECT_CREATION_FAIL = 0x08,
+    ORIERR_STALE_HANDLE = 0x09,
+    ORIERR_QUEUE_ROLE_UNSATISFIED = 0x0A,
+    ORIERR_DRIVER_LOAD_FAIL = 0x0B,
+    ORIERR_NO_SUITABLE_MEMORY_TYPE = 0x0C,
+    ORIERR_MEMORY_ALLOCATION_FAIL = 0x0D,
+    ORIERR_RING_BUFFER_FULL = 0x0E,
+    ORIERR_INVALID_MAPPED_RANGE = 0x0F,
+    ORIERR_OFFSET_OUT_OF_RANGE = 0x10,
+    ORIERR_UNSUPPORTED_VERSION = 0x11,
 
     ORIFERR_MEMORY_ERROR = 0xD0
 } _oriErrorCode_t;
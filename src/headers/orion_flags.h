@@ -48,6 +48,23 @@
 // ============================================================================ //
 
 
+// ----[Private/internal systems]---------------------------------------------- //
+//                                  Contracts                                   //
+
+// Evaluates to true if an argument contract of a public function is broken, i.e. if 'violation' (a condition that the caller
+// is required to avoid, such as a NULL pointer or a stale handle) is true. Used as `if (_ORI_CONTRACT_BROKEN(!p)) { error }`.
+//
+// In trusted builds (ORION_TRUSTED), the caller is assumed to keep every contract: the violation becomes an assertion, which
+// compiles to nothing (along with the error handling it guards) when NDEBUG is defined.
+//
+#ifdef ORION_TRUSTED
+#   include <assert.h>
+#   define _ORI_CONTRACT_BROKEN(violation) (assert(!(violation)), 0)
+#else
+#   define _ORI_CONTRACT_BROKEN(violation) (violation)
+#endif
+
+
 // ----[Private/internal systems]---------------------------------------------- //
 //                            Flag/macro definitions                            //
 
@@ -55,6 +72,87 @@
 //
 #define MAX_LOG_LEN 768
 
+// Maximum amount of distinct performance warning message IDs counted by an Orion-managed debug messenger.
+// Must be a power of two (the histogram is an open-addressing hash table).
+//
+#define MAX_PERF_WARNING_IDS 256
+
+// Layout of generational handles (oriHandle_t): the slot index is stored in the low bits, followed by the generation of the
+// slot and the type of object referred to. These must add up to 32.
+//
+#define HANDLE_INDEX_BITS 16
+#define HANDLE_GENERATION_BITS 12
+#define HANDLE_TYPE_BITS 4
+
+// Amount of slots allocated the first time a handle table is used (tables double in size when they are full).
+//
+#define HANDLE_TABLE_INITIAL_CAPACITY 8
+
+// Amount of creation/destruction records in each block of a per-thread object tracker buffer.
+//
+#define TRACKER_CHUNK_SIZE 1024
+
+// Maximum amount of distinct object types counted by the object tracker (further types are still tracked, just not counted per-type).
+//
+#define MAX_TRACKED_OBJECT_TYPES 32
+
+// Maximum amount of individual leaked objects listed by the object tracker in oriTerminate().
+//
+#define MAX_TRACKER_LEAK_REPORT_OBJECTS 32
+
+// Amount of entries in each per-physical-device format property table (one per core format, VK_FORMAT_UNDEFINED to
+// VK_FORMAT_ASTC_12x12_SRGB_BLOCK). Formats outside of this range are queried from the driver every time.
+//
+#define FORMAT_TABLE_SIZE 185
+
+// Maximum length of file paths built by the startup cache (see cache.c).
+//
+#define PATH_MAX_LEN 1024
+
+// Size of the device memory blocks that allocations are sub-allocated from (see vk_memory.c). Heaps of at most
+// MEMORY_SMALL_HEAP_SIZE bytes use blocks of an eighth of the heap instead.
+//
+#define MEMORY_BLOCK_SIZE (256ull << 20)
+#define MEMORY_SMALL_HEAP_SIZE (1ull << 30)
+
+// Granularity of sub-allocations: the offsets and sizes of all allocations within a block are multiples of this.
+// Must be a power of two.
+//
+#define MEMORY_MIN_ALLOCATION_SIZE 256
+
+// Size from which resources are given their own device memory (with VkMemoryDedicatedAllocateInfo) instead of being
+// sub-allocated, as they would leave too much of a block unusable; the driver can also ask for resources of any size to be.
+//
+#define MEMORY_DEDICATED_ALLOCATION_SIZE (64ull << 20)
+
+// log2 of the amount of second-level size classes that each power of two is split into by the TLSF sub-allocator.
+// Must be at most log2(MEMORY_MIN_ALLOCATION_SIZE).
+//
+#define MEMORY_TLSF_SL_BITS 4
+
+// Maximum amount of frames whose ring buffer allocations can be waiting to be reclaimed at once (see vk_ring.c).
+// If more frames end before any are reclaimed, the oldest frames are merged.
+//
+#define MEMORY_RING_MAX_FRAMES 16
+
+// Maximum amount of upload submissions that can be in flight at once (see vk_upload.c); each has its own command buffer.
+// Must be at most MEMORY_RING_MAX_FRAMES.
+//
+#define MEMORY_UPLOAD_MAX_SUBMISSIONS 8
+
+// Fraction of the budget of a heap that its usage has to exceed for evictable allocations in it to be evicted (see vk_budget.c).
+//
+#define MEMORY_BUDGET_EVICTION_THRESHOLD 0.9
+
+// Fraction of the size of a heap that is used as its budget when VK_EXT_memory_budget is not available.
+//
+#define MEMORY_BUDGET_FALLBACK_FRACTION 0.8
+
+// Amount of device memory allocations and frees after which the budget is queried again. In between, the usage reported by
+// VK_EXT_memory_budget is adjusted by what the memory manager has allocated and freed since.
+//
+#define MEMORY_BUDGET_REFRESH_INTERVAL 16
+
 #ifdef __cplusplus
     }
 #endif // __cplusplus
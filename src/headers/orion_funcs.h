@@ -66,9 +66,486 @@ void _oriDefaultDebugCallback(
 );
 
 
+// Callback for Orion-managed Vulkan debug messengers (signature of PFN_vkDebugUtilsMessengerCallbackEXT)
+// pUserData is the _oriPerfWarningHistogram_t of the messenger's instance.
+//
+VKAPI_ATTR VkBool32 VKAPI_CALL _oriVulkanDebugMessengerCallback(
+    VkDebugUtilsMessageSeverityFlagBitsEXT severity,
+    VkDebugUtilsMessageTypeFlagsEXT types,
+    const VkDebugUtilsMessengerCallbackDataEXT *callbackData,
+    void *pUserData
+);
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                              String array helpers                            //
+
+// Allocate a copy of an array of strings (NULL if count is 0), to be freed with _oriFreeStrings()
+//
+char **_oriCopyStrings(
+    const unsigned int count,
+    const char **strings
+);
+
+// Free an array of strings allocated by _oriCopyStrings()
+//
+void _oriFreeStrings(
+    const unsigned int count,
+    char **strings
+);
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                           Asynchronous initialisation                        //
+
+// Wait for an initialisation started with oriInitAsync() to finish, if one is running
+// This is a single atomic load if there is nothing to wait for, and returns immediately when called from the initialisation thread.
+//
+void _oriAwaitInit();
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                              Generational handles                            //
+
+// Store a record in a free slot of a handle table and return a handle to it
+// Returns ORION_NULL_HANDLE if the table is full.
+//
+const oriHandle_t _oriCreateHandle(
+    _oriHandleTable_t *table,
+    const _oriHandleType_t type,
+    void *record
+);
+
+// Get the record that a handle refers to
+// Returns NULL if the handle is not of the given type, or if it is stale (its slot has since been released).
+//
+void *_oriResolveHandle(
+    const _oriHandleTable_t *table,
+    const _oriHandleType_t type,
+    const oriHandle_t handle
+);
+
+// Change the record that a valid handle refers to (without invalidating the handle)
+//
+void _oriReplaceHandleRecord(
+    _oriHandleTable_t *table,
+    const oriHandle_t handle,
+    void *record
+);
+
+// Release the slot of a handle, invalidating it and any copies of it
+//
+void _oriDestroyHandle(
+    _oriHandleTable_t *table,
+    const oriHandle_t handle
+);
+
+// Free the arrays of a handle table (the records themselves are not freed)
+//
+void _oriFreeHandleTable(
+    _oriHandleTable_t *table
+);
+
+// Get the instance/device wrapper that a handle refers to
+// Sends an appropriate error (tagged with 'func') and returns NULL if the handle is invalid or stale.
+//
+_oriVkInstance_t *_oriGetInstance(
+    const oriHandle_t instance,
+    const char *func
+);
+_oriVkDevice_t *_oriGetDevice(
+    const oriHandle_t device,
+    const char *func
+);
+
+// Get the allocated chunk that an allocation handle of a device refers to (the device's memory lock must be held)
+// Sends an appropriate error (tagged with 'func') and returns NULL if the handle is invalid or stale.
+//
+_oriMemoryChunk_t *_oriGetAllocation(
+    _oriVkDevice_t *device,
+    const oriHandle_t allocation,
+    const char *func
+);
+
+// Destroy a logical device and free its wrapper (its handle must be released separately)
+//
+void _oriDestroyDeviceRecord(
+    _oriVkDevice_t *device
+);
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                           Device memory management                           //
+
+// Set up the memory manager of a new device record
+// Returns false if there was an error.
+//
+const bool _oriInitMemoryManager(
+    _oriVkDevice_t *device
+);
+
+// Free all device memory still held by a device's memory manager (this must be done before the device is destroyed)
+//
+void _oriDestroyMemoryManager(
+    _oriVkDevice_t *device
+);
+
+// Make sure there are at least 'count' spare chunk records, so that an allocation can't fail half-way through splitting a chunk
+// Returns false if there was an error.
+//
+const bool _oriReserveChunks(
+    _oriMemoryManager_t *manager,
+    unsigned int count
+);
+
+// Sub-allocate a chunk from a block, or return NULL if there is no free chunk that is large enough
+// 'size' must be a multiple of MEMORY_MIN_ALLOCATION_SIZE, and two spare chunk records must have been reserved.
+//
+_oriMemoryChunk_t *_oriAllocateFromBlock(
+    _oriMemoryManager_t *manager,
+    _oriMemoryBlock_t *block,
+    const VkDeviceSize size,
+    const VkDeviceSize alignment
+);
+
+// Destroy the buffer owned by an allocated chunk, if any, and return the chunk to its block, releasing the block if it is left
+// empty (the device's memory lock must be held)
+// Returns the size of the block if it was released, or 0.
+//
+const VkDeviceSize _oriReleaseChunk(
+    _oriVkDevice_t *device,
+    _oriMemoryChunk_t *chunk
+);
+
+// Allocate a whole device memory object of the best memory type for a usage (of those with every required property) that is
+// not shared with any sub-allocation; it counts towards maxMemoryAllocationCount like a block.
+// Returns false if there was an error.
+//
+const bool _oriAllocateDeviceMemory(
+    _oriVkDevice_t *device,
+    const VkMemoryRequirements *requirements,
+    const oriMemoryUsage_t usage,
+    const VkMemoryPropertyFlags requiredFlags,
+    VkDeviceMemory *memoryOut,
+    uint32_t *memoryTypeOut,
+    const char *func
+);
+
+// Free a device memory object allocated with _oriAllocateDeviceMemory()
+//
+void _oriFreeDeviceMemory(
+    _oriVkDevice_t *device,
+    const VkDeviceMemory memory,
+    const uint32_t memoryTypeIndex,
+    const VkDeviceSize size
+);
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                           Memory budget and residency                        //
+
+// Set up budget tracking for a new memory manager (called by _oriInitMemoryManager())
+//
+void _oriInitMemoryBudget(
+    _oriVkDevice_t *device
+);
+
+// Account for device memory allocated or freed by the memory manager of a device (the memory lock must be held)
+// The budget is queried again every MEMORY_BUDGET_REFRESH_INTERVAL calls.
+//
+void _oriAccountDeviceMemory(
+    _oriVkDevice_t *device,
+    const uint32_t memoryTypeIndex,
+    const VkDeviceSize size,
+    const bool allocated
+);
+
+// Make an evictable allocation no longer evictable (the memory lock must be held)
+//
+void _oriClearEvictable(
+    _oriMemoryManager_t *manager,
+    _oriMemoryChunk_t *chunk
+);
+
+// Move the eviction callback and last use of an evictable chunk to a new one, e.g. when the defragmenter moves an allocation
+// (the memory lock must be held)
+//
+void _oriReplaceEvictable(
+    _oriMemoryChunk_t *chunk,
+    _oriMemoryChunk_t *replacement
+);
+
+// Evict whole blocks (least recently used first) from each heap that is over MEMORY_BUDGET_EVICTION_THRESHOLD of its budget
+// The memory lock must NOT be held, as eviction callbacks are likely to free memory.
+//
+void _oriEnforceMemoryBudget(
+    _oriVkDevice_t *device,
+    const oriHandle_t deviceHandle
+);
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                                 Mapped memory                                //
+
+// Forget the ranges of a device memory object waiting to be flushed, e.g. because the memory is being freed (the memory lock
+// must be held)
+//
+void _oriDropDirtyRanges(
+    _oriMemoryManager_t *manager,
+    const VkDeviceMemory memory
+);
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                                 Ring buffers                                 //
+
+// Create the buffer and memory of a ring buffer, mapped for its whole lifetime
+// Returns false if there was an error.
+//
+const bool _oriInitRing(
+    _oriVkDevice_t *device,
+    _oriRingBuffer_t *ring,
+    const VkDeviceSize size,
+    const VkDeviceSize alignmentMask,
+    const VkBufferUsageFlags usage,
+    const oriMemoryUsage_t memoryUsage,
+    const char *func
+);
+
+// Free the buffer and memory of a ring buffer
+//
+void _oriFreeRing(
+    _oriVkDevice_t *device,
+    _oriRingBuffer_t *ring
+);
+
+// Allocate a range of a ring buffer
+// Returns false (without throwing an error) if there is not enough space that has not yet been reclaimed.
+//
+const bool _oriRingAllocate(
+    _oriRingBuffer_t *ring,
+    const VkDeviceSize size,
+    VkDeviceSize *offsetOut
+);
+
+// Mark every range allocated since the last call to be reclaimed once 'value' is completed
+//
+void _oriRingEndFrame(
+    _oriRingBuffer_t *ring,
+    const uint64_t value
+);
+
+// Reclaim the ranges of every frame with a value of at most 'completedValue'
+//
+void _oriRingReclaim(
+    _oriRingBuffer_t *ring,
+    const uint64_t completedValue
+);
+
+// Free the ring buffer of a device, if it has one (this must be done before the device is destroyed)
+//
+void _oriDestroyDeviceRing(
+    _oriVkDevice_t *device
+);
+
+// Wait for all uploads of a device to complete, then free its uploader, if it has one (this must be done before the device
+// is destroyed)
+//
+void _oriDestroyDeviceUploader(
+    _oriVkDevice_t *device
+);
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                         Vulkan structure chain helpers                       //
+
+// Find the first structure of the given type in a pNext chain, or NULL if it is not there
+//
+const void *_oriFindStructureInChain(
+    const void *chain,
+    const VkStructureType sType
+);
+
+// Prepare the structures for the current validation profile (_orion.validationProfile), chained in front of 'next'.
+// Any extensions that the structures need are appended to 'exts' (which must have space for 2 more names).
+// Returns false if the profile could not (or need not) be applied, in which case 'chain' must not be used.
+//
+const bool _oriChainValidationProfile(
+    _oriValidationProfileChain_t *chain,
+    const void *next,
+    const unsigned int layerCount,
+    const char **layers,
+    unsigned int *extCount,
+    const char **exts
+);
+
+// Open the driver named by the ORION_DIRECT_DRIVER environment variable, if no driver was set with oriSetDirectDriver().
+//
+void _oriLoadConfiguredDirectDriver();
+
+// Prepare the structures to load the driver set with oriSetDirectDriver() (if any), chained in front of 'next'.
+// VK_LUNARG_direct_driver_loading is appended to 'exts' (which must have space for 1 more name).
+// Returns false if there is no driver to load, or the loader does not support direct driver loading, in which case 'chain'
+// must not be used.
+//
+#ifdef VK_LUNARG_direct_driver_loading
+    const bool _oriChainDirectDriver(
+        _oriDirectDriverChain_t *chain,
+        const void *next,
+        unsigned int *extCount,
+        const char **exts
+    );
+#endif
+
+// Close the driver library opened by oriSetDirectDriver() (this must be done after every instance has been destroyed)
+//
+void _oriCloseDirectDriver();
+
+// Work out which oriDeviceFeatureBit_t flags are enabled by the feature structures in a device pNext chain
+// (the structures of Vulkan versions above 'apiVersion', the lower of the instance and device versions, are ignored)
+//
+const uint32_t _oriGetChainedDeviceFeatures(
+    const void *chain,
+    const uint32_t apiVersion
+);
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                            Object lifetime tracker                           //
+
+// Convert Vulkan handles to the 64-bit integers stored by the object tracker
+// (non-dispatchable handles are already 64-bit integers on 32-bit platforms)
+//
+#define _ORI_DISPATCHABLE_HANDLE_U64(handle) ((uint64_t) (uintptr_t) (handle))
+#if defined(VK_USE_64_BIT_PTR_DEFINES) && VK_USE_64_BIT_PTR_DEFINES == 0
+#   define _ORI_NON_DISPATCHABLE_HANDLE_U64(handle) ((uint64_t) (handle))
+#else
+#   define _ORI_NON_DISPATCHABLE_HANDLE_U64(handle) ((uint64_t) (uintptr_t) (handle))
+#endif
+
+// Record the creation of an Orion-managed object in the calling thread's tracker buffer
+// 'size' is the amount of memory (host or device) owned by the object, or 0 if not applicable.
+// Does nothing (besides one atomic load) if object tracking is disabled.
+//
+void _oriTrackObjectCreation(
+    const VkObjectType type,
+    const uint64_t handle,
+    const uint64_t size
+);
+
+// Record the destruction of an Orion-managed object in the calling thread's tracker buffer
+//
+void _oriTrackObjectDestruction(
+    const VkObjectType type,
+    const uint64_t handle
+);
+
+// Report any objects still alive and free all tracker buffers (called in oriTerminate())
+//
+void _oriTerminateObjectTracker();
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                            Format property tables                            //
+
+// Wait for any background threads filling format tables, then free all of the tables
+// This must be called before the instances that the physical devices belong to are destroyed.
+//
+void _oriFreeFormatTables();
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                                 Startup cache                                //
+
+// Hash a string for use in a cache subkey (0 for NULL)
+//
+const uint64_t _oriHashCacheString(
+    const char *s
+);
+
+// Compute the part of cache subkeys that identifies a physical device and its driver
+//
+const uint64_t _oriGetPhysicalDeviceCacheKey(
+    const VkPhysicalDevice physicalDevice
+);
+
+// Find an entry in the startup cache, returning NULL if there isn't one (or if the cache is not in use)
+//
+const void *_oriFindCacheEntry(
+    const _oriCacheEntryKind_t kind,
+    const uint64_t subkey,
+    uint32_t *sizeOut
+);
+
+// Add an entry to the startup cache (this does nothing if the cache is not in use)
+//
+void _oriStoreCacheEntry(
+    const _oriCacheEntryKind_t kind,
+    const uint64_t subkey,
+    const void *data,
+    const uint32_t size
+);
+
+// Look for a name in a cached list of layer or extension names.
+// Returns false if the list is not in the cache, in which case foundOut is not written to.
+//
+const bool _oriFindCachedName(
+    const _oriCacheEntryKind_t kind,
+    const uint64_t subkey,
+    const char *name,
+    bool *foundOut
+);
+
+// Add a list of layer or extension names to the startup cache, from an array of VkLayerProperties or VkExtensionProperties
+//
+void _oriStoreCachedNames(
+    const _oriCacheEntryKind_t kind,
+    const uint64_t subkey,
+    const unsigned int count,
+    const void *properties,
+    const size_t stride
+);
+
+// Write the startup cache if anything was added to it, then unmap and free it (called in oriTerminate())
+//
+void _oriCloseStartupCache();
+
+
 // ----[Private/internal systems]---------------------------------------------- //
 //                        Error-throwing helper functions                       //
 
+// Check if a message of the given severity and category would be recieved by the global callback or any subscriber
+// Used to avoid formatting messages that nobody wants.
+//
+const bool _oriCheckDebugInterest(
+    const oriSeverityBit_t severity,
+    const oriDebugCategoryBit_t category
+);
+
+// Send an already-formatted message to the global debug callback and all interested subscribers
+// The global callback always recieves errors and fatal errors, regardless of debug message configuration.
+//
+void _oriDispatchDebugMessage(
+    const char *name,
+    const unsigned int code,
+    const char *message,
+    const oriSeverityBit_t severity,
+    const oriDebugCategoryBit_t category
+);
+
+// Free the current and all retired debug subscriber lists (called in oriTerminate())
+//
+void _oriFreeDebugSubscribers();
+
+// Count a performance warning in the histogram of a debug messenger
+// The name is only copied the first time a message ID is seen.
+//
+void _oriRecordPerformanceWarning(
+    _oriPerfWarningHistogram_t *histogram,
+    const int32_t id,
+    const char *name
+);
+
 // Send a debug log to console (severity of ORION_DEBUG_SEVERITY_VERBOSE_BIT)
 //
 void _oriLog(
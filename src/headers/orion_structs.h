@@ -45,9 +45,13 @@
 #endif // __cplusplus
 
 #include "orion.h"
+#include "orion_flags.h"
 
 #include "uthash/include/uthash.h"
 
+#include <stdatomic.h>
+#include <threads.h>
+
 
 // ============================================================================ //
 // *****                     Private/internal systems                     ***** //
@@ -59,31 +63,154 @@
 
 typedef struct _oriLibrary_t _oriLibrary_t;
 typedef struct _oriError_t _oriError_t;
+typedef struct _oriDebugSubscriber_t _oriDebugSubscriber_t;
+typedef struct _oriDebugSubscriberList_t _oriDebugSubscriberList_t;
+
+typedef struct _oriPerfWarningHistogram_t _oriPerfWarningHistogram_t;
+typedef struct _oriValidationProfileChain_t _oriValidationProfileChain_t;
+typedef struct _oriDirectDriverChain_t _oriDirectDriverChain_t;
+typedef struct _oriAsyncInit_t _oriAsyncInit_t;
+
+typedef struct _oriTrackerRecord_t _oriTrackerRecord_t;
+typedef struct _oriTrackerChunk_t _oriTrackerChunk_t;
+typedef struct _oriTrackerBuffer_t _oriTrackerBuffer_t;
+typedef struct _oriTrackedObject_t _oriTrackedObject_t;
+typedef struct _oriTrackedType_t _oriTrackedType_t;
+
+typedef struct _oriHandleTable_t _oriHandleTable_t;
 
 typedef struct _oriVkInstance_t _oriVkInstance_t;
 typedef struct _oriVkDevice_t _oriVkDevice_t;
 
+typedef struct _oriMemoryChunk_t _oriMemoryChunk_t;
+typedef struct _oriMemoryBlock_t _oriMemoryBlock_t;
+typedef struct _oriMemoryManager_t _oriMemoryManager_t;
+typedef struct _oriRingFrame_t _oriRingFrame_t;
+typedef struct _oriRingBuffer_t _oriRingBuffer_t;
+typedef struct _oriBufferUpload_t _oriBufferUpload_t;
+typedef struct _oriImageUpload_t _oriImageUpload_t;
+typedef struct _oriUploader_t _oriUploader_t;
+
+typedef struct _oriFormatTable_t _oriFormatTable_t;
+typedef struct _oriCacheEntry_t _oriCacheEntry_t;
+
+// Per-type live counters, used to report growth between reports
+// (defined before _oriLibrary_t, which holds an array of them)
+//
+typedef struct _oriTrackedType_t {
+    VkObjectType type;
+
+    int64_t live;
+    int64_t bytes;
+
+    int64_t liveAtLastReport;
+} _oriTrackedType_t;
+
+// Types of object referred to by generational handles (stored in the top HANDLE_TYPE_BITS bits of each handle)
+// 0 is never used, so that no valid handle is equal to ORION_NULL_HANDLE.
+//
+typedef enum _oriHandleType_t {
+    _ORI_HANDLE_TYPE_INSTANCE = 1,
+    _ORI_HANDLE_TYPE_DEVICE = 2,
+    _ORI_HANDLE_TYPE_ALLOCATION = 3,
+} _oriHandleType_t;
+
+// Structure-of-arrays table of library-owned objects, addressed by generational handles (see handle.c)
+// Slot i is described by generations[i] and records[i]; a handle is only valid while its generation matches that of its slot.
+//
+typedef struct _oriHandleTable_t {
+    uint16_t *generations;
+    void **records;         // NULL for free slots
+
+    uint16_t *freeSlots;    // stack of released slot indices, reused before new slots are handed out
+    unsigned int freeCount;
+
+    unsigned int used;      // amount of slots that have ever been handed out
+    unsigned int capacity;
+} _oriHandleTable_t;
+
 // Struct to hold global library data
 //
 typedef struct _oriLibrary_t {
     bool initialised;
+    unsigned int apiVersion; // the apiVersion given to oriInit(), which every instance was created with
 
     oriSeverityBit_t debugMessageSeverities;
 
+    oriValidationProfile_t validationProfile;
+
+    // driver to load with VK_LUNARG_direct_driver_loading (see init.c)
+    struct {
+        void *library; // NULL if no driver is set
+        PFN_vkVoidFunction getInstanceProcAddr; // the driver's vk_icdGetInstanceProcAddr
+        bool exclusive;
+    } directDriver;
+
     struct {
         struct {
             oriDebugCallbackfun fun;
             void *pointer;
+
+            // copy-on-write list of additional subscribers (see _oriDebugSubscriberList_t)
+            _Atomic(_oriDebugSubscriberList_t *) subscribers;
+            atomic_uint nextSubscriberID;
         } debug;
 
         VkAllocationCallbacks *vulkanAllocators;
     } callbacks;
 
-    // struct of hashtables of pointers to Orion-created Vulkan structures
+    // object lifetime tracker (see tracker.c)
+    struct {
+        atomic_bool enabled;
+
+        // every thread that has recorded an event owns one buffer in this list (pushed with a CAS, never removed until oriTerminate())
+        _Atomic(_oriTrackerBuffer_t *) buffers;
+
+        // everything below is only touched by whoever holds the lock (i.e. while reading the buffers)
+        atomic_flag lock;
+
+        _oriTrackedObject_t *live; // hashtable of objects folded in from the buffers
+        _oriTrackedType_t types[MAX_TRACKED_OBJECT_TYPES];
+        unsigned int typeCount;
+
+        int64_t liveObjects;
+        int64_t liveBytes;
+        int64_t liveAtLastReport;
+
+        uint64_t totalCreated;
+        uint64_t totalDestroyed;
+    } tracker;
+
+    // struct of handle tables of Orion-created Vulkan structures
     struct {
-        _oriVkInstance_t *vkInstances;
-        _oriVkDevice_t *vkDevices;
+        _oriHandleTable_t instances;    // of _oriVkInstance_t
+        _oriHandleTable_t devices;      // of _oriVkDevice_t
     } allocatees;
+
+    // format property tables, one per physical device (pushed with a CAS, never removed until oriTerminate(); see vk_format.c)
+    _Atomic(_oriFormatTable_t *) formatTables;
+
+    // initialisation started with oriInitAsync() (see init.c)
+    struct {
+        atomic_int state; // one of the _oriAsyncInitState_t values
+        thrd_t thread;
+        _oriAsyncInit_t *args;
+
+        bool started; // set by oriInitAsync(), cleared by oriTerminate()
+        oriReturnStatus_t status; // result of the initialisation, once it has been waited on
+    } asyncInit;
+
+    // persistent startup cache (see cache.c)
+    struct {
+        char *path; // NULL if the cache is not in use
+
+        uint64_t key;
+        const uint8_t *map; // the cache file, if it exists and its key matches
+        size_t mapSize;
+
+        // entries for queries that missed the cache (pushed with a CAS, written to the file in oriTerminate())
+        _Atomic(_oriCacheEntry_t *) added;
+    } cache;
 } _oriLibrary_t;
 
 // Global state
@@ -97,33 +224,446 @@ typedef struct _oriError_t {
     const char *description;
 } _oriError_t;
 
-// Hashable Vulkan wrapper struct to hold extra data about an instance
+// A single debug subscriber registered with oriAddDebugSubscriber()
+//
+typedef struct _oriDebugSubscriber_t {
+    oriDebugCallbackfun fun;
+    void *pointer;
+
+    oriSeverityBit_t severities;
+    oriDebugCategoryBit_t categories;
+
+    unsigned int id;
+} _oriDebugSubscriber_t;
+
+// Immutable snapshot of the registered debug subscribers
+// Lists are never modified after being published: writers copy the current list, modify the copy, and swap it in with a CAS.
+// This means that dispatching a message needs no locks - readers just load the pointer and iterate over whatever they see.
+// Replaced lists are kept alive through the 'retired' chain (subscriber changes are rare) and are all freed in oriTerminate().
+//
+typedef struct _oriDebugSubscriberList_t {
+    _oriDebugSubscriberList_t *retired;
+
+    // interest[i] = bit field of severities wanted by any subscriber for the category with bit index i
+    // used to check if a message needs to be formatted at all without iterating the subscribers
+    oriSeverityBit_t interest[8];
+
+    unsigned int count;
+    _oriDebugSubscriber_t subscribers[];
+} _oriDebugSubscriberList_t;
+
+// Histogram of performance warning message IDs reported to an Orion-managed debug messenger
+// This is a fixed-size open-addressing hash table that is updated without locks from whatever thread Vulkan reports on.
+// A slot is claimed by CAS-ing its state from EMPTY to CLAIMED, after which the ID and name are written (once per distinct
+// message ID) and the state is set to READY.
+//
+typedef struct _oriPerfWarningHistogram_t {
+    struct {
+        atomic_int state; // one of the _ORI_PERF_SLOT_* values
+        int32_t id;
+        char name[ORION_PERFORMANCE_WARNING_NAME_SIZE];
+        atomic_uint_fast64_t count;
+    } slots[MAX_PERF_WARNING_IDS];
+
+    // amount of messages that were not counted because the table was full
+    atomic_uint_fast64_t dropped;
+} _oriPerfWarningHistogram_t;
+
+#define _ORI_PERF_SLOT_EMPTY 0
+#define _ORI_PERF_SLOT_CLAIMED 1
+#define _ORI_PERF_SLOT_READY 2
+
+// Structures chained into the instance pNext chain by oriInit() for a validation profile
+// They are held together so that they can be kept alive on the stack until vkCreateInstance() is called.
+//
+typedef struct _oriValidationProfileChain_t {
+    const void *next; // start of the resulting pNext chain
+
+    VkValidationFeaturesEXT features;
+    VkValidationFeatureEnableEXT enables[4];
+    VkValidationFeatureDisableEXT disables[8];
+
+#   ifdef VK_EXT_layer_settings
+        VkLayerSettingsCreateInfoEXT layerSettings;
+        VkLayerSettingEXT settings[2];
+        VkBool32 settingValue;
+#   endif
+} _oriValidationProfileChain_t;
+
+// Structures chained into the instance pNext chain by oriInit() to load a driver directly
+// (only defined if the Vulkan headers have VK_LUNARG_direct_driver_loading)
+//
+#ifdef VK_LUNARG_direct_driver_loading
+    typedef struct _oriDirectDriverChain_t {
+        VkDirectDriverLoadingInfoLUNARG driver;
+        VkDirectDriverLoadingListLUNARG list;
+    } _oriDirectDriverChain_t;
+#endif
+
+// States of an initialisation started with oriInitAsync()
+//
+typedef enum _oriAsyncInitState_t {
+    _ORI_ASYNC_INIT_NONE = 0,       // not started, or finished and joined
+    _ORI_ASYNC_INIT_RUNNING = 1,
+    _ORI_ASYNC_INIT_JOINING = 2,    // a thread is joining the initialisation thread
+} _oriAsyncInitState_t;
+
+// Copy of the parameters given to oriInitAsync(), owned by the initialisation thread until it is joined
+//
+typedef struct _oriAsyncInit_t {
+    unsigned int instanceCount;
+    VkInstance *instanceOut;
+    oriHandle_t *handlesOut;
+    VkInstanceCreateFlags instanceFlags;
+    unsigned int apiVersion;
+
+    char *applicationName;
+    unsigned int applicationVersion;
+    char *engineName;
+    unsigned int engineVersion;
+
+    char **layers;
+    unsigned int layerCount;
+    char **extensions;
+    unsigned int extensionCount;
+
+    const void *instanceNext; // not copied (the caller keeps it alive)
+
+    oriReturnStatus_t status;
+} _oriAsyncInit_t;
+
+// A single creation or destruction event recorded by the object tracker
+//
+typedef struct _oriTrackerRecord_t {
+    uint64_t handle;
+    uint64_t size;
+    const char *tag;
+    VkObjectType type;
+    int32_t delta; // 1 on creation, -1 on destruction
+} _oriTrackerRecord_t;
+
+// Fixed-size block of tracker records
+// Only the owning thread writes records; 'published' is stored with release semantics after each record is written, so readers
+// can consume everything below it without locking. Once 'next' has been set the owner never touches the chunk again.
+//
+typedef struct _oriTrackerChunk_t {
+    _Atomic(_oriTrackerChunk_t *) next;
+    atomic_uint published;
+
+    unsigned int consumed; // owned by the reader
+
+    _oriTrackerRecord_t records[TRACKER_CHUNK_SIZE];
+} _oriTrackerChunk_t;
+
+// Per-thread tracker buffer (single producer, single consumer queue of chunks)
+//
+typedef struct _oriTrackerBuffer_t {
+    _oriTrackerBuffer_t *next; // never changes after the buffer is published
+
+    _oriTrackerChunk_t *head; // owned by the reader; consumed chunks are freed from here
+    _oriTrackerChunk_t *tail; // owned by the writer
+} _oriTrackerBuffer_t;
+
+// Hashable record of an object that has been folded in from the tracker buffers
+//
+typedef struct _oriTrackedObject_t {
+    // key (both 64 bits wide so there is no padding to compare)
+    struct {
+        uint64_t handle;
+        uint64_t type;
+    } key;
+
+    uint64_t size;
+    const char *tag;
+
+    // creations minus destructions seen so far - events from different threads can be folded in out of order, so this can
+    // temporarily go negative
+    int64_t refs;
+
+    UT_hash_handle hh;
+} _oriTrackedObject_t;
+
+// Vulkan wrapper struct to hold extra data about an instance (referred to by handles of type _ORI_HANDLE_TYPE_INSTANCE)
 // There should only ever be one instance anyway, but we are doing it this way for consistency between instances and other Vulkan structures.
 // There could also be an update to Vulkan in the future which makes it more useful to have multiple instances, in which
 // case having this design makes it easier to adapt to that.
 //
 typedef struct _oriVkInstance_t {
-    UT_hash_handle hh;
-
-    VkInstance *handle; // serves as both the location of the instance handle and the hash key
+    VkInstance handle;
 
     char **layers;
     unsigned int layerCount;
     char **extensions;
     unsigned int extensionCount;
+
+    // Orion-managed debug messenger (VK_NULL_HANDLE if oriCreateDebugMessenger() was not called)
+    VkDebugUtilsMessengerEXT debugMessenger;
+    PFN_vkDestroyDebugUtilsMessengerEXT destroyDebugMessenger;
+    _oriPerfWarningHistogram_t *perfWarnings;
 } _oriVkInstance_t;
 
-// Hashable Vulkan logical device wrapper struct
+// A range of a device memory block, either free or allocated (see vk_memory.c)
+// Allocated chunks are the records of allocation handles (_ORI_HANDLE_TYPE_ALLOCATION).
 //
-typedef struct _oriVkDevice_t {
-    UT_hash_handle hh;
+typedef struct _oriMemoryChunk_t {
+    _oriMemoryBlock_t *block;
+
+    VkDeviceSize offset;
+    VkDeviceSize size;  // a multiple of MEMORY_MIN_ALLOCATION_SIZE (which may be more than was asked for), except in imported blocks
+    bool free;
+
+    // neighbouring chunks in the block, ordered by offset
+    _oriMemoryChunk_t *prevPhysical;
+    _oriMemoryChunk_t *nextPhysical;
+
+    // neighbouring chunks in the free list of the chunk's size class (free chunks only)
+    // Retired chunks are linked through nextFree in the defragmenter's list of chunks waiting to be released.
+    _oriMemoryChunk_t *prevFree;
+    _oriMemoryChunk_t *nextFree;
+
+    // allocated chunks only
+    oriHandle_t handle;
+    VkDeviceSize alignment;
+
+    // buffer owned by the allocation (see oriCreateBuffer()), or VK_NULL_HANDLE, and what is needed to recreate it
+    VkBuffer buffer;
+    VkDeviceSize bufferSize;
+    VkBufferUsageFlags bufferUsage;
+    VkBufferCreateFlags bufferFlags;
+    bool movable; // true if the defragmenter may move the allocation
+
+    // true if the defragmenter has moved the allocation elsewhere, and the chunk is only waiting for retireValue to be completed
+    bool retired;
+    uint64_t retireValue;
+
+    // evictable allocations only (evictionCallback is NULL otherwise)
+    oriEvictionCallbackfun evictionCallback;
+    void *evictionUserData;
+    uint64_t lastUse; // the manager's use counter when the allocation was last used
+} _oriMemoryChunk_t;
+
+// A single VkDeviceMemory allocation that is sub-allocated with a TLSF (two-level segregated fit) allocator
+// Free chunks are kept in lists by size class: the first level is the power of two of the size, and the second level splits
+// that into 2^MEMORY_TLSF_SL_BITS linear steps. A bit is set in the bitmaps for each non-empty list, so a list with chunks that
+// are large enough for an allocation is found with two bit scans.
+//
+typedef struct _oriMemoryBlock_t {
+    VkDeviceMemory memory;
+    VkDeviceSize size;
+    uint32_t memoryTypeIndex;
+
+    VkDeviceSize allocatedSize;
+    unsigned int allocationCount;
+
+    // true if the block is the dedicated memory of a single allocation (which is its only chunk, and is never free)
+    bool dedicated;
+
+    // true if the block is host memory imported by oriImportHostMemory() (its single chunk starts at the application's data,
+    // which may be after the start of the block, as the block is aligned to minImportedHostPointerAlignment)
+    bool imported;
+
+    unsigned char *data; // the whole block, mapped for its lifetime if its memory type is host-visible (NULL otherwise)
+
+    _oriMemoryChunk_t *firstChunk; // the chunk at offset 0
+
+    uint64_t flBitmap;
+    uint32_t slBitmaps[64];
+    _oriMemoryChunk_t *freeLists[64][1 << MEMORY_TLSF_SL_BITS];
+
+    _oriMemoryBlock_t *next; // next block of the same memory type
+} _oriMemoryBlock_t;
+
+// Amount of values of oriMemoryUsage_t
+//
+#define _ORI_MEMORY_USAGE_COUNT 5
+
+// Per-device memory manager (see vk_memory.c)
+// Everything in here is protected by 'lock'.
+//
+typedef struct _oriMemoryManager_t {
+    mtx_t lock;
+
+    VkPhysicalDeviceMemoryProperties properties;
+    VkDeviceSize blockSizes[VK_MAX_MEMORY_TYPES];   // size of new blocks of each memory type
+    _oriMemoryBlock_t *blocks[VK_MAX_MEMORY_TYPES]; // list of blocks of each memory type
+
+    // memory types suitable for each oriMemoryUsage_t, best first (built once, when the manager is initialised)
+    uint32_t usageTypes[_ORI_MEMORY_USAGE_COUNT][VK_MAX_MEMORY_TYPES];
+    unsigned int usageTypeCounts[_ORI_MEMORY_USAGE_COUNT];
+    bool resizableBar; // true if a host-visible device-local heap is large enough for more than per-frame data
+
+    unsigned int deviceMemoryCount; // amount of VkDeviceMemory objects allocated (limited by maxMemoryAllocationCount)
+
+    _oriHandleTable_t allocations;  // of _oriMemoryChunk_t
+    _oriMemoryChunk_t *spareChunks; // chunk records to reuse (linked through nextFree)
+
+    _oriMemoryChunk_t *retiredChunks; // chunks moved by the defragmenter, waiting to be released (linked through nextFree)
+    oriDefragmentStats_t defragStats;
+
+    // budget tracking (see vk_budget.c)
+    bool budgetExtension; // true if VK_EXT_memory_budget is enabled on the device
+    VkDeviceSize heapAllocated[VK_MAX_MEMORY_HEAPS]; // device memory allocated by the manager in each heap
+    VkDeviceSize heapAllocatedAtRefresh[VK_MAX_MEMORY_HEAPS];
+    VkDeviceSize heapBudget[VK_MAX_MEMORY_HEAPS];
+    VkDeviceSize heapUsageAtRefresh[VK_MAX_MEMORY_HEAPS]; // usage of the whole process, as of the last budget query
+    unsigned int refreshCountdown;
+    atomic_bool overBudget; // true if any heap is over MEMORY_BUDGET_EVICTION_THRESHOLD of its budget (may be read without the lock)
+    // usage of each heap when the budget was last enforced (a heap isn't counted as over budget again until its usage changes,
+    // as enforcing the budget again would release nothing more)
+    VkDeviceSize heapUsageAtEnforce[VK_MAX_MEMORY_HEAPS];
+
+    // evictable allocations (the counter is bumped each time one is used, to order them by use)
+    unsigned int evictableCount;
+    uint64_t useCounter;
 
-    VkDevice *handle;
+    // ranges of non-coherent memory written by the host since the last flush, rounded to nonCoherentAtomSize (see vk_mapping.c)
+    VkMappedMemoryRange *dirtyRanges;
+    unsigned int dirtyRangeCount;
+    unsigned int dirtyRangeCapacity;
+} _oriMemoryManager_t;
+
+// Position of the end of a frame's ring buffer allocations, and the value that reclaims them
+//
+typedef struct _oriRingFrame_t {
+    uint64_t value;
+    uint64_t end;
+} _oriRingFrame_t;
+
+// Persistently mapped ring buffer for transient data
+// head and tail are the total amount of bytes ever allocated and reclaimed, so head - tail is the amount in use.
+//
+typedef struct _oriRingBuffer_t {
+    mtx_t lock;
+
+    VkBuffer buffer;
+    VkDeviceMemory memory;
+    uint32_t memoryTypeIndex;
+    VkDeviceSize memorySize;
+    unsigned char *data;
+
+    VkDeviceSize size;
+    VkDeviceSize alignmentMask;
+
+    uint64_t head;
+    uint64_t tail;
+
+    _oriRingFrame_t frames[MEMORY_RING_MAX_FRAMES]; // circular queue of frames waiting to be reclaimed
+    unsigned int firstFrame;
+    unsigned int frameCount;
+} _oriRingBuffer_t;
+
+// Copy from the staging buffer of an uploader to a buffer, waiting to be submitted
+// 'order' is the order in which the copy was added, to keep sorting stable.
+//
+typedef struct _oriBufferUpload_t {
+    VkBuffer dst;
+    VkBufferCopy region;
+    unsigned int order;
+} _oriBufferUpload_t;
+
+// Copy from the staging buffer of an uploader to an image, waiting to be submitted
+//
+typedef struct _oriImageUpload_t {
+    VkImage dst;
+    VkBufferImageCopy region;
+    unsigned int order;
+} _oriImageUpload_t;
+
+// Batched staging uploads on a transfer queue
+// Submissions are numbered from 1; submission n uses command buffer (and fence) n % MEMORY_UPLOAD_MAX_SUBMISSIONS.
+//
+typedef struct _oriUploader_t {
+    mtx_t lock;
+
+    VkQueue queue;
+    VkCommandPool commandPool;
+    VkCommandBuffer commandBuffers[MEMORY_UPLOAD_MAX_SUBMISSIONS];
+    VkFence fences[MEMORY_UPLOAD_MAX_SUBMISSIONS]; // only used if there is no timeline semaphore
+    VkSemaphore timeline; // VK_NULL_HANDLE unless timeline semaphores are enabled on the device
+
+    uint64_t submittedValue;
+    uint64_t completedValue;
+
+    _oriRingBuffer_t staging; // one ring frame per submission
+
+    _oriBufferUpload_t *bufferUploads;
+    unsigned int bufferUploadCount;
+    unsigned int bufferUploadCapacity;
+
+    _oriImageUpload_t *imageUploads;
+    unsigned int imageUploadCount;
+    unsigned int imageUploadCapacity;
+} _oriUploader_t;
+
+// Vulkan logical device wrapper struct (referred to by handles of type _ORI_HANDLE_TYPE_DEVICE)
+//
+typedef struct _oriVkDevice_t {
+    VkDevice handle;
+    VkPhysicalDevice physicalDevice;
 
     char **extensions;
     unsigned int extensionCount;
+
+    // true if both the instance and the physical device have Vulkan 1.1, so that its core functions (such as
+    // vkGetPhysicalDeviceMemoryProperties2()) can be used
+    bool vulkan11;
+
+    uint32_t features; // oriDeviceFeatureBit_t flags enabled at creation
+    oriDeviceLimits_t limits;
+
+    // loaded at creation if VK_EXT_external_memory_host is enabled (NULL otherwise)
+    PFN_vkGetMemoryHostPointerPropertiesEXT getMemoryHostPointerProperties;
+
+    _oriMemoryManager_t memory;
+    _oriRingBuffer_t *ring; // NULL until oriCreateDeviceRing() is called
+    _oriUploader_t *uploader; // NULL until oriCreateDeviceUploader() is called
 } _oriVkDevice_t;
 
+// States of a format property table
+//
+typedef enum _oriFormatTableState_t {
+    _ORI_FORMAT_TABLE_EMPTY = 0,
+    _ORI_FORMAT_TABLE_FILLING = 1,
+    _ORI_FORMAT_TABLE_READY = 2,
+} _oriFormatTableState_t;
+
+// Properties of every core format on one physical device, indexed by VkFormat
+// The properties may only be read once the state is _ORI_FORMAT_TABLE_READY.
+//
+typedef struct _oriFormatTable_t {
+    VkPhysicalDevice physicalDevice;
+    atomic_int state; // _oriFormatTableState_t
+
+    // background thread filling the table, if there is one (joined in oriTerminate())
+    thrd_t thread;
+    bool threaded;
+
+    VkFormatProperties properties[FORMAT_TABLE_SIZE];
+
+    _oriFormatTable_t *next;
+} _oriFormatTable_t;
+
+// Kinds of entry in the startup cache
+//
+typedef enum _oriCacheEntryKind_t {
+    _ORI_CACHE_INSTANCE_LAYERS = 1,         // names of the available instance layers (subkey 0)
+    _ORI_CACHE_INSTANCE_EXTENSIONS = 2,     // names of the instance extensions of a layer (subkey = hash of the layer name, 0 for the implementation)
+    _ORI_CACHE_DEVICE_EXTENSIONS = 3,       // names of the device extensions of a physical device (subkey = device key ^ hash of the layer name)
+    _ORI_CACHE_FORMAT_TABLE = 4,            // VkFormatProperties of each core format of a physical device (subkey = device key)
+} _oriCacheEntryKind_t;
+
+// Startup cache entry added since the cache file was loaded
+//
+typedef struct _oriCacheEntry_t {
+    _oriCacheEntryKind_t kind;
+    uint64_t subkey;
+    uint32_t size;
+    bool duplicate; // only used while writing the file
+
+    _oriCacheEntry_t *next;
+    uint8_t data[];
+} _oriCacheEntry_t;
+
 
 #ifdef __cplusplus
     }
@@ -0,0 +1,587 @@
+/* *************************************************************************************** */
+/*                       ORION GRAPHICS LIBRARY AND RENDERING ENGINE                       */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+
+// ============================================================================ //
+// *****                     Doxygen file information                     ***** //
+// ============================================================================ //
+
+/**
+ * @file cache.c
+ * @author jack bennett
+ * @brief Persistent startup cache
+ *
+ * @copyright Copyright (c) 2022 jack bennett
+ *
+ * This file contains the optional on-disk cache of the results of the layer, extension
+ * and format queries made while initialising the library and creating devices.
+ *
+ * The cache file is mapped into memory when its path is set. It is only used if the key
+ * stored in it matches the key of the current environment, which is a hash of the loader
+ * version and of the names, sizes and modification times of every driver (ICD) and layer
+ * manifest the loader could read. Results for a physical device are further keyed by the
+ * driver version and pipeline cache UUID of the device, so a driver update invalidates them.
+ *
+ * Queries that miss the cache are added to it, and the file is rewritten in oriTerminate()
+ * if anything was added.
+ *
+ */
+
+// POSIX functions (mmap(), stat(), opendir(), ...) are used to read and write the cache file
+#define _POSIX_C_SOURCE 200809L
+
+#include "orion.h"
+#include "orion_errors.h"
+#include "orion_flags.h"
+#include "orion_funcs.h"
+#include "orion_structs.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#   define _ORI_STARTUP_CACHE_SUPPORTED
+
+#   include <dirent.h>
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+
+// ============================================================================ //
+// *****                     Private/internal systems                     ***** //
+// ============================================================================ //
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                                 Startup cache                                //
+
+#define _ORI_CACHE_MAGIC "ORICACHE"
+
+// Increment whenever the layout of the file or of any entry changes.
+//
+#define _ORI_CACHE_FORMAT_VERSION 1
+
+// Header at the start of the file, followed by entryCount entries
+//
+typedef struct _oriCacheFileHeader_t {
+    char magic[8];
+    uint32_t version;
+    uint32_t entryCount;
+    uint64_t key;
+    uint64_t size; // size of the whole file
+} _oriCacheFileHeader_t;
+
+// Header of each entry, followed by 'size' bytes of data and padding up to the next multiple of 8 bytes
+//
+typedef struct _oriCacheEntryHeader_t {
+    uint32_t kind;
+    uint32_t size;
+    uint64_t subkey;
+} _oriCacheEntryHeader_t;
+
+#define _ORI_CACHE_PADDED_SIZE(size) (((size) + 7) & ~(uint64_t) 7)
+
+// 64-bit FNV-1a
+//
+static uint64_t _oriHash(
+    uint64_t hash,
+    const void *data,
+    const size_t size
+) {
+    const uint8_t *bytes = data;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+#define _ORI_HASH_SEED 0xcbf29ce484222325ULL
+
+const uint64_t _oriHashCacheString(
+    const char *s
+) {
+    return (s) ? _oriHash(_ORI_HASH_SEED, s, strlen(s)) : 0;
+}
+
+const uint64_t _oriGetPhysicalDeviceCacheKey(
+    const VkPhysicalDevice physicalDevice
+) {
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+    uint64_t hash = _ORI_HASH_SEED;
+    hash = _oriHash(hash, &properties.vendorID, sizeof(properties.vendorID));
+    hash = _oriHash(hash, &properties.deviceID, sizeof(properties.deviceID));
+    hash = _oriHash(hash, &properties.driverVersion, sizeof(properties.driverVersion));
+    hash = _oriHash(hash, properties.pipelineCacheUUID, VK_UUID_SIZE);
+
+    return hash;
+}
+
+#ifdef _ORI_STARTUP_CACHE_SUPPORTED
+    // Hash the name, size and modification time of a file (0 if it doesn't exist).
+    //
+    static uint64_t _oriHashFileStatus(
+        const char *path
+    ) {
+        struct stat st;
+        if (stat(path, &st)) {
+            return 0;
+        }
+
+        uint64_t hash = _oriHash(_ORI_HASH_SEED, path, strlen(path));
+        hash = _oriHash(hash, &st.st_size, sizeof(st.st_size));
+        hash = _oriHash(hash, &st.st_mtime, sizeof(st.st_mtime));
+
+        return hash;
+    }
+
+    // Hash every file in a directory; the hashes of the files are summed, so the result doesn't depend on the order that
+    // readdir() returns them in.
+    //
+    static uint64_t _oriHashManifestDirectory(
+        const char *dir
+    ) {
+        DIR *d = opendir(dir);
+        if (!d) {
+            return 0;
+        }
+
+        uint64_t hash = 0;
+        for (struct dirent *entry = readdir(d); entry; entry = readdir(d)) {
+            if (entry->d_name[0] == '.') {
+                continue;
+            }
+
+            char path[PATH_MAX_LEN];
+            snprintf(path, PATH_MAX_LEN, "%s/%s", dir, entry->d_name);
+            hash += _oriHashFileStatus(path);
+        }
+
+        closedir(d);
+        return hash;
+    }
+
+    // Hash the manifest directories under a Vulkan search path root (e.g. /usr/share/vulkan).
+    //
+    static uint64_t _oriHashManifestRoot(
+        uint64_t hash,
+        const char *root
+    ) {
+        static const char *subdirs[] = { "icd.d", "implicit_layer.d", "explicit_layer.d" };
+
+        for (unsigned int i = 0; i < sizeof(subdirs) / sizeof(subdirs[0]); i++) {
+            char dir[PATH_MAX_LEN];
+            snprintf(dir, PATH_MAX_LEN, "%s/%s", root, subdirs[i]);
+
+            const uint64_t dirHash = _oriHashManifestDirectory(dir);
+            hash = _oriHash(hash, &dirHash, sizeof(dirHash));
+        }
+
+        return hash;
+    }
+
+    // Hash each element of a ':'-separated list of paths from an environment variable, along with the variable itself.
+    //
+    static uint64_t _oriHashPathList(
+        uint64_t hash,
+        const char *variable
+    ) {
+        const char *value = getenv(variable);
+        if (!value) {
+            return _oriHash(hash, "", 1);
+        }
+
+        hash = _oriHash(hash, value, strlen(value) + 1);
+
+        char list[PATH_MAX_LEN];
+        snprintf(list, PATH_MAX_LEN, "%s", value);
+
+        char *save = NULL;
+        for (char *path = strtok_r(list, ":", &save); path; path = strtok_r(NULL, ":", &save)) {
+            const uint64_t pathHash = _oriHashFileStatus(path) + _oriHashManifestDirectory(path);
+            hash = _oriHash(hash, &pathHash, sizeof(pathHash));
+        }
+
+        return hash;
+    }
+
+    // Compute the key of the current environment (see the file description).
+    //
+    static uint64_t _oriComputeCacheKey() {
+        uint64_t hash = _ORI_HASH_SEED;
+
+        const uint32_t formatVersion = _ORI_CACHE_FORMAT_VERSION;
+        hash = _oriHash(hash, &formatVersion, sizeof(formatVersion));
+
+        uint32_t loaderVersion = VK_API_VERSION_1_0;
+        vkEnumerateInstanceVersion(&loaderVersion);
+        hash = _oriHash(hash, &loaderVersion, sizeof(loaderVersion));
+
+        // the standard search paths of the loader on Linux
+        static const char *roots[] = { "/etc/vulkan", "/usr/local/etc/vulkan", "/usr/local/share/vulkan", "/usr/share/vulkan" };
+        for (unsigned int i = 0; i < sizeof(roots) / sizeof(roots[0]); i++) {
+            hash = _oriHashManifestRoot(hash, roots[i]);
+        }
+
+        // per-user search paths
+        char root[PATH_MAX_LEN];
+        const char *home = getenv("HOME");
+        const char *configHome = getenv("XDG_CONFIG_HOME");
+        const char *dataHome = getenv("XDG_DATA_HOME");
+
+        if (configHome) {
+            snprintf(root, PATH_MAX_LEN, "%s/vulkan", configHome);
+            hash = _oriHashManifestRoot(hash, root);
+        } else if (home) {
+            snprintf(root, PATH_MAX_LEN, "%s/.config/vulkan", home);
+            hash = _oriHashManifestRoot(hash, root);
+        }
+
+        if (dataHome) {
+            snprintf(root, PATH_MAX_LEN, "%s/vulkan", dataHome);
+            hash = _oriHashManifestRoot(hash, root);
+        } else if (home) {
+            snprintf(root, PATH_MAX_LEN, "%s/.local/share/vulkan", home);
+            hash = _oriHashManifestRoot(hash, root);
+        }
+
+        // environment variables that change which drivers and layers the loader finds or enables
+        static const char *variables[] = {
+            "VK_ICD_FILENAMES", "VK_DRIVER_FILES", "VK_ADD_DRIVER_FILES", "VK_LAYER_PATH", "VK_ADD_LAYER_PATH",
+            "VK_INSTANCE_LAYERS", "VK_LOADER_LAYERS_ENABLE", "VK_LOADER_LAYERS_DISABLE", "XDG_DATA_DIRS", "XDG_CONFIG_DIRS"
+        };
+        for (unsigned int i = 0; i < sizeof(variables) / sizeof(variables[0]); i++) {
+            hash = _oriHashPathList(hash, variables[i]);
+        }
+
+        return hash;
+    }
+
+    // Map the cache file and check that it matches the current environment. The cache is left empty (but usable) if it doesn't.
+    //
+    static void _oriMapStartupCache() {
+        const int fd = open(_orion.cache.path, O_RDONLY);
+        if (fd < 0) {
+#           ifdef __oridebug
+                _oriLog("startup cache '%s' does not exist yet (%s)", _orion.cache.path, __func__);
+#           endif
+
+            return;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) || (size_t) st.st_size < sizeof(_oriCacheFileHeader_t)) {
+            close(fd);
+            return;
+        }
+
+        void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (map == MAP_FAILED) {
+            return;
+        }
+
+        const _oriCacheFileHeader_t *header = map;
+        bool valid = !memcmp(header->magic, _ORI_CACHE_MAGIC, 8) &&
+            header->version == _ORI_CACHE_FORMAT_VERSION &&
+            header->key == _orion.cache.key &&
+            header->size == (uint64_t) st.st_size;
+
+        // make sure every entry is within the file, so that lookups don't need to check
+        uint64_t offset = sizeof(_oriCacheFileHeader_t);
+        for (uint32_t i = 0; valid && i < header->entryCount; i++) {
+            if (offset + sizeof(_oriCacheEntryHeader_t) > header->size) {
+                valid = false;
+                break;
+            }
+
+            const _oriCacheEntryHeader_t *entry = (const _oriCacheEntryHeader_t *) ((const uint8_t *) map + offset);
+            offset += sizeof(_oriCacheEntryHeader_t) + _ORI_CACHE_PADDED_SIZE(entry->size);
+            valid = offset <= header->size;
+        }
+
+        if (!valid) {
+#           ifdef __oridebug
+                _oriLog("startup cache '%s' is out of date and will be rebuilt (%s)", _orion.cache.path, __func__);
+#           endif
+
+            munmap(map, st.st_size);
+            return;
+        }
+
+        _orion.cache.map = map;
+        _orion.cache.mapSize = st.st_size;
+
+#       ifdef __oridebug
+            _oriLog("startup cache '%s' loaded with %u entries (%s)", _orion.cache.path, header->entryCount, __func__);
+#       endif
+    }
+
+    static bool _oriWriteAll(
+        FILE *file,
+        const void *data,
+        const size_t size
+    ) {
+        static const uint8_t padding[8] = { 0 };
+        return fwrite(data, 1, size, file) == size && fwrite(padding, 1, _ORI_CACHE_PADDED_SIZE(size) - size, file) == _ORI_CACHE_PADDED_SIZE(size) - size;
+    }
+
+    // Write the mapped entries and the added entries to a new cache file, replacing the old one.
+    //
+    static void _oriWriteStartupCache() {
+        const _oriCacheFileHeader_t *mapped = (const _oriCacheFileHeader_t *) _orion.cache.map;
+
+        // count entries and the size of the file (added entries are newest-first, so duplicates after the first are skipped)
+        _oriCacheFileHeader_t header = { 0 };
+        memcpy(header.magic, _ORI_CACHE_MAGIC, 8);
+        header.version = _ORI_CACHE_FORMAT_VERSION;
+        header.key = _orion.cache.key;
+        header.size = (mapped) ? mapped->size : sizeof(_oriCacheFileHeader_t);
+        header.entryCount = (mapped) ? mapped->entryCount : 0;
+
+        _oriCacheEntry_t *added = atomic_load(&_orion.cache.added);
+        for (_oriCacheEntry_t *cur = added; cur; cur = cur->next) {
+            cur->duplicate = false;
+            for (const _oriCacheEntry_t *prev = added; prev != cur; prev = prev->next) {
+                if (prev->kind == cur->kind && prev->subkey == cur->subkey) {
+                    cur->duplicate = true;
+                    break;
+                }
+            }
+
+            if (!cur->duplicate) {
+                header.entryCount++;
+                header.size += sizeof(_oriCacheEntryHeader_t) + _ORI_CACHE_PADDED_SIZE(cur->size);
+            }
+        }
+
+        // write to a temporary file first so that other processes never map a half-written cache
+        char tmpPath[PATH_MAX_LEN];
+        snprintf(tmpPath, PATH_MAX_LEN, "%s.%ld.tmp", _orion.cache.path, (long) getpid());
+
+        FILE *file = fopen(tmpPath, "wb");
+        if (!file) {
+            _oriWarning("failed to open '%s' to write startup cache (%s)", tmpPath, __func__);
+            return;
+        }
+
+        bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+
+        if (ok && mapped) {
+            ok = fwrite((const uint8_t *) mapped + sizeof(_oriCacheFileHeader_t), 1, mapped->size - sizeof(_oriCacheFileHeader_t), file) ==
+                mapped->size - sizeof(_oriCacheFileHeader_t);
+        }
+
+        for (const _oriCacheEntry_t *cur = added; ok && cur; cur = cur->next) {
+            if (cur->duplicate) {
+                continue;
+            }
+
+            const _oriCacheEntryHeader_t entry = { .kind = cur->kind, .size = cur->size, .subkey = cur->subkey };
+            ok = fwrite(&entry, sizeof(entry), 1, file) == 1 && _oriWriteAll(file, cur->data, cur->size);
+        }
+
+        ok = !fclose(file) && ok;
+
+        if (!ok || rename(tmpPath, _orion.cache.path)) {
+            _oriWarning("failed to write startup cache '%s' (%s)", _orion.cache.path, __func__);
+            remove(tmpPath);
+            return;
+        }
+
+#       ifdef __oridebug
+            _oriLog("startup cache '%s' written with %u entries (%s)", _orion.cache.path, header.entryCount, __func__);
+#       endif
+    }
+#endif
+
+const void *_oriFindCacheEntry(
+    const _oriCacheEntryKind_t kind,
+    const uint64_t subkey,
+    uint32_t *sizeOut
+) {
+    if (!_orion.cache.path) {
+        return NULL;
+    }
+
+    // entries in the file
+    if (_orion.cache.map) {
+        const _oriCacheFileHeader_t *header = (const _oriCacheFileHeader_t *) _orion.cache.map;
+        const uint8_t *cur = _orion.cache.map + sizeof(_oriCacheFileHeader_t);
+
+        for (uint32_t i = 0; i < header->entryCount; i++) {
+            const _oriCacheEntryHeader_t *entry = (const _oriCacheEntryHeader_t *) cur;
+            if (entry->kind == (uint32_t) kind && entry->subkey == subkey) {
+                *sizeOut = entry->size;
+                return entry + 1;
+            }
+
+            cur += sizeof(_oriCacheEntryHeader_t) + _ORI_CACHE_PADDED_SIZE(entry->size);
+        }
+    }
+
+    // entries added since (this list is only ever pushed to, so it can be walked without a lock)
+    for (const _oriCacheEntry_t *cur = atomic_load_explicit(&_orion.cache.added, memory_order_acquire); cur; cur = cur->next) {
+        if (cur->kind == kind && cur->subkey == subkey) {
+            *sizeOut = cur->size;
+            return cur->data;
+        }
+    }
+
+    return NULL;
+}
+
+void _oriStoreCacheEntry(
+    const _oriCacheEntryKind_t kind,
+    const uint64_t subkey,
+    const void *data,
+    const uint32_t size
+) {
+    if (!_orion.cache.path) {
+        return;
+    }
+
+    _oriCacheEntry_t *entry = malloc(sizeof(_oriCacheEntry_t) + size);
+    if (!entry) {
+        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+        return;
+    }
+    entry->kind = kind;
+    entry->subkey = subkey;
+    entry->size = size;
+    memcpy(entry->data, data, size);
+
+    entry->next = atomic_load_explicit(&_orion.cache.added, memory_order_relaxed);
+    while (!atomic_compare_exchange_weak_explicit(&_orion.cache.added, &entry->next, entry, memory_order_release, memory_order_relaxed));
+}
+
+const bool _oriFindCachedName(
+    const _oriCacheEntryKind_t kind,
+    const uint64_t subkey,
+    const char *name,
+    bool *foundOut
+) {
+    uint32_t size;
+    const char *names = _oriFindCacheEntry(kind, subkey, &size);
+    if (!names) {
+        return false;
+    }
+
+    *foundOut = false;
+    for (uint32_t i = 0; i < size / VK_MAX_EXTENSION_NAME_SIZE; i++) {
+        if (!strncmp(&names[i * VK_MAX_EXTENSION_NAME_SIZE], name, VK_MAX_EXTENSION_NAME_SIZE)) {
+            *foundOut = true;
+            break;
+        }
+    }
+
+    return true;
+}
+
+void _oriStoreCachedNames(
+    const _oriCacheEntryKind_t kind,
+    const uint64_t subkey,
+    const unsigned int count,
+    const void *properties,
+    const size_t stride
+) {
+    if (!_orion.cache.path) {
+        return;
+    }
+
+    // names are stored in fixed-size slots (the name is the first member of both VkLayerProperties and VkExtensionProperties)
+    char names[(count ? count : 1) * VK_MAX_EXTENSION_NAME_SIZE];
+    for (unsigned int i = 0; i < count; i++) {
+        memcpy(&names[i * VK_MAX_EXTENSION_NAME_SIZE], (const char *) properties + i * stride, VK_MAX_EXTENSION_NAME_SIZE);
+    }
+
+    _oriStoreCacheEntry(kind, subkey, names, count * VK_MAX_EXTENSION_NAME_SIZE);
+}
+
+void _oriCloseStartupCache() {
+    if (!_orion.cache.path) {
+        return;
+    }
+
+#   ifdef _ORI_STARTUP_CACHE_SUPPORTED
+        if (atomic_load(&_orion.cache.added)) {
+            _oriWriteStartupCache();
+        }
+
+        if (_orion.cache.map) {
+            munmap((void *) _orion.cache.map, _orion.cache.mapSize);
+        }
+#   endif
+
+    _oriCacheEntry_t *cur = atomic_exchange(&_orion.cache.added, NULL);
+    while (cur) {
+        _oriCacheEntry_t *next = cur->next;
+        free(cur);
+        cur = next;
+    }
+
+    free(_orion.cache.path);
+    _orion.cache.path = NULL;
+    _orion.cache.map = NULL;
+    _orion.cache.mapSize = 0;
+}
+
+
+// ============================================================================ //
+// *****                   Orion library public interface                 ***** //
+// ============================================================================ //
+
+
+// ----[Orion library public interface]---------------------------------------- //
+//                             Library management                               //
+
+const oriReturnStatus_t oriSetStartupCachePath(
+    const char *path
+) {
+    _oriAwaitInit();
+
+    if (_orion.initialised) {
+        _oriWarning("startup cache path must be set before oriInit() (%s)", __func__);
+        return ORION_RETURN_STATUS_SKIPPED;
+    }
+
+    // close any cache that was already open (writing it if anything was added to it)
+    _oriCloseStartupCache();
+
+    if (!path) {
+        return ORION_RETURN_STATUS_OK;
+    }
+
+#   ifdef _ORI_STARTUP_CACHE_SUPPORTED
+        _orion.cache.path = malloc(strlen(path) + 1);
+        if (!_orion.cache.path) {
+            _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+            return ORION_RETURN_STATUS_ERROR;
+        }
+        strcpy(_orion.cache.path, path);
+
+        _orion.cache.key = _oriComputeCacheKey();
+        _oriMapStartupCache();
+
+        return ORION_RETURN_STATUS_OK;
+#   else
+        _oriWarning("the startup cache is not supported on this platform (%s)", __func__);
+        return ORION_RETURN_STATUS_SKIPPED;
+#   endif
+}
@@ -89,3 +89,44 @@ void _oriDefaultDebugCallback(
             break;
     }
 }
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                          Vulkan debug messengers                             //
+
+VKAPI_ATTR VkBool32 VKAPI_CALL _oriVulkanDebugMessengerCallback(
+    VkDebugUtilsMessageSeverityFlagBitsEXT severity,
+    VkDebugUtilsMessageTypeFlagsEXT types,
+    const VkDebugUtilsMessengerCallbackDataEXT *callbackData,
+    void *pUserData
+) {
+    // this can be called from any thread that is making Vulkan calls, so no strings are built here: the message
+    // from Vulkan is forwarded as-is, and only if something is going to recieve it.
+
+    oriDebugCategoryBit_t category = ORION_DEBUG_CATEGORY_VULKAN_BIT;
+
+    if (types & VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT) {
+        category = ORION_DEBUG_CATEGORY_PERFORMANCE_BIT;
+        _oriRecordPerformanceWarning((_oriPerfWarningHistogram_t *) pUserData, callbackData->messageIdNumber, callbackData->pMessageIdName);
+    }
+
+    oriSeverityBit_t sev;
+    if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT) {
+        sev = ORION_DEBUG_SEVERITY_ERROR_BIT;
+    } else if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT) {
+        sev = ORION_DEBUG_SEVERITY_WARNING_BIT;
+    } else if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT) {
+        sev = ORION_DEBUG_SEVERITY_NOTIF_BIT;
+    } else {
+        sev = ORION_DEBUG_SEVERITY_VERBOSE_BIT;
+    }
+
+    // errors are always sent to the global debug callback, as with Orion errors
+    if (sev != ORION_DEBUG_SEVERITY_ERROR_BIT && !_oriCheckDebugInterest(sev, category)) {
+        return VK_FALSE;
+    }
+
+    _oriDispatchDebugMessage("VULKAN_DEBUG_MESSENGER", 0xA1, callbackData->pMessage, sev, category);
+
+    return VK_FALSE;
+}
@@ -32,10 +32,13 @@
 #include "orion.h"
 #include "orion_funcs.h"
 #include "orion_errors.h"
+#include "orion_flags.h"
 
+#include <inttypes.h>
 #include <stdio.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#include <string.h>
 
 
 // ============================================================================ //
@@ -84,6 +87,64 @@ const _oriError_t _oriParseError(
                 .name = "ERR_DEVICE_CREATION_FAIL",
                 .description = "Vulkan failed to create logical device"
             };
+        case ORIERR_EXTENSION_NOT_ENABLED:
+            return (_oriError_t) {
+                .name = "ERR_EXTENSION_NOT_ENABLED",
+                .description = "a required Vulkan extension was not enabled"
+            };
+        case ORIERR_OBJECT_CREATION_FAIL:
+            return (_oriError_t) {
+                .name = "ERR_OBJECT_CREATION_FAIL",
+                .description = "Vulkan failed to create object"
+            };
+        case ORIERR_STALE_HANDLE:
+            return (_oriError_t) {
+                .name = "ERR_STALE_HANDLE",
+                .description = "handle refers to an object that has already been destroyed"
+            };
+        case ORIERR_QUEUE_ROLE_UNSATISFIED:
+            return (_oriError_t) {
+                .name = "ERR_QUEUE_ROLE_UNSATISFIED",
+                .description = "no queue family can fulfil a required queue role"
+            };
+        case ORIERR_DRIVER_LOAD_FAIL:
+            return (_oriError_t) {
+                .name = "ERR_DRIVER_LOAD_FAIL",
+                .description = "failed to load a Vulkan driver library"
+            };
+        case ORIERR_NO_SUITABLE_MEMORY_TYPE:
+            return (_oriError_t) {
+                .name = "ERR_NO_SUITABLE_MEMORY_TYPE",
+                .description = "no memory type satisfies the requirements of an allocation"
+            };
+        case ORIERR_MEMORY_ALLOCATION_FAIL:
+            return (_oriError_t) {
+                .name = "ERR_MEMORY_ALLOCATION_FAIL",
+                .description = "failed to allocate device memory"
+            };
+        case ORIERR_RING_BUFFER_FULL:
+            return (_oriError_t) {
+                .name = "ERR_RING_BUFFER_FULL",
+                .description = "not enough space left in ring buffer"
+            };
+
+        case ORIERR_INVALID_MAPPED_RANGE:
+            return (_oriError_t) {
+                .name = "ERR_INVALID_MAPPED_RANGE",
+                .description = "range is outside of allocation, or allocation is not in host-visible memory"
+            };
+
+        case ORIERR_OFFSET_OUT_OF_RANGE:
+            return (_oriError_t) {
+                .name = "ERR_OFFSET_OUT_OF_RANGE",
+                .description = "resource does not fit in allocation at offset, or offset is misaligned"
+            };
+
+        case ORIERR_UNSUPPORTED_VERSION:
+            return (_oriError_t) {
+                .name = "ERR_UNSUPPORTED_VERSION",
+                .description = "function needs a later Vulkan version than that of the instance or device"
+            };
 
         case ORIFERR_MEMORY_ERROR:
             return (_oriError_t) {
@@ -94,6 +155,149 @@ const _oriError_t _oriParseError(
 }
 
 
+// ----[Private/internal systems]---------------------------------------------- //
+//                         Debug message dispatching                            //
+
+// Convert a category bit into an index into _oriDebugSubscriberList_t::interest.
+// If more than one bit is set, the lowest one is used.
+//
+static unsigned int _oriDebugCategoryIndex(
+    const oriDebugCategoryBit_t category
+) {
+    unsigned int i = 0;
+    while (i < 7 && !((category >> i) & 1)) {
+        i++;
+    }
+
+    return i;
+}
+
+const bool _oriCheckDebugInterest(
+    const oriSeverityBit_t severity,
+    const oriDebugCategoryBit_t category
+) {
+    // the global callback only filters by severity
+    if ((_orion.debugMessageSeverities & severity) == severity) {
+        return true;
+    }
+
+    _oriDebugSubscriberList_t *list = atomic_load_explicit(&_orion.callbacks.debug.subscribers, memory_order_acquire);
+    return list && (list->interest[_oriDebugCategoryIndex(category)] & severity);
+}
+
+void _oriDispatchDebugMessage(
+    const char *name,
+    const unsigned int code,
+    const char *message,
+    const oriSeverityBit_t severity,
+    const oriDebugCategoryBit_t category
+) {
+    // the global callback will always recieve errors and fatal errors
+    if ((severity & (ORION_DEBUG_SEVERITY_ERROR_BIT | ORION_DEBUG_SEVERITY_FATAL_BIT)) || (_orion.debugMessageSeverities & severity) == severity) {
+        _orion.callbacks.debug.fun(name, code, message, severity, _orion.callbacks.debug.pointer);
+    }
+
+    // the list that is loaded here will not be modified or freed until oriTerminate(), even if subscribers are
+    // added or removed on another thread in the meantime
+    _oriDebugSubscriberList_t *list = atomic_load_explicit(&_orion.callbacks.debug.subscribers, memory_order_acquire);
+    if (!list) {
+        return;
+    }
+
+    for (unsigned int i = 0; i < list->count; i++) {
+        const _oriDebugSubscriber_t *sub = &list->subscribers[i];
+
+        if ((sub->severities & severity) && (sub->categories & category)) {
+            sub->fun(name, code, message, severity, sub->pointer);
+        }
+    }
+}
+
+void _oriFreeDebugSubscribers() {
+    _oriDebugSubscriberList_t *list = atomic_exchange(&_orion.callbacks.debug.subscribers, NULL);
+
+    // walk the chain of retired lists
+    while (list) {
+        _oriDebugSubscriberList_t *next = list->retired;
+        free(list);
+        list = next;
+    }
+}
+
+void _oriRecordPerformanceWarning(
+    _oriPerfWarningHistogram_t *histogram,
+    const int32_t id,
+    const char *name
+) {
+    // fibonacci hashing of the message ID; linear probing from there
+    unsigned int slot = ((uint32_t) id * 2654435769u) & (MAX_PERF_WARNING_IDS - 1);
+
+    for (unsigned int probe = 0; probe < MAX_PERF_WARNING_IDS; probe++, slot = (slot + 1) & (MAX_PERF_WARNING_IDS - 1)) {
+        int state = atomic_load_explicit(&histogram->slots[slot].state, memory_order_acquire);
+
+        if (state == _ORI_PERF_SLOT_EMPTY) {
+            // try to claim the slot for this ID
+            if (atomic_compare_exchange_strong(&histogram->slots[slot].state, &state, _ORI_PERF_SLOT_CLAIMED)) {
+                histogram->slots[slot].id = id;
+                strncpy(histogram->slots[slot].name, (name) ? name : "", ORION_PERFORMANCE_WARNING_NAME_SIZE - 1);
+
+                atomic_fetch_add_explicit(&histogram->slots[slot].count, 1, memory_order_relaxed);
+                atomic_store_explicit(&histogram->slots[slot].state, _ORI_PERF_SLOT_READY, memory_order_release);
+                return;
+            }
+
+            // another thread claimed the slot first - 'state' now holds its current state
+        }
+
+        // another thread is writing the ID into this slot, it won't take long
+        while (state == _ORI_PERF_SLOT_CLAIMED) {
+            state = atomic_load_explicit(&histogram->slots[slot].state, memory_order_acquire);
+        }
+
+        if (histogram->slots[slot].id == id) {
+            atomic_fetch_add_explicit(&histogram->slots[slot].count, 1, memory_order_relaxed);
+            return;
+        }
+    }
+
+    // table is full
+    atomic_fetch_add_explicit(&histogram->dropped, 1, memory_order_relaxed);
+}
+
+// Allocate a replacement for 'old' with space for 'count' subscribers, and chain 'old' to it as retired.
+// The subscribers are copied in by the caller, and the interest table is not computed here (see _oriRecalculateDebugInterest()).
+//
+static _oriDebugSubscriberList_t *_oriCopyDebugSubscriberList(
+    const _oriDebugSubscriberList_t *old,
+    const unsigned int count
+) {
+    _oriDebugSubscriberList_t *list = malloc(sizeof(_oriDebugSubscriberList_t) + count * sizeof(_oriDebugSubscriber_t));
+    if (!list) {
+        return NULL;
+    }
+    memset(list, 0, sizeof(_oriDebugSubscriberList_t));
+
+    list->retired = (_oriDebugSubscriberList_t *) old;
+    list->count = count;
+
+    return list;
+}
+
+static void _oriRecalculateDebugInterest(
+    _oriDebugSubscriberList_t *list
+) {
+    memset(list->interest, 0, sizeof(list->interest));
+
+    for (unsigned int i = 0; i < list->count; i++) {
+        for (unsigned int c = 0; c < 8; c++) {
+            if ((list->subscribers[i].categories >> c) & 1) {
+                list->interest[c] |= list->subscribers[i].severities;
+            }
+        }
+    }
+}
+
+
 // ----[Private/internal systems]---------------------------------------------- //
 //                        Error-throwing helper functions                       //
 
@@ -112,7 +316,7 @@ const _oriError_t _oriParseError(
  \
     va_end(varargs); \
  \
-    _orion.callbacks.debug.fun("", 0x0, msg, sev, _orion.callbacks.debug.pointer); \
+    _oriDispatchDebugMessage("", 0x0, msg, sev, ORION_DEBUG_CATEGORY_GENERAL_BIT); \
 }
 
 // another macro, same reason as above but for _ori(Error|FatalError).
@@ -126,15 +330,15 @@ const _oriError_t _oriParseError(
     char msg[MAX_ERRORMSG_LEN]; \
     snprintf(msg, MAX_ERRORMSG_LEN, "%s%s%s%s", err.description, (extra) ? " (" : "", (extra) ? extra : "", (extra) ? ")" : ""); \
  \
-    _orion.callbacks.debug.fun(err.name, id, msg, sev, _orion.callbacks.debug.pointer); \
+    _oriDispatchDebugMessage(err.name, id, msg, sev, ORION_DEBUG_CATEGORY_GENERAL_BIT); \
 }
 
-// another macro to check if the specified severity is allowed to be displayed
-// if sev is not to be shown, then the parent function returns
+// another macro to check if the specified severity is allowed to be displayed by the callback or any subscriber
+// if sev is not to be shown, then the parent function returns (before the message is formatted)
 //
 #define DBGCB_VERIFY_SEV(sev) \
 { \
-    if ((_orion.debugMessageSeverities & sev) != sev) { \
+    if (!_oriCheckDebugInterest(sev, ORION_DEBUG_CATEGORY_GENERAL_BIT)) { \
         return; \
     } \
 }
@@ -233,6 +437,320 @@ const void *oriGetDebugCallbackUserData() {
     return _orion.callbacks.debug.pointer;
 }
 
+const oriReturnStatus_t oriAddDebugSubscriber(
+    const oriDebugCallbackfun callback,
+    const oriSeverityBit_t severities,
+    const oriDebugCategoryBit_t categories,
+    void *pointer,
+    unsigned int *idOut
+) {
+    if (_ORI_CONTRACT_BROKEN(!callback)) { // callback is NULL
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    const unsigned int id = atomic_fetch_add(&_orion.callbacks.debug.nextSubscriberID, 1) + 1; // IDs start at 1
+
+    // copy-on-write: retry until no other thread has replaced the list between our load and our swap
+    _oriDebugSubscriberList_t *old = atomic_load(&_orion.callbacks.debug.subscribers);
+    _oriDebugSubscriberList_t *list;
+    do {
+        const unsigned int oldCount = (old) ? old->count : 0;
+
+        list = _oriCopyDebugSubscriberList(old, oldCount + 1);
+        if (!list) {
+            _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+            return ORION_RETURN_STATUS_ERROR;
+        }
+
+        if (oldCount) {
+            memcpy(list->subscribers, old->subscribers, oldCount * sizeof(_oriDebugSubscriber_t));
+        }
+        list->subscribers[oldCount] = (_oriDebugSubscriber_t) {
+            .fun = callback,
+            .pointer = pointer,
+            .severities = severities,
+            .categories = categories,
+            .id = id
+        };
+
+        _oriRecalculateDebugInterest(list);
+
+        if (atomic_compare_exchange_weak(&_orion.callbacks.debug.subscribers, &old, list)) {
+            break;
+        }
+
+        // 'old' has been reloaded by the failed CAS
+        free(list);
+    } while (true);
+
+#   ifdef __oridebug
+        _oriLog("debug subscriber %u added (severities: bit field 0x%02X, categories: bit field 0x%02X) (%s)", id, severities, categories, __func__);
+#   endif
+
+    if (idOut) {
+        *idOut = id;
+    }
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+const oriReturnStatus_t oriRemoveDebugSubscriber(
+    const unsigned int id
+) {
+    _oriDebugSubscriberList_t *old = atomic_load(&_orion.callbacks.debug.subscribers);
+    _oriDebugSubscriberList_t *list;
+    do {
+        // find the subscriber in the current list
+        unsigned int index = 0;
+        while (old && index < old->count && old->subscribers[index].id != id) {
+            index++;
+        }
+
+        if (!old || index == old->count) {
+#           ifdef __oridebug
+                _oriWarning("no debug subscriber with ID %u (%s)", id, __func__);
+#           endif
+
+            return ORION_RETURN_STATUS_SKIPPED;
+        }
+
+        list = _oriCopyDebugSubscriberList(old, old->count - 1);
+        if (!list) {
+            _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+            return ORION_RETURN_STATUS_ERROR;
+        }
+
+        // copy every subscriber except the removed one
+        memcpy(list->subscribers, old->subscribers, index * sizeof(_oriDebugSubscriber_t));
+        memcpy(&list->subscribers[index], &old->subscribers[index + 1], (old->count - index - 1) * sizeof(_oriDebugSubscriber_t));
+
+        _oriRecalculateDebugInterest(list);
+
+        if (atomic_compare_exchange_weak(&_orion.callbacks.debug.subscribers, &old, list)) {
+            break;
+        }
+
+        free(list);
+    } while (true);
+
+#   ifdef __oridebug
+        _oriLog("debug subscriber %u removed (%s)", id, __func__);
+#   endif
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+// Comparison function to sort performance warnings by descending count (and by ID for a stable order).
+//
+static int _oriComparePerformanceWarnings(
+    const void *a,
+    const void *b
+) {
+    const oriPerformanceWarning_t *wa = a;
+    const oriPerformanceWarning_t *wb = b;
+
+    if (wa->count != wb->count) {
+        return (wa->count < wb->count) ? 1 : -1;
+    }
+
+    return (wa->messageID > wb->messageID) - (wa->messageID < wb->messageID);
+}
+
+// Take a sorted snapshot of the performance warning histogram of an instance.
+// Returns the amount of entries written to 'out', which must have space for MAX_PERF_WARNING_IDS entries.
+//
+static unsigned int _oriSnapshotPerformanceWarnings(
+    _oriPerfWarningHistogram_t *histogram,
+    oriPerformanceWarning_t *out
+) {
+    unsigned int count = 0;
+
+    for (unsigned int i = 0; i < MAX_PERF_WARNING_IDS; i++) {
+        if (atomic_load_explicit(&histogram->slots[i].state, memory_order_acquire) != _ORI_PERF_SLOT_READY) {
+            continue;
+        }
+
+        out[count].messageID = histogram->slots[i].id;
+        strncpy(out[count].messageName, histogram->slots[i].name, ORION_PERFORMANCE_WARNING_NAME_SIZE);
+        out[count].count = atomic_load_explicit(&histogram->slots[i].count, memory_order_relaxed);
+        count++;
+    }
+
+    qsort(out, count, sizeof(oriPerformanceWarning_t), _oriComparePerformanceWarnings);
+
+    return count;
+}
+
+// Find the wrapper of an instance that has an Orion-managed debug messenger.
+// Sends an error and returns NULL if there is none.
+//
+static _oriVkInstance_t *_oriFindMessengerInstance(
+    const oriHandle_t instance,
+    const char *func
+) {
+    _oriVkInstance_t *instanceWrapper = _oriGetInstance(instance, func);
+    if (!instanceWrapper) {
+        return NULL;
+    }
+
+    // the instance exists but has no messenger
+    if (!instanceWrapper->perfWarnings) {
+        _oriError(ORIERR_INVALID_OBJECT, func);
+        return NULL;
+    }
+
+    return instanceWrapper;
+}
+
+const oriReturnStatus_t oriCreateDebugMessenger(
+    const oriHandle_t instance,
+    const VkDebugUtilsMessageSeverityFlagsEXT severities,
+    const VkDebugUtilsMessageTypeFlagsEXT types
+) {
+    if (_ORI_CONTRACT_BROKEN(!instance)) { // instance is NULL
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    _oriVkInstance_t *instanceWrapper = _oriGetInstance(instance, __func__);
+    if (!instanceWrapper) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+    if (instanceWrapper->debugMessenger) {
+        _oriWarning("orion already created debug messenger for instance 0x%08X (%s)", instance, __func__);
+        return ORION_RETURN_STATUS_SKIPPED;
+    }
+    if (!oriCheckInstanceExtensionEnabled(instance, VK_EXT_DEBUG_UTILS_EXTENSION_NAME)) {
+        _oriError(ORIERR_EXTENSION_NOT_ENABLED, VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    // load the extension functions
+    PFN_vkCreateDebugUtilsMessengerEXT createDebugMessenger =
+        (PFN_vkCreateDebugUtilsMessengerEXT) vkGetInstanceProcAddr(instanceWrapper->handle, "vkCreateDebugUtilsMessengerEXT");
+    PFN_vkDestroyDebugUtilsMessengerEXT destroyDebugMessenger =
+        (PFN_vkDestroyDebugUtilsMessengerEXT) vkGetInstanceProcAddr(instanceWrapper->handle, "vkDestroyDebugUtilsMessengerEXT");
+
+    if (!createDebugMessenger || !destroyDebugMessenger) {
+        _oriError(ORIERR_VULKAN_QUERY_FAIL, __func__);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    // the histogram is passed to the callback as its user data
+    _oriPerfWarningHistogram_t *histogram = calloc(1, sizeof(_oriPerfWarningHistogram_t));
+    if (!histogram) {
+        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    VkDebugUtilsMessengerCreateInfoEXT createInfo = {
+        .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT,
+        .pNext = NULL,
+        .flags = 0,
+        .messageSeverity = severities,
+        .messageType = types,
+        .pfnUserCallback = _oriVulkanDebugMessengerCallback,
+        .pUserData = histogram
+    };
+
+    if (createDebugMessenger(instanceWrapper->handle, &createInfo, _orion.callbacks.vulkanAllocators, &instanceWrapper->debugMessenger)) {
+        free(histogram);
+        histogram = NULL;
+
+        _oriError(ORIERR_OBJECT_CREATION_FAIL, __func__);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    instanceWrapper->destroyDebugMessenger = destroyDebugMessenger;
+    instanceWrapper->perfWarnings = histogram;
+
+    _oriTrackObjectCreation(VK_OBJECT_TYPE_DEBUG_UTILS_MESSENGER_EXT, _ORI_NON_DISPATCHABLE_HANDLE_U64(instanceWrapper->debugMessenger), sizeof(_oriPerfWarningHistogram_t));
+
+#   ifdef __oridebug
+        _oriLog("debug messenger created for instance 0x%08X (severities: bit field 0x%04X, types: bit field 0x%02X) (%s)", instance, severities, types, __func__);
+#   endif
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+const oriReturnStatus_t oriEnumeratePerformanceWarnings(
+    const oriHandle_t instance,
+    const unsigned int maxCount,
+    unsigned int *countOut,
+    oriPerformanceWarning_t *warningsOut
+) {
+    if (_ORI_CONTRACT_BROKEN(!instance)) { // instance is NULL
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+    if (!countOut && !warningsOut) { // both countOut and warningsOut are NULL
+        _oriWarning("all output variables NULL in call to %s", __func__);
+        return ORION_RETURN_STATUS_NO_OUTPUT;
+    }
+
+    _oriVkInstance_t *instanceWrapper = _oriFindMessengerInstance(instance, __func__);
+    if (!instanceWrapper) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    oriPerformanceWarning_t snapshot[MAX_PERF_WARNING_IDS];
+    unsigned int count = _oriSnapshotPerformanceWarnings(instanceWrapper->perfWarnings, snapshot);
+
+    if (warningsOut) {
+        if (count > maxCount) {
+            count = maxCount;
+        }
+
+        memcpy(warningsOut, snapshot, count * sizeof(oriPerformanceWarning_t));
+    }
+
+    if (countOut) {
+        *countOut = count;
+    }
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+const oriReturnStatus_t oriDumpPerformanceWarnings(
+    const oriHandle_t instance,
+    const unsigned int maxCount
+) {
+    if (_ORI_CONTRACT_BROKEN(!instance)) { // instance is NULL
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    _oriVkInstance_t *instanceWrapper = _oriFindMessengerInstance(instance, __func__);
+    if (!instanceWrapper) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    // nothing to do if the report would not be recieved
+    if (!_oriCheckDebugInterest(ORION_DEBUG_SEVERITY_NOTIF_BIT, ORION_DEBUG_CATEGORY_PERFORMANCE_BIT)) {
+        return ORION_RETURN_STATUS_OK;
+    }
+
+    oriPerformanceWarning_t snapshot[MAX_PERF_WARNING_IDS];
+    const unsigned int count = _oriSnapshotPerformanceWarnings(instanceWrapper->perfWarnings, snapshot);
+
+    char report[MAX_LOG_LEN];
+    int len = snprintf(report, MAX_LOG_LEN, "%u distinct performance warnings reported for instance 0x%08X", count, instance);
+
+    for (unsigned int i = 0; i < count && i < maxCount && len > 0 && len < MAX_LOG_LEN; i++) {
+        len += snprintf(report + len, MAX_LOG_LEN - len, "\n\t[%u] %" PRIu64 "x '%s' (ID 0x%08X)", i, snapshot[i].count, snapshot[i].messageName, (uint32_t) snapshot[i].messageID);
+    }
+
+    const uint64_t dropped = atomic_load(&instanceWrapper->perfWarnings->dropped);
+    if (dropped && len > 0 && len < MAX_LOG_LEN) {
+        snprintf(report + len, MAX_LOG_LEN - len, "\n\t(%" PRIu64 " further messages were not counted)", dropped);
+    }
+
+    _oriDispatchDebugMessage("", 0x0, report, ORION_DEBUG_SEVERITY_NOTIF_BIT, ORION_DEBUG_CATEGORY_PERFORMANCE_BIT);
+
+    return ORION_RETURN_STATUS_OK;
+}
+
 const char *oriStringifyReturnStatus(
     const oriReturnStatus_t status
 ) {
@@ -0,0 +1,224 @@
+/* *************************************************************************************** */
+/*                       ORION GRAPHICS LIBRARY AND RENDERING ENGINE                       */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+
+// ============================================================================ //
+// *****                     Doxygen file information                     ***** //
+// ============================================================================ //
+
+/**
+ * @file handle.c
+ * @author jack bennett
+ * @brief Generational handle tables
+ *
+ * @copyright Copyright (c) 2022 jack bennett
+ *
+ * This file contains the tables that map Orion handles (oriHandle_t) to the
+ * library-owned records of the objects they refer to.
+ *
+ * A handle is made up of a slot index, the generation of that slot when the handle
+ * was created, and the type of object (see HANDLE_*_BITS in orion_flags.h). Looking
+ * up a handle is just an index and a generation check, and since the generation of
+ * a slot is incremented whenever it is released, stale handles are caught as well.
+ *
+ */
+
+#include "orion.h"
+#include "orion_funcs.h"
+#include "orion_errors.h"
+#include "orion_flags.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+// ============================================================================ //
+// *****                     Private/internal systems                     ***** //
+// ============================================================================ //
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                              Generational handles                            //
+
+#define _ORI_HANDLE_INDEX_MASK ((1u << HANDLE_INDEX_BITS) - 1)
+#define _ORI_HANDLE_GENERATION_MASK ((1u << HANDLE_GENERATION_BITS) - 1)
+
+#define _ORI_HANDLE_INDEX(handle) ((handle) & _ORI_HANDLE_INDEX_MASK)
+#define _ORI_HANDLE_GENERATION(handle) (((handle) >> HANDLE_INDEX_BITS) & _ORI_HANDLE_GENERATION_MASK)
+#define _ORI_HANDLE_TYPE(handle) ((handle) >> (HANDLE_INDEX_BITS + HANDLE_GENERATION_BITS))
+
+// Grow the arrays of a handle table, returning false if it is already at the maximum size.
+//
+static bool _oriGrowHandleTable(
+    _oriHandleTable_t *table
+) {
+    const unsigned int maxCapacity = _ORI_HANDLE_INDEX_MASK + 1;
+    if (table->capacity == maxCapacity) {
+        return false;
+    }
+
+    unsigned int capacity = (table->capacity) ? table->capacity * 2 : HANDLE_TABLE_INITIAL_CAPACITY;
+    if (capacity > maxCapacity) {
+        capacity = maxCapacity;
+    }
+
+    uint16_t *generations = realloc(table->generations, capacity * sizeof(uint16_t));
+    void **records = realloc(table->records, capacity * sizeof(void *));
+    uint16_t *freeSlots = realloc(table->freeSlots, capacity * sizeof(uint16_t));
+    if (!generations || !records || !freeSlots) {
+        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+        return false;
+    }
+
+    // new slots start at generation 0
+    memset(generations + table->capacity, 0, (capacity - table->capacity) * sizeof(uint16_t));
+    memset(records + table->capacity, 0, (capacity - table->capacity) * sizeof(void *));
+
+    table->generations = generations;
+    table->records = records;
+    table->freeSlots = freeSlots;
+    table->capacity = capacity;
+
+    return true;
+}
+
+const oriHandle_t _oriCreateHandle(
+    _oriHandleTable_t *table,
+    const _oriHandleType_t type,
+    void *record
+) {
+    unsigned int slot;
+
+    if (table->freeCount) {
+        slot = table->freeSlots[--table->freeCount];
+    } else {
+        if (table->used == table->capacity && !_oriGrowHandleTable(table)) {
+            return ORION_NULL_HANDLE;
+        }
+
+        slot = table->used++;
+    }
+
+    table->records[slot] = record;
+
+    return ((oriHandle_t) type << (HANDLE_INDEX_BITS + HANDLE_GENERATION_BITS)) |
+        ((oriHandle_t) table->generations[slot] << HANDLE_INDEX_BITS) |
+        (oriHandle_t) slot;
+}
+
+void *_oriResolveHandle(
+    const _oriHandleTable_t *table,
+    const _oriHandleType_t type,
+    const oriHandle_t handle
+) {
+    const unsigned int slot = _ORI_HANDLE_INDEX(handle);
+
+    // (in trusted builds, handles are assumed to be valid; see _ORI_CONTRACT_BROKEN)
+    if (_ORI_CONTRACT_BROKEN(_ORI_HANDLE_TYPE(handle) != (oriHandle_t) type || slot >= table->used || table->generations[slot] != _ORI_HANDLE_GENERATION(handle))) {
+        return NULL;
+    }
+
+    return table->records[slot];
+}
+
+void _oriReplaceHandleRecord(
+    _oriHandleTable_t *table,
+    const oriHandle_t handle,
+    void *record
+) {
+    table->records[_ORI_HANDLE_INDEX(handle)] = record;
+}
+
+void _oriDestroyHandle(
+    _oriHandleTable_t *table,
+    const oriHandle_t handle
+) {
+    const unsigned int slot = _ORI_HANDLE_INDEX(handle);
+    if (slot >= table->used || !table->records[slot]) {
+        return;
+    }
+
+    // bumping the generation invalidates every copy of the handle
+    table->generations[slot] = (table->generations[slot] + 1) & _ORI_HANDLE_GENERATION_MASK;
+    table->records[slot] = NULL;
+
+    table->freeSlots[table->freeCount++] = (uint16_t) slot;
+}
+
+void _oriFreeHandleTable(
+    _oriHandleTable_t *table
+) {
+    free(table->generations);
+    free(table->records);
+    free(table->freeSlots);
+
+    memset(table, 0, sizeof(_oriHandleTable_t));
+}
+
+// Send the error explaining why a handle could not be resolved.
+//
+static void _oriHandleError(
+    const _oriHandleTable_t *table,
+    const _oriHandleType_t type,
+    const oriHandle_t handle,
+    const char *func
+) {
+    // a handle of the right type whose slot exists can only have failed the generation check
+    if (_ORI_HANDLE_TYPE(handle) == (oriHandle_t) type && _ORI_HANDLE_INDEX(handle) < table->used) {
+        _oriError(ORIERR_STALE_HANDLE, func);
+    } else {
+        _oriError(ORIERR_INVALID_OBJECT, func);
+    }
+}
+
+_oriVkInstance_t *_oriGetInstance(
+    const oriHandle_t instance,
+    const char *func
+) {
+    // the handle may be one that oriInitAsync() has not finished creating yet
+    _oriAwaitInit();
+
+    _oriVkInstance_t *record = _oriResolveHandle(&_orion.allocatees.instances, _ORI_HANDLE_TYPE_INSTANCE, instance);
+    if (!record) {
+        _oriHandleError(&_orion.allocatees.instances, _ORI_HANDLE_TYPE_INSTANCE, instance, func);
+    }
+
+    return record;
+}
+
+_oriVkDevice_t *_oriGetDevice(
+    const oriHandle_t device,
+    const char *func
+) {
+    _oriAwaitInit();
+
+    _oriVkDevice_t *record = _oriResolveHandle(&_orion.allocatees.devices, _ORI_HANDLE_TYPE_DEVICE, device);
+    if (!record) {
+        _oriHandleError(&_orion.allocatees.devices, _ORI_HANDLE_TYPE_DEVICE, device, func);
+    }
+
+    return record;
+}
+
+_oriMemoryChunk_t *_oriGetAllocation(
+    _oriVkDevice_t *device,
+    const oriHandle_t allocation,
+    const char *func
+) {
+    _oriMemoryChunk_t *record = _oriResolveHandle(&device->memory.allocations, _ORI_HANDLE_TYPE_ALLOCATION, allocation);
+    if (!record) {
+        _oriHandleError(&device->memory.allocations, _ORI_HANDLE_TYPE_ALLOCATION, allocation, func);
+    }
+
+    return record;
+}
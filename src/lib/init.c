@@ -38,6 +38,14 @@
 
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <threads.h>
+
+// direct driver loading needs the driver library to be opened by us instead of the loader
+#if (defined(__unix__) || defined(__APPLE__)) && defined(VK_LUNARG_direct_driver_loading)
+#   define _ORI_DIRECT_DRIVER_SUPPORTED
+#   include <dlfcn.h>
+#endif
 
 
 // ============================================================================ //
@@ -51,6 +59,420 @@ _oriLibrary_t _orion = {
 };
 
 
+// ----[Private/internal systems]---------------------------------------------- //
+//                              String array helpers                            //
+
+char **_oriCopyStrings(
+    const unsigned int count,
+    const char **strings
+) {
+    if (!count) {
+        return NULL;
+    }
+
+    char **copy = malloc(sizeof(char *) * count);
+    if (!copy) {
+        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+        return NULL;
+    }
+
+    for (unsigned int i = 0; i < count; i++) {
+        copy[i] = malloc(sizeof(char) * (1 + strlen(strings[i]))); // we add 1 for the null terminator
+        if (!copy[i]) {
+            _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+            return NULL;
+        }
+
+        strcpy(copy[i], strings[i]);
+    }
+
+    return copy;
+}
+
+void _oriFreeStrings(
+    const unsigned int count,
+    char **strings
+) {
+    if (!strings) {
+        return;
+    }
+
+    for (unsigned int i = 0; i < count; i++) {
+        free(strings[i]);
+    }
+    free(strings);
+}
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                           Asynchronous initialisation                        //
+
+// true only on the thread running an initialisation started with oriInitAsync(), which must not wait for itself
+static thread_local bool _oriIsInitThread = false;
+
+// Copy a string that may be NULL.
+//
+static char *_oriCopyOptionalString(
+    const char *string
+) {
+    if (!string) {
+        return NULL;
+    }
+
+    char *copy = malloc(strlen(string) + 1);
+    if (!copy) {
+        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+        return NULL;
+    }
+
+    strcpy(copy, string);
+    return copy;
+}
+
+static void _oriFreeAsyncInitArgs(
+    _oriAsyncInit_t *args
+) {
+    free(args->applicationName);
+    free(args->engineName);
+    _oriFreeStrings(args->layerCount, args->layers);
+    _oriFreeStrings(args->extensionCount, args->extensions);
+    free(args);
+}
+
+// Body of the initialisation thread: oriInit(), then fill the format tables of every physical device while the application
+// is busy with its own startup.
+//
+static int _oriAsyncInitThread(
+    void *pointer
+) {
+    _oriAsyncInit_t *args = pointer;
+    _oriIsInitThread = true;
+
+    args->status = oriInit(
+        args->instanceCount, args->instanceOut, args->handlesOut, args->instanceFlags, args->apiVersion,
+        args->applicationName, args->applicationVersion, args->engineName, args->engineVersion,
+        args->layerCount, (const char **) args->layers, args->extensionCount, (const char **) args->extensions,
+        args->instanceNext
+    );
+
+    for (unsigned int i = 0; args->status == ORION_RETURN_STATUS_OK && i < args->instanceCount; i++) {
+        unsigned int physicalDeviceCount = 0;
+        vkEnumeratePhysicalDevices(args->instanceOut[i], &physicalDeviceCount, NULL);
+        if (!physicalDeviceCount) {
+            continue;
+        }
+
+        VkPhysicalDevice physicalDevices[physicalDeviceCount];
+        vkEnumeratePhysicalDevices(args->instanceOut[i], &physicalDeviceCount, physicalDevices);
+
+        for (unsigned int j = 0; j < physicalDeviceCount; j++) {
+            oriPrefetchFormatProperties(physicalDevices[j], false);
+        }
+    }
+
+    _oriIsInitThread = false;
+    return 0;
+}
+
+void _oriAwaitInit() {
+    if (_oriIsInitThread) {
+        return;
+    }
+
+    int state = atomic_load_explicit(&_orion.asyncInit.state, memory_order_acquire);
+    while (state != _ORI_ASYNC_INIT_NONE) {
+        // the first thread to get here joins the initialisation thread, and any others wait for it to finish doing so
+        if (state == _ORI_ASYNC_INIT_RUNNING && atomic_compare_exchange_strong(&_orion.asyncInit.state, &state, _ORI_ASYNC_INIT_JOINING)) {
+            thrd_join(_orion.asyncInit.thread, NULL);
+
+            _orion.asyncInit.status = _orion.asyncInit.args->status;
+            _oriFreeAsyncInitArgs(_orion.asyncInit.args);
+            _orion.asyncInit.args = NULL;
+
+            atomic_store_explicit(&_orion.asyncInit.state, _ORI_ASYNC_INIT_NONE, memory_order_release);
+            return;
+        }
+
+        thrd_yield();
+        state = atomic_load_explicit(&_orion.asyncInit.state, memory_order_acquire);
+    }
+}
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                             Validation profiles                              //
+
+#define ORION_VALIDATION_LAYER_NAME "VK_LAYER_KHRONOS_validation"
+
+// Check if an extension name is in an array of extension names.
+//
+static bool _oriFindExtensionName(
+    const char *extension,
+    const unsigned int count,
+    const char **names
+) {
+    for (unsigned int i = 0; i < count; i++) {
+        if (!strcmp(names[i], extension)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+const bool _oriChainValidationProfile(
+    _oriValidationProfileChain_t *chain,
+    const void *next,
+    const unsigned int layerCount,
+    const char **layers,
+    unsigned int *extCount,
+    const char **exts
+) {
+    // the profile only means anything if the validation layer is enabled
+    if (!_oriFindExtensionName(ORION_VALIDATION_LAYER_NAME, layerCount, layers)) {
+#       ifdef __oridebug
+            _oriWarning("validation profile set but %s is not enabled, ignoring profile", ORION_VALIDATION_LAYER_NAME);
+#       endif
+
+        return false;
+    }
+
+    // if the user has configured validation features themselves, then we leave them alone
+    if (_oriFindStructureInChain(next, VK_STRUCTURE_TYPE_VALIDATION_FEATURES_EXT)) {
+#       ifdef __oridebug
+            _oriWarning("VkValidationFeaturesEXT already in instance pNext chain, ignoring validation profile");
+#       endif
+
+        return false;
+    }
+
+    memset(chain, 0, sizeof(_oriValidationProfileChain_t));
+
+    unsigned int enableCount = 0;
+    unsigned int disableCount = 0;
+
+    switch (_orion.validationProfile) {
+        default:
+            return false;
+
+        case ORION_VALIDATION_PROFILE_CORE_ONLY:
+            // core checks, parameter validation and object lifetimes only; the per-call overhead of thread safety and
+            // handle wrapping is removed, as is shader module validation
+            chain->disables[disableCount++] = VK_VALIDATION_FEATURE_DISABLE_THREAD_SAFETY_EXT;
+            chain->disables[disableCount++] = VK_VALIDATION_FEATURE_DISABLE_UNIQUE_HANDLES_EXT;
+            chain->disables[disableCount++] = VK_VALIDATION_FEATURE_DISABLE_SHADERS_EXT;
+            break;
+
+        case ORION_VALIDATION_PROFILE_SYNC:
+            chain->enables[enableCount++] = VK_VALIDATION_FEATURE_ENABLE_SYNCHRONIZATION_VALIDATION_EXT;
+            chain->disables[disableCount++] = VK_VALIDATION_FEATURE_DISABLE_THREAD_SAFETY_EXT;
+            chain->disables[disableCount++] = VK_VALIDATION_FEATURE_DISABLE_API_PARAMETERS_EXT;
+            chain->disables[disableCount++] = VK_VALIDATION_FEATURE_DISABLE_OBJECT_LIFETIMES_EXT;
+            chain->disables[disableCount++] = VK_VALIDATION_FEATURE_DISABLE_SHADERS_EXT;
+            break;
+
+        case ORION_VALIDATION_PROFILE_BEST_PRACTICES_ONLY:
+            chain->enables[enableCount++] = VK_VALIDATION_FEATURE_ENABLE_BEST_PRACTICES_EXT;
+            chain->disables[disableCount++] = VK_VALIDATION_FEATURE_DISABLE_CORE_CHECKS_EXT;
+            chain->disables[disableCount++] = VK_VALIDATION_FEATURE_DISABLE_THREAD_SAFETY_EXT;
+            chain->disables[disableCount++] = VK_VALIDATION_FEATURE_DISABLE_API_PARAMETERS_EXT;
+            chain->disables[disableCount++] = VK_VALIDATION_FEATURE_DISABLE_OBJECT_LIFETIMES_EXT;
+            chain->disables[disableCount++] = VK_VALIDATION_FEATURE_DISABLE_UNIQUE_HANDLES_EXT;
+            chain->disables[disableCount++] = VK_VALIDATION_FEATURE_DISABLE_SHADERS_EXT;
+            break;
+
+        case ORION_VALIDATION_PROFILE_GPU_ASSISTED_OFF:
+            // VkValidationFeaturesEXT can only add GPU-assisted validation, not remove it, so this profile is
+            // expressed through layer settings below (if they are available).
+            break;
+    }
+
+    chain->next = next;
+
+    if (enableCount || disableCount) {
+        const char *ext = VK_EXT_VALIDATION_FEATURES_EXTENSION_NAME;
+
+        if (!oriCheckInstanceExtensionAvailability(ext, ORION_VALIDATION_LAYER_NAME)) {
+#           ifdef __oridebug
+                _oriWarning("%s not provided by %s, ignoring validation profile", ext, ORION_VALIDATION_LAYER_NAME);
+#           endif
+
+            return false;
+        }
+        if (!_oriFindExtensionName(ext, *extCount, exts)) {
+            exts[(*extCount)++] = ext;
+        }
+
+        chain->features = (VkValidationFeaturesEXT) {
+            .sType = VK_STRUCTURE_TYPE_VALIDATION_FEATURES_EXT,
+            .pNext = chain->next,
+            .enabledValidationFeatureCount = enableCount,
+            .pEnabledValidationFeatures = chain->enables,
+            .disabledValidationFeatureCount = disableCount,
+            .pDisabledValidationFeatures = chain->disables
+        };
+        chain->next = &chain->features;
+    }
+
+#   ifdef VK_EXT_layer_settings
+        // GPU-assisted validation and debug printf instrument every shader and pipeline, and are switched off
+        // explicitly in every profile so that they cannot be left on by a layer settings file or environment variable.
+        // this is optional: older layers don't support VK_EXT_layer_settings
+        if (
+            !_oriFindStructureInChain(next, VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT) &&
+            oriCheckInstanceExtensionAvailability(VK_EXT_LAYER_SETTINGS_EXTENSION_NAME, ORION_VALIDATION_LAYER_NAME)
+        ) {
+            if (!_oriFindExtensionName(VK_EXT_LAYER_SETTINGS_EXTENSION_NAME, *extCount, exts)) {
+                exts[(*extCount)++] = VK_EXT_LAYER_SETTINGS_EXTENSION_NAME;
+            }
+
+            chain->settingValue = VK_FALSE;
+
+            chain->settings[0] = (VkLayerSettingEXT) {
+                .pLayerName = ORION_VALIDATION_LAYER_NAME,
+                .pSettingName = "gpuav_enable",
+                .type = VK_LAYER_SETTING_TYPE_BOOL32_EXT,
+                .valueCount = 1,
+                .pValues = &chain->settingValue
+            };
+            chain->settings[1] = (VkLayerSettingEXT) {
+                .pLayerName = ORION_VALIDATION_LAYER_NAME,
+                .pSettingName = "printf_enable",
+                .type = VK_LAYER_SETTING_TYPE_BOOL32_EXT,
+                .valueCount = 1,
+                .pValues = &chain->settingValue
+            };
+
+            chain->layerSettings = (VkLayerSettingsCreateInfoEXT) {
+                .sType = VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT,
+                .pNext = chain->next,
+                .settingCount = 2,
+                .pSettings = chain->settings
+            };
+            chain->next = &chain->layerSettings;
+        }
+#   endif
+
+    // nothing could be applied
+    if (chain->next == next) {
+#       ifdef __oridebug
+            _oriWarning("validation profile %d could not be applied with the available layer extensions", _orion.validationProfile);
+#       endif
+
+        return false;
+    }
+
+    return true;
+}
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                            Direct driver loading                             //
+
+// Open a driver library and find its vk_icdGetInstanceProcAddr, replacing any driver that was already set.
+//
+static const oriReturnStatus_t _oriOpenDirectDriver(
+    const char *path,
+    const bool exclusive
+) {
+#   ifdef _ORI_DIRECT_DRIVER_SUPPORTED
+        void *library = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+        if (!library) {
+            _oriWarning("failed to open driver library '%s': %s", path, dlerror());
+            _oriError(ORIERR_DRIVER_LOAD_FAIL, __func__);
+            return ORION_RETURN_STATUS_ERROR;
+        }
+
+        // (a void pointer can't be converted to a function pointer directly in ISO C, so it is copied instead)
+        void *symbol = dlsym(library, "vk_icdGetInstanceProcAddr");
+        if (!symbol) {
+            _oriWarning("driver library '%s' does not export vk_icdGetInstanceProcAddr", path);
+            _oriError(ORIERR_DRIVER_LOAD_FAIL, __func__);
+            dlclose(library);
+            return ORION_RETURN_STATUS_ERROR;
+        }
+
+        _oriCloseDirectDriver();
+
+        _orion.directDriver.library = library;
+        memcpy(&_orion.directDriver.getInstanceProcAddr, &symbol, sizeof(void *));
+        _orion.directDriver.exclusive = exclusive;
+
+#       ifdef __oridebug
+            _oriLog("driver library '%s' opened for direct loading (%s)", path, __func__);
+#       endif
+
+        return ORION_RETURN_STATUS_OK;
+#   else
+        _oriWarning("direct driver loading is not supported on this platform or by these Vulkan headers (%s)", __func__);
+        return ORION_RETURN_STATUS_SKIPPED;
+#   endif
+}
+
+void _oriLoadConfiguredDirectDriver() {
+    if (_orion.directDriver.library) {
+        return;
+    }
+
+    const char *path = getenv("ORION_DIRECT_DRIVER");
+    if (path && *path) {
+        _oriOpenDirectDriver(path, true);
+    }
+}
+
+#ifdef VK_LUNARG_direct_driver_loading
+    const bool _oriChainDirectDriver(
+        _oriDirectDriverChain_t *chain,
+        const void *next,
+        unsigned int *extCount,
+        const char **exts
+    ) {
+        if (!_orion.directDriver.library) {
+            return false;
+        }
+
+        // the extension is implemented by the loader itself
+        if (!oriCheckInstanceExtensionAvailability(VK_LUNARG_DIRECT_DRIVER_LOADING_EXTENSION_NAME, NULL)) {
+#           ifdef __oridebug
+                _oriWarning("%s not provided by the Vulkan loader, using driver discovery instead", VK_LUNARG_DIRECT_DRIVER_LOADING_EXTENSION_NAME);
+#           endif
+
+            return false;
+        }
+        if (!_oriFindExtensionName(VK_LUNARG_DIRECT_DRIVER_LOADING_EXTENSION_NAME, *extCount, exts)) {
+            exts[(*extCount)++] = VK_LUNARG_DIRECT_DRIVER_LOADING_EXTENSION_NAME;
+        }
+
+        chain->driver = (VkDirectDriverLoadingInfoLUNARG) {
+            .sType = VK_STRUCTURE_TYPE_DIRECT_DRIVER_LOADING_INFO_LUNARG,
+            .pfnGetInstanceProcAddr = (PFN_vkGetInstanceProcAddrLUNARG) _orion.directDriver.getInstanceProcAddr
+        };
+        chain->list = (VkDirectDriverLoadingListLUNARG) {
+            .sType = VK_STRUCTURE_TYPE_DIRECT_DRIVER_LOADING_LIST_LUNARG,
+            .pNext = next,
+            .mode = (_orion.directDriver.exclusive) ? VK_DIRECT_DRIVER_LOADING_MODE_EXCLUSIVE_LUNARG : VK_DIRECT_DRIVER_LOADING_MODE_INCLUSIVE_LUNARG,
+            .driverCount = 1,
+            .pDrivers = &chain->driver
+        };
+
+        return true;
+    }
+#endif
+
+void _oriCloseDirectDriver() {
+    if (!_orion.directDriver.library) {
+        return;
+    }
+
+#   ifdef _ORI_DIRECT_DRIVER_SUPPORTED
+        dlclose(_orion.directDriver.library);
+#   endif
+
+    _orion.directDriver.library = NULL;
+    _orion.directDriver.getInstanceProcAddr = NULL;
+}
+
+
 // ============================================================================ //
 // *****                  Orion library public interface                  ***** //
 // ============================================================================ //
@@ -62,6 +484,7 @@ _oriLibrary_t _orion = {
 const oriReturnStatus_t oriInit(
     const unsigned int instanceCount,
     VkInstance *instanceOut,
+    oriHandle_t *handlesOut,
     const VkInstanceCreateFlags instanceFlags,
     const unsigned int apiVersion,
     const char *applicationName,
@@ -74,6 +497,8 @@ const oriReturnStatus_t oriInit(
     const char **enabledInstanceExtensions,
     const void *instanceNext
 ) {
+    _oriAwaitInit();
+
     if (_orion.initialised) { // already initialised
         return ORION_RETURN_STATUS_SKIPPED;
     }
@@ -81,30 +506,19 @@ const oriReturnStatus_t oriInit(
         _oriWarning("all output variables NULL in call to %s", __func__);
         return ORION_RETURN_STATUS_NO_OUTPUT;
     }
-    if (!instanceOut && instanceCount) { // no instances given but count is not 0
+    if (_ORI_CONTRACT_BROKEN(!instanceOut && instanceCount)) { // no instances given but count is not 0
         _oriError(ORIERR_NULL_POINTER, __func__);
         return ORION_RETURN_STATUS_NULL_POINTER;
     }
-    if (!enabledLayers && enabledLayerCount) { // no layers given but count is not 0
+    if (_ORI_CONTRACT_BROKEN(!enabledLayers && enabledLayerCount)) { // no layers given but count is not 0
         _oriError(ORIERR_NULL_POINTER, __func__);
         return ORION_RETURN_STATUS_NULL_POINTER;
     }
-    if (!enabledInstanceExtensions && enabledInstanceExtensionCount) { // no extensions given but count is not 0
+    if (_ORI_CONTRACT_BROKEN(!enabledInstanceExtensions && enabledInstanceExtensionCount)) { // no extensions given but count is not 0
         _oriError(ORIERR_NULL_POINTER, __func__);
         return ORION_RETURN_STATUS_NULL_POINTER;
     }
 
-    // check if the given VkInstance pointer is already in the hash table of instances
-    // this is really just a precautionary measure as there should only ever be one instance anyway. It could be omitted in the future if necessary.
-    {
-        _oriVkInstance_t *queryStructure;
-        HASH_FIND_PTR(_orion.allocatees.vkInstances, instanceOut, queryStructure);
-        if (queryStructure) { // uthash will have set queryStructure to NULL if it wasn't found so we can rely on this check
-            _oriWarning("orion already allocated instance at %p (%s)", instanceOut, __func__);
-            return ORION_RETURN_STATUS_SKIPPED;
-        }
-    }
-
     // create application info struct
     VkApplicationInfo appInfo = {
         .sType = VK_STRUCTURE_TYPE_APPLICATION_INFO,
@@ -133,8 +547,9 @@ const oriReturnStatus_t oriInit(
     // static arrays that will hold the compatible layers and extensions
     // we are storing these in the primary function scope because they are referenced by vkCreateInstance() and so must be preserved until then.
     // as each specified layer/extension is validated, it is added to the respective array here (assuming it was found to be compatible.)
+    // (the extension array has space for the extensions that may be added for the validation profile and direct driver loading)
     const char *actualEnabledLayers[enabledLayerCount];
-    const char *actualEnabledExts[enabledInstanceExtensionCount];
+    const char *actualEnabledExts[enabledInstanceExtensionCount + 3];
     unsigned int actualEnabledLayerCount = 0;
     unsigned int actualEnabledExtCount = 0;
 
@@ -150,7 +565,7 @@ const oriReturnStatus_t oriInit(
         for (unsigned int i = 0; i < enabledLayerCount; i++) {
             if (oriCheckLayerAvailability(enabledLayers[i])) {
                 // add to 'actual' array of layers
-                actualEnabledLayers[i] = enabledLayers[i];
+                actualEnabledLayers[actualEnabledLayerCount] = enabledLayers[i];
                 actualEnabledLayerCount++;
 
 #               ifdef __oridebug
@@ -198,7 +613,7 @@ const oriReturnStatus_t oriInit(
 
             // check if the current extension is provided by the Vulkan implementation
             if (oriCheckInstanceExtensionAvailability(enabledInstanceExtensions[i], NULL)) {
-                actualEnabledExts[i] = enabledInstanceExtensions[i];
+                actualEnabledExts[actualEnabledExtCount] = enabledInstanceExtensions[i];
                 actualEnabledExtCount++;
                 provided = true;
             }
@@ -208,7 +623,7 @@ const oriReturnStatus_t oriInit(
                 for (unsigned int j = 0; j < actualEnabledLayerCount; j++) {
                     // check if the current extension is provided by the current layer
                     if (oriCheckInstanceExtensionAvailability(enabledInstanceExtensions[i], actualEnabledLayers[j])) {
-                        actualEnabledExts[i] = enabledInstanceExtensions[i];
+                        actualEnabledExts[actualEnabledExtCount] = enabledInstanceExtensions[i];
                         actualEnabledExtCount++;
                         provided = true;
                         break;
@@ -245,107 +660,257 @@ const oriReturnStatus_t oriInit(
         }
     }
 
+    // chain the structures for the validation profile, if one was set
+    // these are stored in the primary function scope as they are referenced by vkCreateInstance().
+    _oriValidationProfileChain_t validationChain;
+    if (_orion.validationProfile != ORION_VALIDATION_PROFILE_DEFAULT) {
+        if (_oriChainValidationProfile(&validationChain, createInfo.pNext, actualEnabledLayerCount, actualEnabledLayers, &actualEnabledExtCount, actualEnabledExts)) {
+            createInfo.pNext = validationChain.next;
+            createInfo.enabledExtensionCount = actualEnabledExtCount;
+            createInfo.ppEnabledExtensionNames = (const char *const *) actualEnabledExts;
+
+#           ifdef __oridebug
+                char s[MAX_LOG_LEN];
+                snprintf(s, MAX_LOG_LEN, "\n\tvalidation profile %d applied", _orion.validationProfile);
+                strncat(logstr, s, MAX_LOG_LEN);
+#           endif
+        }
+    }
+
+    // chain the structures to load a driver directly, if one was set (or configured in the environment)
+#   ifdef VK_LUNARG_direct_driver_loading
+        _oriLoadConfiguredDirectDriver();
+
+        _oriDirectDriverChain_t directDriverChain;
+        if (_oriChainDirectDriver(&directDriverChain, createInfo.pNext, &actualEnabledExtCount, actualEnabledExts)) {
+            createInfo.pNext = &directDriverChain.list;
+            createInfo.enabledExtensionCount = actualEnabledExtCount;
+            createInfo.ppEnabledExtensionNames = (const char *const *) actualEnabledExts;
+
+#           ifdef __oridebug
+                char s[MAX_LOG_LEN];
+                snprintf(s, MAX_LOG_LEN, "\n\tdriver loaded directly (%s)", (_orion.directDriver.exclusive) ? "exclusive" : "inclusive");
+                strncat(logstr, s, MAX_LOG_LEN);
+#           endif
+        }
+#   endif
+
     for (unsigned int i = 0; i < instanceCount; i++) {
         if (vkCreateInstance(&createInfo, _orion.callbacks.vulkanAllocators, &instanceOut[i])) {
             _oriError(ORIERR_INSTANCE_CREATION_FAIL, __func__);
             return ORION_RETURN_STATUS_ERROR;
         }
-    }
 
-    // create a wrapper for the instance which can be stored in _orion
-    _oriVkInstance_t *wrapper = malloc(sizeof(_oriVkInstance_t));
-    if (!wrapper) {
-        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
-        return ORION_RETURN_STATUS_ERROR;
-    }
-    wrapper->handle = instanceOut;
+        _oriTrackObjectCreation(VK_OBJECT_TYPE_INSTANCE, _ORI_DISPATCHABLE_HANDLE_U64(instanceOut[i]), sizeof(_oriVkInstance_t));
 
-    // store the enabled layers
-    wrapper->layerCount = actualEnabledLayerCount;
-    wrapper->layers = malloc(sizeof(const char *) * actualEnabledLayerCount);
-    if (!wrapper->layers) {
-        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
-        return ORION_RETURN_STATUS_ERROR;
-    }
+        // create a wrapper for the instance which can be stored in _orion
+        // the instance handle is copied, so the caller is free to move or discard their VkInstance variable
+        _oriVkInstance_t *wrapper = malloc(sizeof(_oriVkInstance_t));
+        if (!wrapper) {
+            _oriTrackObjectDestruction(VK_OBJECT_TYPE_INSTANCE, _ORI_DISPATCHABLE_HANDLE_U64(instanceOut[i]));
+            vkDestroyInstance(instanceOut[i], _orion.callbacks.vulkanAllocators);
 
-    for (unsigned int i = 0; i < actualEnabledLayerCount; i++) {
-        // since the array of enabled layers here is stack-allocated, we need to malloc each string in the wrapper object
-        wrapper->layers[i] = malloc(sizeof(char) * (1 + strlen(actualEnabledLayers[i]))); // we add 1 for the null terminator
-        if (!wrapper->layers[i]) {
             _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
             return ORION_RETURN_STATUS_ERROR;
         }
+        wrapper->handle = instanceOut[i];
+
+        // a debug messenger can be created later with oriCreateDebugMessenger()
+        wrapper->debugMessenger = VK_NULL_HANDLE;
+        wrapper->destroyDebugMessenger = NULL;
+        wrapper->perfWarnings = NULL;
+
+        // since the arrays of enabled layers and extensions here are stack-allocated, they need to be copied into the wrapper object
+        wrapper->layerCount = actualEnabledLayerCount;
+        wrapper->layers = _oriCopyStrings(actualEnabledLayerCount, actualEnabledLayers);
+        wrapper->extensionCount = actualEnabledExtCount;
+        wrapper->extensions = _oriCopyStrings(actualEnabledExtCount, actualEnabledExts);
+
+        // internally store the wrapper
+        const oriHandle_t handle = _oriCreateHandle(&_orion.allocatees.instances, _ORI_HANDLE_TYPE_INSTANCE, wrapper);
+        if (!handle) {
+            _oriTrackObjectDestruction(VK_OBJECT_TYPE_INSTANCE, _ORI_DISPATCHABLE_HANDLE_U64(wrapper->handle));
+            vkDestroyInstance(wrapper->handle, _orion.callbacks.vulkanAllocators);
+
+            _oriFreeStrings(wrapper->layerCount, wrapper->layers);
+            _oriFreeStrings(wrapper->extensionCount, wrapper->extensions);
+            free(wrapper);
+
+            _oriError(ORIERR_OBJECT_CREATION_FAIL, "instance handle table is full");
+            return ORION_RETURN_STATUS_ERROR;
+        }
+
+        if (handlesOut) {
+            handlesOut[i] = handle;
+        }
+    }
+
+#   ifdef __oridebug
+        _oriNotification(logstr);
+#   endif
+
+    // the library has been initialised
+    _orion.apiVersion = apiVersion;
+    _orion.initialised = true;
+    return ORION_RETURN_STATUS_OK;
+}
+
+const oriReturnStatus_t oriInitAsync(
+    const unsigned int instanceCount,
+    VkInstance *instanceOut,
+    oriHandle_t *handlesOut,
+    const VkInstanceCreateFlags instanceFlags,
+    const unsigned int apiVersion,
+    const char *applicationName,
+    const unsigned int applicationVersion,
+    const char *engineName,
+    const unsigned int engineVersion,
+    const unsigned int enabledLayerCount,
+    const char **enabledLayers,
+    const unsigned int enabledInstanceExtensionCount,
+    const char **enabledInstanceExtensions,
+    const void *instanceNext
+) {
+    _oriAwaitInit();
 
-        strcpy(wrapper->layers[i], actualEnabledLayers[i]);
+    // these are checked here too so that they are reported to the caller straight away
+    if (_orion.initialised) {
+        return ORION_RETURN_STATUS_SKIPPED;
+    }
+    if (!instanceOut || !instanceCount) {
+        _oriWarning("all output variables NULL in call to %s", __func__);
+        return ORION_RETURN_STATUS_NO_OUTPUT;
+    }
+    if (_ORI_CONTRACT_BROKEN((!enabledLayers && enabledLayerCount) || (!enabledInstanceExtensions && enabledInstanceExtensionCount))) {
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
     }
 
-    // store the enabled instance extensions
-    wrapper->extensionCount = actualEnabledExtCount;
-    wrapper->extensions = malloc(sizeof(const char *) * actualEnabledExtCount);
-    if (!wrapper->extensions) {
+    // the parameters are copied, as the caller can free or reuse them while the thread runs
+    _oriAsyncInit_t *args = calloc(1, sizeof(_oriAsyncInit_t));
+    if (!args) {
         _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
         return ORION_RETURN_STATUS_ERROR;
     }
+    args->instanceCount = instanceCount;
+    args->instanceOut = instanceOut;
+    args->handlesOut = handlesOut;
+    args->instanceFlags = instanceFlags;
+    args->apiVersion = apiVersion;
+    args->applicationName = _oriCopyOptionalString(applicationName);
+    args->applicationVersion = applicationVersion;
+    args->engineName = _oriCopyOptionalString(engineName);
+    args->engineVersion = engineVersion;
+    args->layerCount = enabledLayerCount;
+    args->layers = _oriCopyStrings(enabledLayerCount, enabledLayers);
+    args->extensionCount = enabledInstanceExtensionCount;
+    args->extensions = _oriCopyStrings(enabledInstanceExtensionCount, enabledInstanceExtensions);
+    args->instanceNext = instanceNext;
+
+    _orion.asyncInit.started = true;
+    _orion.asyncInit.args = args;
+
+    // fall back to initialising here if the thread can't be started
+    if (thrd_create(&_orion.asyncInit.thread, _oriAsyncInitThread, args) != thrd_success) {
+#       ifdef __oridebug
+            _oriWarning("failed to start initialisation thread, initialising synchronously (%s)", __func__);
+#       endif
 
-    for (unsigned int i = 0; i < actualEnabledExtCount; i++) {
-        wrapper->extensions[i] = malloc(sizeof(char) * (1 + strlen(actualEnabledExts[i]))); // we add 1 for the null terminator
-        if (!wrapper->extensions[i]) {
-            _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
-            return ORION_RETURN_STATUS_ERROR;
-        }
+        _oriAsyncInitThread(args);
+
+        _orion.asyncInit.status = args->status;
+        _oriFreeAsyncInitArgs(args);
+        _orion.asyncInit.args = NULL;
 
-        strcpy(wrapper->extensions[i], actualEnabledExts[i]);
+        return _orion.asyncInit.status;
     }
 
-    // internally store the wrapper
-    HASH_ADD_PTR(_orion.allocatees.vkInstances, handle, wrapper);
+    // (the state is only set once the thread exists, so that nothing can try to join it before then)
+    atomic_store_explicit(&_orion.asyncInit.state, _ORI_ASYNC_INIT_RUNNING, memory_order_release);
 
 #   ifdef __oridebug
-        _oriNotification(logstr);
+        _oriLog("initialisation started in background (%s)", __func__);
 #   endif
 
-    // the library has been initialised
-    _orion.initialised = true;
     return ORION_RETURN_STATUS_OK;
 }
 
+const oriReturnStatus_t oriWaitInit() {
+    _oriAwaitInit();
+
+    if (!_orion.asyncInit.started) {
+        return ORION_RETURN_STATUS_SKIPPED;
+    }
+
+    return _orion.asyncInit.status;
+}
+
 const oriReturnStatus_t oriTerminate() {
 #   ifdef __oridebug
         _oriNotification("lib term called (%s)", __func__);
 #   endif
 
-    // destroy instance(s)
-    {
-        // use buffer for deletion-safe iteration
-        _oriVkInstance_t *cur, *buffer;
-        HASH_ITER(hh, _orion.allocatees.vkInstances, cur, buffer) {
-            // destroy vulkan object
-            if (cur->handle) {
-                vkDestroyInstance(*cur->handle, _orion.callbacks.vulkanAllocators);
-            }
+    // the library can't be torn down under an initialisation that is still running
+    _oriAwaitInit();
 
-            // free array of layers
-            for (unsigned int i = 0; i < cur->layerCount; i++) {
-                free(cur->layers[i]);
-                cur->layers[i] = NULL;
-            }
-            free(cur->layers);
-            cur->layers = NULL;
+    // destroy any logical devices the user did not destroy (this must be done before the instances are destroyed)
+    for (unsigned int i = 0; i < _orion.allocatees.devices.used; i++) {
+        if (_orion.allocatees.devices.records[i]) {
+            _oriDestroyDeviceRecord(_orion.allocatees.devices.records[i]);
+        }
+    }
+    _oriFreeHandleTable(&_orion.allocatees.devices);
 
-            // free array of instance extensions
-            for (unsigned int i = 0; i < cur->extensionCount; i++) {
-                free(cur->extensions[i]);
-                cur->extensions[i] = NULL;
-            }
-            free(cur->extensions);
-            cur->extensions = NULL;
+    // free format tables (their background threads may still be querying physical devices, so this must also be done first)
+    _oriFreeFormatTables();
+
+    // destroy instance(s)
+    for (unsigned int i = 0; i < _orion.allocatees.instances.used; i++) {
+        _oriVkInstance_t *cur = _orion.allocatees.instances.records[i];
+        if (!cur) {
+            continue;
+        }
+
+        // destroy the Orion-managed debug messenger (this must be done before the instance is destroyed)
+        if (cur->debugMessenger) {
+            _oriTrackObjectDestruction(VK_OBJECT_TYPE_DEBUG_UTILS_MESSENGER_EXT, _ORI_NON_DISPATCHABLE_HANDLE_U64(cur->debugMessenger));
+            cur->destroyDebugMessenger(cur->handle, cur->debugMessenger, _orion.callbacks.vulkanAllocators);
+            cur->debugMessenger = VK_NULL_HANDLE;
+        }
+        free(cur->perfWarnings);
+        cur->perfWarnings = NULL;
 
-            // free each wrapper struct
-            HASH_DEL(_orion.allocatees.vkInstances, cur);
-            free(cur);
-            cur = NULL;
+        // destroy vulkan object
+        if (cur->handle) {
+            _oriTrackObjectDestruction(VK_OBJECT_TYPE_INSTANCE, _ORI_DISPATCHABLE_HANDLE_U64(cur->handle));
+            vkDestroyInstance(cur->handle, _orion.callbacks.vulkanAllocators);
         }
+
+        // free arrays of layers and instance extensions
+        _oriFreeStrings(cur->layerCount, cur->layers);
+        cur->layers = NULL;
+        _oriFreeStrings(cur->extensionCount, cur->extensions);
+        cur->extensions = NULL;
+
+        // free each wrapper struct
+        free(cur);
+        cur = NULL;
     }
+    _oriFreeHandleTable(&_orion.allocatees.instances);
+
+    // close the directly loaded driver, now that no instance can be using it
+    _oriCloseDirectDriver();
+
+    // write the startup cache, if one is in use (this is done after the format tables are freed, as that waits for any threads
+    // that may still be adding to it)
+    _oriCloseStartupCache();
+
+    // report anything the object tracker saw leaked and free its buffers (this is done before the debug subscribers are freed so
+    // that they recieve the report)
+    _oriTerminateObjectTracker();
+
+    // free debug subscribers (this has to be done before _orion is cleared, as it holds the list)
+    _oriFreeDebugSubscribers();
 
     // the library can be re-initialised after this point
     memset(&_orion, 0, sizeof(_orion));
@@ -357,6 +922,47 @@ const oriReturnStatus_t oriTerminate() {
     return ORION_RETURN_STATUS_OK;
 }
 
+const oriReturnStatus_t oriSetValidationProfile(
+    const oriValidationProfile_t profile
+) {
+#   ifdef __oridebug
+        _oriLog("validation profile set to %d (%s)", profile, __func__);
+#   endif
+
+    _oriAwaitInit();
+
+    if (_orion.initialised) {
+        _oriWarning("validation profile must be set before oriInit() (%s)", __func__);
+        return ORION_RETURN_STATUS_SKIPPED;
+    }
+
+    _orion.validationProfile = profile;
+    return ORION_RETURN_STATUS_OK;
+}
+
+const oriValidationProfile_t oriGetValidationProfile() {
+    return _orion.validationProfile;
+}
+
+const oriReturnStatus_t oriSetDirectDriver(
+    const char *driverPath,
+    const bool exclusive
+) {
+    _oriAwaitInit();
+
+    if (_orion.initialised) {
+        _oriWarning("direct driver must be set before oriInit() (%s)", __func__);
+        return ORION_RETURN_STATUS_SKIPPED;
+    }
+
+    if (!driverPath) {
+        _oriCloseDirectDriver();
+        return ORION_RETURN_STATUS_OK;
+    }
+
+    return _oriOpenDirectDriver(driverPath, exclusive);
+}
+
 const oriReturnStatus_t oriSetVulkanAllocators(
     VkAllocationCallbacks *callbacks
 ) {
@@ -371,3 +977,14 @@ const oriReturnStatus_t oriSetVulkanAllocators(
 const VkAllocationCallbacks *oriGetVulkanAllocators() {
     return _orion.callbacks.vulkanAllocators;
 }
+
+const VkInstance oriGetVkInstance(
+    const oriHandle_t instance
+) {
+    _oriVkInstance_t *instanceWrapper = _oriGetInstance(instance, __func__);
+    if (!instanceWrapper) {
+        return VK_NULL_HANDLE;
+    }
+
+    return instanceWrapper->handle;
+}
@@ -0,0 +1,478 @@
+/* *************************************************************************************** */
+/*                       ORION GRAPHICS LIBRARY AND RENDERING ENGINE                       */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+
+// ============================================================================ //
+// *****                     Doxygen file information                     ***** //
+// ============================================================================ //
+
+/**
+ * @file tracker.c
+ * @author jack bennett
+ * @brief Vulkan object lifetime tracking
+ *
+ * @copyright Copyright (c) 2022 jack bennett
+ *
+ * This file contains the object tracker, which records the creation and destruction
+ * of Orion-managed Vulkan objects to help find leaks.
+ *
+ * Each thread appends events to its own buffer without locking; the buffers are only
+ * read (and folded into a table of live objects) when statistics or a report are
+ * requested.
+ *
+ */
+
+#include "orion.h"
+#include "orion_funcs.h"
+#include "orion_errors.h"
+#include "orion_flags.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+
+
+// ============================================================================ //
+// *****                     Private/internal systems                     ***** //
+// ============================================================================ //
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                           Per-thread event buffers                           //
+
+// Incremented whenever the tracker buffers are freed, so that threads know their cached buffer pointer is stale
+static atomic_uint _oriTrackerEpoch = 1;
+
+static _Thread_local _oriTrackerBuffer_t *_oriLocalTrackerBuffer = NULL;
+static _Thread_local unsigned int _oriLocalTrackerEpoch = 0;
+static _Thread_local const char *_oriLocalTrackerTag = NULL;
+
+// Get the tracker buffer of the calling thread, creating and publishing it if necessary.
+//
+static _oriTrackerBuffer_t *_oriGetLocalTrackerBuffer() {
+    const unsigned int epoch = atomic_load_explicit(&_oriTrackerEpoch, memory_order_relaxed);
+    if (_oriLocalTrackerBuffer && _oriLocalTrackerEpoch == epoch) {
+        return _oriLocalTrackerBuffer;
+    }
+
+    _oriTrackerBuffer_t *buffer = calloc(1, sizeof(_oriTrackerBuffer_t));
+    _oriTrackerChunk_t *chunk = calloc(1, sizeof(_oriTrackerChunk_t));
+    if (!buffer || !chunk) {
+        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+        return NULL;
+    }
+    buffer->head = chunk;
+    buffer->tail = chunk;
+
+    // push the buffer onto the global list
+    buffer->next = atomic_load_explicit(&_orion.tracker.buffers, memory_order_relaxed);
+    while (!atomic_compare_exchange_weak_explicit(&_orion.tracker.buffers, &buffer->next, buffer, memory_order_release, memory_order_relaxed));
+
+    _oriLocalTrackerBuffer = buffer;
+    _oriLocalTrackerEpoch = epoch;
+
+    return buffer;
+}
+
+// Append an event to the tracker buffer of the calling thread.
+//
+static void _oriTrackEvent(
+    const VkObjectType type,
+    const uint64_t handle,
+    const uint64_t size,
+    const int32_t delta
+) {
+    if (!atomic_load_explicit(&_orion.tracker.enabled, memory_order_relaxed)) {
+        return;
+    }
+
+    _oriTrackerBuffer_t *buffer = _oriGetLocalTrackerBuffer();
+    _oriTrackerChunk_t *chunk = buffer->tail;
+
+    // only this thread writes to the chunk, so a relaxed load is enough
+    unsigned int count = atomic_load_explicit(&chunk->published, memory_order_relaxed);
+
+    if (count == TRACKER_CHUNK_SIZE) {
+        _oriTrackerChunk_t *newChunk = calloc(1, sizeof(_oriTrackerChunk_t));
+        if (!newChunk) {
+            _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+            return;
+        }
+
+        // the old chunk must not be touched after this, as the reader may free it
+        atomic_store_explicit(&chunk->next, newChunk, memory_order_release);
+
+        buffer->tail = newChunk;
+        chunk = newChunk;
+        count = 0;
+    }
+
+    chunk->records[count] = (_oriTrackerRecord_t) {
+        .handle = handle,
+        .size = size,
+        .tag = _oriLocalTrackerTag,
+        .type = type,
+        .delta = delta
+    };
+
+    atomic_store_explicit(&chunk->published, count + 1, memory_order_release);
+}
+
+void _oriTrackObjectCreation(
+    const VkObjectType type,
+    const uint64_t handle,
+    const uint64_t size
+) {
+    _oriTrackEvent(type, handle, size, 1);
+}
+
+void _oriTrackObjectDestruction(
+    const VkObjectType type,
+    const uint64_t handle
+) {
+    _oriTrackEvent(type, handle, 0, -1);
+}
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                             Live object table                                //
+
+static void _oriLockTracker() {
+    while (atomic_flag_test_and_set_explicit(&_orion.tracker.lock, memory_order_acquire)) {
+        thrd_yield();
+    }
+}
+
+static void _oriUnlockTracker() {
+    atomic_flag_clear_explicit(&_orion.tracker.lock, memory_order_release);
+}
+
+// Find the per-type counters of an object type, adding them if necessary.
+// Returns NULL if MAX_TRACKED_OBJECT_TYPES types are already being counted.
+//
+static _oriTrackedType_t *_oriFindTrackedType(
+    const VkObjectType type
+) {
+    for (unsigned int i = 0; i < _orion.tracker.typeCount; i++) {
+        if (_orion.tracker.types[i].type == type) {
+            return &_orion.tracker.types[i];
+        }
+    }
+
+    if (_orion.tracker.typeCount == MAX_TRACKED_OBJECT_TYPES) {
+        return NULL;
+    }
+
+    _oriTrackedType_t *trackedType = &_orion.tracker.types[_orion.tracker.typeCount++];
+    memset(trackedType, 0, sizeof(_oriTrackedType_t));
+    trackedType->type = type;
+
+    return trackedType;
+}
+
+// Apply a single event to the live object table (the tracker must be locked).
+//
+static void _oriFoldTrackerRecord(
+    const _oriTrackerRecord_t *record
+) {
+    _oriTrackedObject_t key;
+    memset(&key, 0, sizeof(_oriTrackedObject_t));
+    key.key.handle = record->handle;
+    key.key.type = (uint64_t) record->type;
+
+    _oriTrackedObject_t *object = NULL;
+    HASH_FIND(hh, _orion.tracker.live, &key.key, sizeof(key.key), object);
+
+    if (!object) {
+        object = calloc(1, sizeof(_oriTrackedObject_t));
+        if (!object) {
+            _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+            return;
+        }
+        object->key = key.key;
+
+        HASH_ADD(hh, _orion.tracker.live, key, sizeof(object->key), object);
+    }
+
+    if (record->delta > 0) {
+        object->size = record->size;
+        object->tag = record->tag;
+        _orion.tracker.totalCreated++;
+    } else {
+        _orion.tracker.totalDestroyed++;
+    }
+
+    const int64_t before = object->refs;
+    object->refs += record->delta;
+
+    // the object only counts as live while there have been more creations than destructions
+    int64_t liveDelta = 0;
+    if (before <= 0 && object->refs > 0) {
+        liveDelta = 1;
+    } else if (before > 0 && object->refs <= 0) {
+        liveDelta = -1;
+    }
+
+    if (liveDelta) {
+        _orion.tracker.liveObjects += liveDelta;
+        _orion.tracker.liveBytes += liveDelta * (int64_t) object->size;
+
+        _oriTrackedType_t *trackedType = _oriFindTrackedType(record->type);
+        if (trackedType) {
+            trackedType->live += liveDelta;
+            trackedType->bytes += liveDelta * (int64_t) object->size;
+        }
+    }
+
+    if (!object->refs) {
+        HASH_DELETE(hh, _orion.tracker.live, object);
+        free(object);
+    }
+}
+
+// Consume every event published to the tracker buffers since the last call (the tracker must be locked).
+// Chunks that have been fully consumed and abandoned by their owner are freed.
+//
+static void _oriFoldTrackerBuffers() {
+    _oriTrackerBuffer_t *buffer = atomic_load_explicit(&_orion.tracker.buffers, memory_order_acquire);
+
+    for (; buffer; buffer = buffer->next) {
+        while (true) {
+            _oriTrackerChunk_t *chunk = buffer->head;
+
+            // 'next' must be loaded first: if it is set, then the owner filled the chunk before setting it
+            _oriTrackerChunk_t *next = atomic_load_explicit(&chunk->next, memory_order_acquire);
+            const unsigned int published = atomic_load_explicit(&chunk->published, memory_order_acquire);
+
+            for (; chunk->consumed < published; chunk->consumed++) {
+                _oriFoldTrackerRecord(&chunk->records[chunk->consumed]);
+            }
+
+            if (!next) {
+                break;
+            }
+
+            buffer->head = next;
+            free(chunk);
+        }
+    }
+}
+
+static const char *_oriStringifyObjectType(
+    const VkObjectType type
+) {
+    switch (type) {
+        default:                                        return "unknown object";
+
+        case VK_OBJECT_TYPE_INSTANCE:                   return "VkInstance";
+        case VK_OBJECT_TYPE_PHYSICAL_DEVICE:            return "VkPhysicalDevice";
+        case VK_OBJECT_TYPE_DEVICE:                     return "VkDevice";
+        case VK_OBJECT_TYPE_QUEUE:                      return "VkQueue";
+        case VK_OBJECT_TYPE_SEMAPHORE:                  return "VkSemaphore";
+        case VK_OBJECT_TYPE_COMMAND_BUFFER:             return "VkCommandBuffer";
+        case VK_OBJECT_TYPE_FENCE:                      return "VkFence";
+        case VK_OBJECT_TYPE_DEVICE_MEMORY:              return "VkDeviceMemory";
+        case VK_OBJECT_TYPE_BUFFER:                     return "VkBuffer";
+        case VK_OBJECT_TYPE_IMAGE:                      return "VkImage";
+        case VK_OBJECT_TYPE_EVENT:                      return "VkEvent";
+        case VK_OBJECT_TYPE_QUERY_POOL:                 return "VkQueryPool";
+        case VK_OBJECT_TYPE_BUFFER_VIEW:                return "VkBufferView";
+        case VK_OBJECT_TYPE_IMAGE_VIEW:                 return "VkImageView";
+        case VK_OBJECT_TYPE_SHADER_MODULE:              return "VkShaderModule";
+        case VK_OBJECT_TYPE_PIPELINE_CACHE:             return "VkPipelineCache";
+        case VK_OBJECT_TYPE_PIPELINE_LAYOUT:            return "VkPipelineLayout";
+        case VK_OBJECT_TYPE_RENDER_PASS:                return "VkRenderPass";
+        case VK_OBJECT_TYPE_PIPELINE:                   return "VkPipeline";
+        case VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT:      return "VkDescriptorSetLayout";
+        case VK_OBJECT_TYPE_SAMPLER:                    return "VkSampler";
+        case VK_OBJECT_TYPE_DESCRIPTOR_POOL:            return "VkDescriptorPool";
+        case VK_OBJECT_TYPE_DESCRIPTOR_SET:             return "VkDescriptorSet";
+        case VK_OBJECT_TYPE_FRAMEBUFFER:                return "VkFramebuffer";
+        case VK_OBJECT_TYPE_COMMAND_POOL:               return "VkCommandPool";
+        case VK_OBJECT_TYPE_SURFACE_KHR:                return "VkSurfaceKHR";
+        case VK_OBJECT_TYPE_SWAPCHAIN_KHR:              return "VkSwapchainKHR";
+        case VK_OBJECT_TYPE_DEBUG_UTILS_MESSENGER_EXT:  return "VkDebugUtilsMessengerEXT";
+    }
+}
+
+// Format a report of the live objects into 'report' (of size MAX_LOG_LEN) and reset the growth baselines (the tracker must be locked).
+// Returns false if nobody would recieve a report of the given severity, in which case nothing is written.
+// The report is dispatched by the caller once the tracker is unlocked, so that debug callbacks can safely use the tracker.
+//
+static bool _oriFormatLiveObjectReport(
+    char *report,
+    const unsigned int maxCount,
+    const oriSeverityBit_t severity
+) {
+    const bool interested = _oriCheckDebugInterest(severity, ORION_DEBUG_CATEGORY_GENERAL_BIT);
+
+    if (interested) {
+        int len = snprintf(report, MAX_LOG_LEN, "%" PRId64 " live objects (%" PRId64 " bytes) tracked, %+" PRId64 " since last report",
+            _orion.tracker.liveObjects, _orion.tracker.liveBytes, _orion.tracker.liveObjects - _orion.tracker.liveAtLastReport
+        );
+
+        // live objects and growth of each type
+        for (unsigned int i = 0; i < _orion.tracker.typeCount && len > 0 && len < MAX_LOG_LEN; i++) {
+            const _oriTrackedType_t *trackedType = &_orion.tracker.types[i];
+            if (!trackedType->live && !trackedType->liveAtLastReport) {
+                continue;
+            }
+
+            len += snprintf(report + len, MAX_LOG_LEN - len, "\n\t%s: %" PRId64 " live (%" PRId64 " bytes, %+" PRId64 ")",
+                _oriStringifyObjectType(trackedType->type), trackedType->live, trackedType->bytes, trackedType->live - trackedType->liveAtLastReport
+            );
+        }
+
+        // individual objects
+        unsigned int i = 0;
+        _oriTrackedObject_t *cur, *tmp;
+        HASH_ITER(hh, _orion.tracker.live, cur, tmp) {
+            if (i >= maxCount || len <= 0 || len >= MAX_LOG_LEN) {
+                break;
+            }
+
+            if (cur->refs <= 0) {
+                continue;
+            }
+
+            len += snprintf(report + len, MAX_LOG_LEN - len, "\n\t[%u] %s 0x%016" PRIX64 " (%" PRIu64 " bytes, tag '%s')",
+                i, _oriStringifyObjectType((VkObjectType) cur->key.type), cur->key.handle, cur->size, (cur->tag) ? cur->tag : ""
+            );
+            i++;
+        }
+    }
+
+    _orion.tracker.liveAtLastReport = _orion.tracker.liveObjects;
+    for (unsigned int i = 0; i < _orion.tracker.typeCount; i++) {
+        _orion.tracker.types[i].liveAtLastReport = _orion.tracker.types[i].live;
+    }
+
+    return interested;
+}
+
+void _oriTerminateObjectTracker() {
+    char report[MAX_LOG_LEN];
+    bool send = false;
+
+    _oriLockTracker();
+
+    _oriFoldTrackerBuffers();
+
+    // anything still alive at this point has been leaked
+    if (_orion.tracker.liveObjects > 0) {
+        send = _oriFormatLiveObjectReport(report, MAX_TRACKER_LEAK_REPORT_OBJECTS, ORION_DEBUG_SEVERITY_WARNING_BIT);
+    }
+
+    // stop threads from using their cached buffer pointers
+    atomic_fetch_add_explicit(&_oriTrackerEpoch, 1, memory_order_relaxed);
+
+    _oriTrackerBuffer_t *buffer = atomic_exchange(&_orion.tracker.buffers, NULL);
+    while (buffer) {
+        _oriTrackerBuffer_t *nextBuffer = buffer->next;
+
+        _oriTrackerChunk_t *chunk = buffer->head;
+        while (chunk) {
+            _oriTrackerChunk_t *nextChunk = atomic_load(&chunk->next);
+            free(chunk);
+            chunk = nextChunk;
+        }
+
+        free(buffer);
+        buffer = nextBuffer;
+    }
+
+    _oriTrackedObject_t *cur, *tmp;
+    HASH_ITER(hh, _orion.tracker.live, cur, tmp) {
+        HASH_DELETE(hh, _orion.tracker.live, cur);
+        free(cur);
+    }
+
+    _oriUnlockTracker();
+
+    if (send) {
+        _oriDispatchDebugMessage("", 0x0, report, ORION_DEBUG_SEVERITY_WARNING_BIT, ORION_DEBUG_CATEGORY_GENERAL_BIT);
+    }
+}
+
+
+// ============================================================================ //
+// *****                  Orion library public interface                  ***** //
+// ============================================================================ //
+
+
+// ----[Orion library public interface]---------------------------------------- //
+//                                   Debugging                                  //
+
+const oriReturnStatus_t oriSetObjectTrackingEnabled(
+    const bool enabled
+) {
+    atomic_store(&_orion.tracker.enabled, enabled);
+
+#   ifdef __oridebug
+        _oriLog("object tracking %s (%s)", (enabled) ? "enabled" : "disabled", __func__);
+#   endif
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+const oriReturnStatus_t oriSetObjectTrackerTag(
+    const char *tag
+) {
+    _oriLocalTrackerTag = tag;
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+const oriReturnStatus_t oriGetObjectTrackerStats(
+    oriObjectTrackerStats_t *statsOut
+) {
+    if (!statsOut) {
+        _oriWarning("all output variables NULL in call to %s", __func__);
+        return ORION_RETURN_STATUS_NO_OUTPUT;
+    }
+
+    _oriLockTracker();
+
+    _oriFoldTrackerBuffers();
+
+    statsOut->liveObjects = (_orion.tracker.liveObjects > 0) ? (uint64_t) _orion.tracker.liveObjects : 0;
+    statsOut->liveBytes = (_orion.tracker.liveBytes > 0) ? (uint64_t) _orion.tracker.liveBytes : 0;
+    statsOut->totalCreated = _orion.tracker.totalCreated;
+    statsOut->totalDestroyed = _orion.tracker.totalDestroyed;
+    statsOut->growth = _orion.tracker.liveObjects - _orion.tracker.liveAtLastReport;
+
+    _oriUnlockTracker();
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+const oriReturnStatus_t oriReportLiveObjects(
+    const unsigned int maxCount
+) {
+    char report[MAX_LOG_LEN];
+
+    _oriLockTracker();
+
+    _oriFoldTrackerBuffers();
+    const bool send = _oriFormatLiveObjectReport(report, maxCount, ORION_DEBUG_SEVERITY_NOTIF_BIT);
+
+    _oriUnlockTracker();
+
+    if (send) {
+        _oriDispatchDebugMessage("", 0x0, report, ORION_DEBUG_SEVERITY_NOTIF_BIT, ORION_DEBUG_CATEGORY_GENERAL_BIT);
+    }
+
+    return ORION_RETURN_STATUS_OK;
+}
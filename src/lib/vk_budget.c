@@ -0,0 +1,499 @@
+/* *************************************************************************************** */
+/*                       ORION GRAPHICS LIBRARY AND RENDERING ENGINE                       */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+
+// ============================================================================ //
+// *****                     Doxygen file information                     ***** //
+// ============================================================================ //
+
+/**
+ * @file vk_budget.c
+ * @author jack bennett
+ * @brief Device memory budgets and residency
+ *
+ * @copyright Copyright (c) 2022 jack bennett
+ *
+ * This file contains the budget tracking of the memory manager of each logical device, which
+ * compares the usage of each memory heap with the budget reported by VK_EXT_memory_budget
+ * (or a fraction of the heap's size, without it), and the residency manager, which asks the
+ * application to evict allocations from heaps that get close to their budget.
+ *
+ * Memory is only given back to the device when a whole block is released, so allocations are
+ * evicted a block at a time: only blocks whose allocations are all evictable, starting from
+ * the least recently used (a block counts as used when any of its allocations is).
+ *
+ */
+
+#include "orion.h"
+#include "orion_errors.h"
+#include "orion_flags.h"
+#include "orion_funcs.h"
+#include "orion_structs.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+
+
+// ============================================================================ //
+// *****                     Private/internal systems                     ***** //
+// ============================================================================ //
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                           Memory budget and residency                        //
+
+// An allocation chosen to be evicted, copied out of its chunk so the callback can be called without the memory lock held.
+//
+typedef struct _oriEviction_t {
+    oriHandle_t allocation;
+    VkDeviceSize size;
+    oriEvictionCallbackfun callback;
+    void *userData;
+} _oriEviction_t;
+
+// Estimate the current usage of a heap by the whole process (the memory lock must be held).
+//
+static VkDeviceSize _oriGetHeapUsage(
+    const _oriMemoryManager_t *manager,
+    const uint32_t heap
+) {
+    // (the usage reported at the last query, adjusted by what has been allocated and freed since)
+    return manager->heapUsageAtRefresh[heap] + manager->heapAllocated[heap] - manager->heapAllocatedAtRefresh[heap];
+}
+
+// Returns true if a heap is over the eviction threshold of its budget, and its usage has changed since the budget was last
+// enforced (the memory lock must be held).
+//
+static bool _oriIsHeapOverBudget(
+    const _oriMemoryManager_t *manager,
+    const uint32_t heap
+) {
+    const VkDeviceSize usage = _oriGetHeapUsage(manager, heap);
+
+    return usage > manager->heapBudget[heap] * MEMORY_BUDGET_EVICTION_THRESHOLD && usage != manager->heapUsageAtEnforce[heap];
+}
+
+// Query the budget of each heap again, and work out whether any heap is over the eviction threshold (the memory lock must be held).
+//
+static void _oriRefreshMemoryBudget(
+    _oriVkDevice_t *device
+) {
+    _oriMemoryManager_t *manager = &device->memory;
+
+    if (manager->budgetExtension) {
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT budget = {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT
+        };
+
+        VkPhysicalDeviceMemoryProperties2 properties = {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2,
+            .pNext = &budget
+        };
+
+        vkGetPhysicalDeviceMemoryProperties2(device->physicalDevice, &properties);
+
+        memcpy(manager->heapBudget, budget.heapBudget, sizeof(manager->heapBudget));
+        memcpy(manager->heapUsageAtRefresh, budget.heapUsage, sizeof(manager->heapUsageAtRefresh));
+    } else {
+        // without the extension, only the manager's own allocations are known about
+        for (uint32_t i = 0; i < manager->properties.memoryHeapCount; i++) {
+            manager->heapBudget[i] = (VkDeviceSize) (manager->properties.memoryHeaps[i].size * MEMORY_BUDGET_FALLBACK_FRACTION);
+            manager->heapUsageAtRefresh[i] = manager->heapAllocated[i];
+        }
+    }
+
+    memcpy(manager->heapAllocatedAtRefresh, manager->heapAllocated, sizeof(manager->heapAllocatedAtRefresh));
+    manager->refreshCountdown = MEMORY_BUDGET_REFRESH_INTERVAL;
+
+    bool overBudget = false;
+    for (uint32_t i = 0; i < manager->properties.memoryHeapCount; i++) {
+        overBudget |= _oriIsHeapOverBudget(manager, i);
+    }
+
+    atomic_store(&manager->overBudget, overBudget);
+}
+
+void _oriInitMemoryBudget(
+    _oriVkDevice_t *device
+) {
+    _oriMemoryManager_t *manager = &device->memory;
+
+    // (the budget is queried with vkGetPhysicalDeviceMemoryProperties2(), so the extension is only used with Vulkan 1.1)
+    manager->budgetExtension = false;
+    for (unsigned int i = 0; device->vulkan11 && i < device->extensionCount; i++) {
+        manager->budgetExtension |= !strcmp(device->extensions[i], VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    }
+
+    atomic_init(&manager->overBudget, false);
+    _oriRefreshMemoryBudget(device);
+}
+
+void _oriAccountDeviceMemory(
+    _oriVkDevice_t *device,
+    const uint32_t memoryTypeIndex,
+    const VkDeviceSize size,
+    const bool allocated
+) {
+    _oriMemoryManager_t *manager = &device->memory;
+    const uint32_t heap = manager->properties.memoryTypes[memoryTypeIndex].heapIndex;
+
+    if (allocated) {
+        manager->heapAllocated[heap] += size;
+    } else {
+        manager->heapAllocated[heap] -= size;
+    }
+
+    if (!--manager->refreshCountdown) {
+        _oriRefreshMemoryBudget(device);
+    } else if (allocated && _oriIsHeapOverBudget(manager, heap)) {
+        atomic_store(&manager->overBudget, true);
+    }
+}
+
+void _oriClearEvictable(
+    _oriMemoryManager_t *manager,
+    _oriMemoryChunk_t *chunk
+) {
+    chunk->evictionCallback = NULL;
+    chunk->evictionUserData = NULL;
+
+    manager->evictableCount--;
+}
+
+void _oriReplaceEvictable(
+    _oriMemoryChunk_t *chunk,
+    _oriMemoryChunk_t *replacement
+) {
+    replacement->evictionCallback = chunk->evictionCallback;
+    replacement->evictionUserData = chunk->evictionUserData;
+    replacement->lastUse = chunk->lastUse;
+
+    chunk->evictionCallback = NULL;
+    chunk->evictionUserData = NULL;
+}
+
+// A block whose allocations are all evictable, so that evicting them releases it.
+//
+typedef struct _oriEvictableBlock_t {
+    _oriMemoryBlock_t *block;
+    uint64_t lastUse; // the latest use of any of its allocations
+} _oriEvictableBlock_t;
+
+// Find out whether evicting every allocation in a block would release it (the memory lock must be held).
+// Returns false if any allocation in it isn't evictable; otherwise, returns true and gives the latest use of its allocations.
+//
+static bool _oriIsBlockEvictable(
+    const _oriMemoryBlock_t *block,
+    uint64_t *lastUseOut
+) {
+    if (!block->allocationCount) {
+        return false;
+    }
+
+    // (retired chunks are never evictable, so blocks waiting for the defragmenter are skipped too)
+    uint64_t lastUse = 0;
+    for (const _oriMemoryChunk_t *chunk = block->firstChunk; chunk; chunk = chunk->nextPhysical) {
+        if (chunk->free) {
+            continue;
+        }
+        if (!chunk->evictionCallback) {
+            return false;
+        }
+
+        if (chunk->lastUse > lastUse) {
+            lastUse = chunk->lastUse;
+        }
+    }
+
+    *lastUseOut = lastUse;
+    return true;
+}
+
+// qsort() comparison function to order evictable blocks from the least recently used, then by the memory in use in them.
+//
+static int _oriCompareEvictableBlocks(
+    const void *a,
+    const void *b
+) {
+    const _oriEvictableBlock_t *ba = a;
+    const _oriEvictableBlock_t *bb = b;
+
+    if (ba->lastUse != bb->lastUse) {
+        return (ba->lastUse < bb->lastUse) ? -1 : 1;
+    }
+
+    return (ba->block->allocatedSize > bb->block->allocatedSize) - (ba->block->allocatedSize < bb->block->allocatedSize);
+}
+
+// List the blocks of a memory type that would be released by evicting their allocations (the memory lock must be held).
+// Returns the amount of blocks listed.
+//
+static unsigned int _oriListEvictableBlocks(
+    _oriMemoryManager_t *manager,
+    const uint32_t memoryTypeIndex,
+    _oriEvictableBlock_t *blocksOut
+) {
+    unsigned int count = 0;
+    bool keptBlock = false; // true if a sub-allocated block of the type will be left after evicting the listed ones
+    _oriEvictableBlock_t *fullest = NULL;
+
+    for (_oriMemoryBlock_t *block = manager->blocks[memoryTypeIndex]; block; block = block->next) {
+        uint64_t lastUse;
+        if (!_oriIsBlockEvictable(block, &lastUse)) {
+            keptBlock |= !block->dedicated;
+            continue;
+        }
+
+        blocksOut[count] = (_oriEvictableBlock_t) {
+            .block = block,
+            .lastUse = lastUse
+        };
+        if (!block->dedicated && (!fullest || block->allocatedSize > fullest->block->allocatedSize)) {
+            fullest = &blocksOut[count];
+        }
+        count++;
+    }
+
+    // the last sub-allocated block of each memory type is never released (see _oriReleaseChunk()), so if every one is listed,
+    // the fullest is left off
+    if (!keptBlock && fullest) {
+        *fullest = blocksOut[--count];
+    }
+
+    return count;
+}
+
+void _oriEnforceMemoryBudget(
+    _oriVkDevice_t *device,
+    const oriHandle_t deviceHandle
+) {
+    _oriMemoryManager_t *manager = &device->memory;
+
+    mtx_lock(&manager->lock);
+
+    _oriRefreshMemoryBudget(device);
+    if (!atomic_load(&manager->overBudget) || !manager->evictableCount) {
+        mtx_unlock(&manager->lock);
+        return;
+    }
+
+    // (a block can hold no more evictable allocations than there are)
+    _oriEvictableBlock_t *blocks = malloc(manager->deviceMemoryCount * sizeof(_oriEvictableBlock_t));
+    _oriEviction_t *evictions = malloc(manager->evictableCount * sizeof(_oriEviction_t));
+    if (!blocks || !evictions) {
+        mtx_unlock(&manager->lock);
+
+        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+        return;
+    }
+
+    // how much has to be released from each heap to get back under the threshold
+    // Usage only goes down when whole blocks are released, so nothing is evicted unless it empties a block.
+    VkDeviceSize excess[VK_MAX_MEMORY_HEAPS] = { 0 };
+    for (uint32_t i = 0; i < manager->properties.memoryHeapCount; i++) {
+        const VkDeviceSize usage = _oriGetHeapUsage(manager, i);
+        const VkDeviceSize target = (VkDeviceSize) (manager->heapBudget[i] * MEMORY_BUDGET_EVICTION_THRESHOLD);
+
+        excess[i] = (usage > target) ? usage - target : 0;
+        manager->heapUsageAtEnforce[i] = usage;
+    }
+
+    unsigned int blockCount = 0;
+    for (uint32_t i = 0; i < manager->properties.memoryTypeCount; i++) {
+        if (excess[manager->properties.memoryTypes[i].heapIndex]) {
+            blockCount += _oriListEvictableBlocks(manager, i, &blocks[blockCount]);
+        }
+    }
+
+    // empty blocks from the least recently used (blocks last used at the same time, from the one with the least memory in use)
+    qsort(blocks, blockCount, sizeof(_oriEvictableBlock_t), _oriCompareEvictableBlocks);
+
+    unsigned int evictionCount = 0;
+    VkDeviceSize releasedBytes = 0;
+    for (unsigned int i = 0; i < blockCount; i++) {
+        const _oriMemoryBlock_t *block = blocks[i].block;
+        const uint32_t heap = manager->properties.memoryTypes[block->memoryTypeIndex].heapIndex;
+        if (!excess[heap]) {
+            continue;
+        }
+
+        for (const _oriMemoryChunk_t *chunk = block->firstChunk; chunk; chunk = chunk->nextPhysical) {
+            if (!chunk->free) {
+                evictions[evictionCount++] = (_oriEviction_t) {
+                    .allocation = chunk->handle,
+                    .size = chunk->size,
+                    .callback = chunk->evictionCallback,
+                    .userData = chunk->evictionUserData
+                };
+            }
+        }
+
+        excess[heap] = (excess[heap] > block->size) ? excess[heap] - block->size : 0;
+        releasedBytes += block->size;
+    }
+
+    // enforcing the budget again would release nothing more until the usage of a heap changes
+    atomic_store(&manager->overBudget, false);
+
+    mtx_unlock(&manager->lock);
+
+    free(blocks);
+
+    // (the callbacks will most likely free the allocations, which needs the lock)
+    unsigned int evictedCount = 0;
+    for (unsigned int i = 0; i < evictionCount; i++) {
+        evictedCount += evictions[i].callback(deviceHandle, evictions[i].allocation, evictions[i].size, evictions[i].userData);
+    }
+
+    free(evictions);
+
+#   ifdef __oridebug
+        _oriWarning("memory budget exceeded: %u of %u evictable allocation%s evicted to release up to %llu bytes (%s)", evictedCount,
+            evictionCount, (evictionCount == 1) ? "" : "s", (unsigned long long) releasedBytes, __func__);
+#   else
+        (void) evictedCount;
+        (void) releasedBytes;
+#   endif
+}
+
+
+// ============================================================================ //
+// *****                   Orion library public interface                 ***** //
+// ============================================================================ //
+
+
+// ----[Orion library public interface]---------------------------------------- //
+//                           Vulkan memory management                           //
+
+const oriReturnStatus_t oriGetMemoryBudget(
+    const oriHandle_t device,
+    oriMemoryBudget_t *budgetOut
+) {
+    if (!budgetOut) {
+        _oriWarning("all output variables NULL in call to %s", __func__);
+        return ORION_RETURN_STATUS_NO_OUTPUT;
+    }
+
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriMemoryManager_t *manager = &record->memory;
+
+    memset(budgetOut, 0, sizeof(oriMemoryBudget_t));
+
+    mtx_lock(&manager->lock);
+
+    _oriRefreshMemoryBudget(record);
+
+    budgetOut->heapCount = manager->properties.memoryHeapCount;
+    budgetOut->budgetExtension = manager->budgetExtension;
+
+    for (uint32_t i = 0; i < manager->properties.memoryHeapCount; i++) {
+        budgetOut->heaps[i].budget = manager->heapBudget[i];
+        budgetOut->heaps[i].usage = _oriGetHeapUsage(manager, i);
+        budgetOut->heaps[i].blockBytes = manager->heapAllocated[i];
+    }
+
+    for (uint32_t i = 0; i < manager->properties.memoryTypeCount; i++) {
+        const uint32_t heap = manager->properties.memoryTypes[i].heapIndex;
+
+        for (const _oriMemoryBlock_t *block = manager->blocks[i]; block; block = block->next) {
+            budgetOut->heaps[heap].allocationBytes += block->allocatedSize;
+        }
+    }
+
+    mtx_unlock(&manager->lock);
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+const oriReturnStatus_t oriSetAllocationEvictable(
+    const oriHandle_t device,
+    const oriHandle_t allocation,
+    const oriEvictionCallbackfun callback,
+    void *userData
+) {
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    mtx_lock(&record->memory.lock);
+
+    oriReturnStatus_t status = ORION_RETURN_STATUS_ERROR;
+    _oriMemoryChunk_t *chunk = _oriGetAllocation(record, allocation, __func__);
+    if (chunk) {
+        if (chunk->evictionCallback) {
+            _oriClearEvictable(&record->memory, chunk);
+        }
+
+        // (newly evictable allocations count as just used)
+        if (callback) {
+            chunk->evictionCallback = callback;
+            chunk->evictionUserData = userData;
+            chunk->lastUse = ++record->memory.useCounter;
+            record->memory.evictableCount++;
+        }
+
+        status = ORION_RETURN_STATUS_OK;
+    }
+
+    mtx_unlock(&record->memory.lock);
+
+    return status;
+}
+
+const oriReturnStatus_t oriTouchAllocation(
+    const oriHandle_t device,
+    const oriHandle_t allocation
+) {
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriMemoryManager_t *manager = &record->memory;
+
+    mtx_lock(&manager->lock);
+
+    oriReturnStatus_t status = ORION_RETURN_STATUS_ERROR;
+    _oriMemoryChunk_t *chunk = _oriGetAllocation(record, allocation, __func__);
+    if (chunk) {
+        if (chunk->evictionCallback) {
+            chunk->lastUse = ++manager->useCounter;
+        }
+
+        status = ORION_RETURN_STATUS_OK;
+    }
+
+    mtx_unlock(&manager->lock);
+
+    return status;
+}
+
+const oriReturnStatus_t oriEnforceMemoryBudget(
+    const oriHandle_t device
+) {
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriEnforceMemoryBudget(record, device);
+
+    return ORION_RETURN_STATUS_OK;
+}
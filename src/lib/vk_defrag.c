@@ -0,0 +1,300 @@
+/* *************************************************************************************** */
+/*                       ORION GRAPHICS LIBRARY AND RENDERING ENGINE                       */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+
+// ============================================================================ //
+// *****                     Doxygen file information                     ***** //
+// ============================================================================ //
+
+/**
+ * @file vk_defrag.c
+ * @author jack bennett
+ * @brief Device memory defragmentation
+ *
+ * @copyright Copyright (c) 2022 jack bennett
+ *
+ * This file contains the incremental defragmenter of the memory manager of each logical
+ * device. Each pass picks the emptiest block of every memory type that has more than one,
+ * and moves buffers owned by allocations out of it into the other blocks (copying them on
+ * the GPU, up to a budget of bytes per pass) so that it can eventually be released.
+ *
+ * The handle of a moved allocation is pointed at its new chunk straight away; the old chunk
+ * and buffer are kept until the GPU has finished with them.
+ *
+ */
+
+#include "orion.h"
+#include "orion_errors.h"
+#include "orion_funcs.h"
+#include "orion_structs.h"
+
+#include <threads.h>
+
+
+// ============================================================================ //
+// *****                     Private/internal systems                     ***** //
+// ============================================================================ //
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                                Defragmentation                               //
+
+// Release the old chunks (and buffers) of moved allocations once the GPU has finished with them (the memory lock must be held).
+//
+static void _oriReleaseRetiredChunks(
+    _oriVkDevice_t *device,
+    const uint64_t completedValue
+) {
+    _oriMemoryManager_t *manager = &device->memory;
+
+    _oriMemoryChunk_t **cur = &manager->retiredChunks;
+    while (*cur) {
+        _oriMemoryChunk_t *chunk = *cur;
+        if (chunk->retireValue > completedValue) {
+            cur = &chunk->nextFree;
+            continue;
+        }
+
+        *cur = chunk->nextFree;
+        manager->defragStats.pendingReleases--;
+
+        const VkDeviceSize released = _oriReleaseChunk(device, chunk);
+        if (released) {
+            manager->defragStats.releasedBlocks++;
+            manager->defragStats.releasedBytes += released;
+        }
+    }
+}
+
+// Returns true if a block holds an allocation that can be moved.
+//
+static bool _oriHasMovableChunks(
+    const _oriMemoryBlock_t *block
+) {
+    for (const _oriMemoryChunk_t *chunk = block->firstChunk; chunk; chunk = chunk->nextPhysical) {
+        if (!chunk->free && chunk->movable && !chunk->retired) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Choose the block of a memory type to move allocations out of: the one with the least memory in use that has anything movable
+// in it. Returns NULL if the memory type has less than two blocks (so there is nowhere to move anything to).
+//
+static _oriMemoryBlock_t *_oriChooseDefragmentSource(
+    const _oriMemoryManager_t *manager,
+    const uint32_t memoryTypeIndex
+) {
+    if (!manager->blocks[memoryTypeIndex] || !manager->blocks[memoryTypeIndex]->next) {
+        return NULL;
+    }
+
+    _oriMemoryBlock_t *source = NULL;
+    for (_oriMemoryBlock_t *block = manager->blocks[memoryTypeIndex]; block; block = block->next) {
+        if ((!source || block->allocatedSize < source->allocatedSize) && _oriHasMovableChunks(block)) {
+            source = block;
+        }
+    }
+
+    return source;
+}
+
+// Move an allocation to a chunk in any block of its memory type other than its own, recording the copy into a command buffer
+// (the memory lock must be held).
+// Returns false if there is no room for it or if its new buffer could not be created.
+//
+static bool _oriMoveChunk(
+    _oriVkDevice_t *device,
+    _oriMemoryChunk_t *chunk,
+    const VkCommandBuffer commandBuffer,
+    const uint64_t frameValue
+) {
+    _oriMemoryManager_t *manager = &device->memory;
+
+    if (!_oriReserveChunks(manager, 2)) {
+        return false;
+    }
+
+    // (new blocks are never allocated for this, as that would defeat the point)
+    _oriMemoryChunk_t *moved = NULL;
+    for (_oriMemoryBlock_t *block = manager->blocks[chunk->block->memoryTypeIndex]; !moved && block; block = block->next) {
+        if (block != chunk->block) {
+            moved = _oriAllocateFromBlock(manager, block, chunk->size, chunk->alignment);
+        }
+    }
+    if (!moved) {
+        return false;
+    }
+
+    const VkBufferCreateInfo bufferInfo = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .flags = chunk->bufferFlags,
+        .size = chunk->bufferSize,
+        .usage = chunk->bufferUsage,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+    };
+
+    VkBuffer buffer;
+    if (vkCreateBuffer(device->handle, &bufferInfo, _orion.callbacks.vulkanAllocators, &buffer)) {
+        _oriReleaseChunk(device, moved);
+        return false;
+    }
+
+    _oriTrackObjectCreation(VK_OBJECT_TYPE_BUFFER, _ORI_NON_DISPATCHABLE_HANDLE_U64(buffer), chunk->bufferSize);
+
+    if (vkBindBufferMemory(device->handle, buffer, moved->block->memory, moved->offset)) {
+        _oriTrackObjectDestruction(VK_OBJECT_TYPE_BUFFER, _ORI_NON_DISPATCHABLE_HANDLE_U64(buffer));
+        vkDestroyBuffer(device->handle, buffer, _orion.callbacks.vulkanAllocators);
+
+        _oriReleaseChunk(device, moved);
+        return false;
+    }
+
+    const VkBufferCopy region = {
+        .size = chunk->bufferSize
+    };
+
+    vkCmdCopyBuffer(commandBuffer, chunk->buffer, buffer, 1, &region);
+
+    // the handle now refers to the new chunk
+    moved->handle = chunk->handle;
+    moved->alignment = chunk->alignment;
+    moved->buffer = buffer;
+    moved->bufferSize = chunk->bufferSize;
+    moved->bufferUsage = chunk->bufferUsage;
+    moved->bufferFlags = chunk->bufferFlags;
+    moved->movable = true;
+
+    if (chunk->evictionCallback) {
+        _oriReplaceEvictable(chunk, moved);
+    }
+
+    _oriReplaceHandleRecord(&manager->allocations, chunk->handle, moved);
+
+    // and the old one waits for the GPU to finish with it (and the copy)
+    chunk->handle = ORION_NULL_HANDLE;
+    chunk->retired = true;
+    chunk->retireValue = frameValue;
+    chunk->nextFree = manager->retiredChunks;
+    manager->retiredChunks = chunk;
+
+    manager->defragStats.movedAllocations++;
+    manager->defragStats.movedBytes += chunk->size;
+    manager->defragStats.pendingReleases++;
+
+    return true;
+}
+
+
+// ============================================================================ //
+// *****                   Orion library public interface                 ***** //
+// ============================================================================ //
+
+
+// ----[Orion library public interface]---------------------------------------- //
+//                           Vulkan memory management                           //
+
+const oriReturnStatus_t oriDefragment(
+    const oriHandle_t device,
+    const VkCommandBuffer commandBuffer,
+    const VkDeviceSize maxBytes,
+    const uint64_t frameValue,
+    const uint64_t completedValue,
+    oriDefragmentStats_t *statsOut
+) {
+    if (_ORI_CONTRACT_BROKEN(!commandBuffer)) {
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriMemoryManager_t *manager = &record->memory;
+
+    mtx_lock(&manager->lock);
+
+    _oriReleaseRetiredChunks(record, completedValue);
+
+    VkDeviceSize movedBytes = 0;
+    unsigned int movedCount = 0;
+    bool budgetLeft = true;
+
+    for (uint32_t i = 0; budgetLeft && i < manager->properties.memoryTypeCount; i++) {
+        _oriMemoryBlock_t *source = _oriChooseDefragmentSource(manager, i);
+        if (!source) {
+            continue;
+        }
+
+        // (chunks are never removed from the source block here, as moved chunks are retired rather than freed)
+        for (_oriMemoryChunk_t *chunk = source->firstChunk; chunk; chunk = chunk->nextPhysical) {
+            if (chunk->free || !chunk->movable || chunk->retired) {
+                continue;
+            }
+
+            if (movedBytes + chunk->size > maxBytes) {
+                budgetLeft = false;
+                break;
+            }
+
+            // make the copies wait for anything that might still be writing to the buffers
+            if (!movedCount) {
+                const VkMemoryBarrier barrier = {
+                    .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+                    .srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT,
+                    .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT
+                };
+
+                vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, NULL, 0, NULL);
+            }
+
+            const VkDeviceSize size = chunk->size;
+            if (!_oriMoveChunk(record, chunk, commandBuffer, frameValue)) {
+                break;
+            }
+
+            movedBytes += size;
+            movedCount++;
+        }
+    }
+
+    // and make anything after the copies wait for them
+    if (movedCount) {
+        const VkMemoryBarrier barrier = {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT
+        };
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &barrier, 0, NULL, 0, NULL);
+    }
+
+    if (statsOut) {
+        *statsOut = manager->defragStats;
+    }
+
+    mtx_unlock(&manager->lock);
+
+#   ifdef __oridebug
+        if (movedCount) {
+            _oriLog("defragmentation moved %u allocation%s (%llu bytes) (%s)", movedCount, (movedCount == 1) ? "" : "s",
+                (unsigned long long) movedBytes, __func__);
+        }
+#   endif
+
+    return ORION_RETURN_STATUS_OK;
+}
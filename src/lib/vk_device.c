@@ -35,7 +35,328 @@
 #include "orion_funcs.h"
 #include "orion_structs.h"
 
+#include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// ============================================================================ //
+// *****                     Private/internal systems                     ***** //
+// ============================================================================ //
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                          Vulkan device management                            //
+
+// Enumerate the physical devices accessible to an instance into a newly-allocated array (NULL if there are none).
+// Returns non-zero (after sending an error) if Vulkan failed to enumerate the devices.
+//
+static int _oriEnumeratePhysicalDevices(
+    const _oriVkInstance_t *instance,
+    unsigned int *countOut,
+    VkPhysicalDevice **devicesOut
+) {
+    *countOut = 0;
+    *devicesOut = NULL;
+
+    unsigned int c;
+    if (vkEnumeratePhysicalDevices(instance->handle, &c, NULL)) {
+        _oriError(ORIERR_VULKAN_QUERY_FAIL, __func__);
+        return 1;
+    }
+
+    if (!c) {
+        // no vulkan-supported GPUs were found
+#       ifdef __oridebug
+            _oriWarning("couldn't find any physical devices with Vulkan support (%s)", __func__);
+#       endif
+
+        return 0;
+    }
+
+    VkPhysicalDevice *d = malloc(c * sizeof(VkPhysicalDevice));
+    if (!d) {
+        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+        return 1;
+    }
+
+    if (vkEnumeratePhysicalDevices(instance->handle, &c, d)) {
+        free(d);
+        d = NULL;
+
+        _oriError(ORIERR_VULKAN_QUERY_FAIL, __func__);
+        return 1;
+    }
+
+    *countOut = c;
+    *devicesOut = d;
+
+    return 0;
+}
+
+// Count how many of the given extension names are in an array of extension properties.
+//
+static unsigned int _oriCountSupportedExtensions(
+    const unsigned int availableCount,
+    const VkExtensionProperties *available,
+    const unsigned int count,
+    const char **names
+) {
+    unsigned int supported = 0;
+
+    for (unsigned int i = 0; i < count; i++) {
+        for (unsigned int j = 0; j < availableCount; j++) {
+            if (!strcmp(available[j].extensionName, names[i])) {
+                supported++;
+                break;
+            }
+        }
+    }
+
+    return supported;
+}
+
+static float _oriClampUnit(
+    const float x
+) {
+    return (x > 1.0f) ? 1.0f : (x < 0.0f) ? 0.0f : x;
+}
+
+// Query the properties of a physical device and score it with the model described in rankInfo.
+// Returns false if the device does not support all of the required extensions.
+//
+static bool _oriScorePhysicalDevice(
+    const VkPhysicalDevice device,
+    const unsigned int enumerationIndex,
+    const oriPhysicalDeviceRankInfo_t *rankInfo,
+    oriRankedPhysicalDevice_t *out
+) {
+    memset(out, 0, sizeof(oriRankedPhysicalDevice_t));
+    out->device = device;
+    out->enumerationIndex = enumerationIndex;
+
+    // extensions are checked first so that no more queries are made for excluded devices
+    if (rankInfo->requiredExtensionCount || rankInfo->preferredExtensionCount) {
+        unsigned int extCount = 0;
+        vkEnumerateDeviceExtensionProperties(device, NULL, &extCount, NULL);
+
+        VkExtensionProperties *exts = malloc((extCount ? extCount : 1) * sizeof(VkExtensionProperties));
+        if (!exts) {
+            _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+            return false;
+        }
+        vkEnumerateDeviceExtensionProperties(device, NULL, &extCount, exts);
+
+        const unsigned int required = _oriCountSupportedExtensions(extCount, exts, rankInfo->requiredExtensionCount, rankInfo->requiredExtensions);
+        out->preferredExtensionCount = _oriCountSupportedExtensions(extCount, exts, rankInfo->preferredExtensionCount, rankInfo->preferredExtensions);
+
+        free(exts);
+        exts = NULL;
+
+        if (required < rankInfo->requiredExtensionCount) {
+            return false;
+        }
+    }
+
+    vkGetPhysicalDeviceProperties(device, &out->properties);
+    vkGetPhysicalDeviceMemoryProperties(device, &out->memoryProperties);
+
+    // device type
+    float typeScore;
+    switch (out->properties.deviceType) {
+        case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:      typeScore = 1.0f;   break;
+        case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:    typeScore = 0.5f;   break;
+        case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:       typeScore = 0.35f;  break;
+        case VK_PHYSICAL_DEVICE_TYPE_CPU:               typeScore = 0.1f;   break;
+        default:                                        typeScore = 0.0f;   break;
+    }
+
+    // device-local memory (log scale, so that the difference between 2 and 4 GiB counts as much as between 8 and 16 GiB)
+    for (unsigned int i = 0; i < out->memoryProperties.memoryHeapCount; i++) {
+        if (out->memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+            out->deviceLocalMemory += out->memoryProperties.memoryHeaps[i].size;
+        }
+    }
+    const float memoryScore = _oriClampUnit(log2f(1.0f + (float) (out->deviceLocalMemory >> 20)) / log2f(1.0f + (float) (64u << 10)));
+
+    // queue family richness
+    vkGetPhysicalDeviceQueueFamilyProperties(device, &out->queueFamilyCount, NULL);
+
+    float queueScore = 0.0f;
+    if (out->queueFamilyCount) {
+        VkQueueFamilyProperties families[out->queueFamilyCount];
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &out->queueFamilyCount, families);
+
+        VkQueueFlags allFlags = 0;
+        for (unsigned int i = 0; i < out->queueFamilyCount; i++) {
+            const VkQueueFlags flags = families[i].queueFlags;
+            allFlags |= flags;
+
+            // compute without graphics = async compute, transfer without either = dedicated DMA engine
+            if ((flags & VK_QUEUE_COMPUTE_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT)) {
+                out->dedicatedQueueFlags |= VK_QUEUE_COMPUTE_BIT;
+            }
+            if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))) {
+                out->dedicatedQueueFlags |= VK_QUEUE_TRANSFER_BIT;
+            }
+        }
+
+        queueScore += (allFlags & VK_QUEUE_GRAPHICS_BIT) ? 0.25f : 0.0f;
+        queueScore += (out->dedicatedQueueFlags & VK_QUEUE_COMPUTE_BIT) ? 0.35f : 0.0f;
+        queueScore += (out->dedicatedQueueFlags & VK_QUEUE_TRANSFER_BIT) ? 0.3f : 0.0f;
+        queueScore += (allFlags & VK_QUEUE_SPARSE_BINDING_BIT) ? 0.1f : 0.0f;
+    }
+
+    // key limits, each relative to a value that current desktop GPUs reach
+    const VkPhysicalDeviceLimits *limits = &out->properties.limits;
+    const float limitsScore = (
+        _oriClampUnit(limits->maxImageDimension2D / 16384.0f) +
+        _oriClampUnit(limits->maxComputeSharedMemorySize / 65536.0f) +
+        _oriClampUnit(limits->maxBoundDescriptorSets / 32.0f) +
+        _oriClampUnit(limits->maxPushConstantsSize / 256.0f) +
+        _oriClampUnit(limits->maxSamplerAnisotropy / 16.0f)
+    ) / 5.0f;
+
+    // preferred extension support (every device scores the same if none were given)
+    const float extensionScore = (rankInfo->preferredExtensionCount) ? (float) out->preferredExtensionCount / rankInfo->preferredExtensionCount : 1.0f;
+
+    out->score =
+        rankInfo->weights.deviceType * typeScore +
+        rankInfo->weights.localMemory * memoryScore +
+        rankInfo->weights.queueFamilies * queueScore +
+        rankInfo->weights.limits * limitsScore +
+        rankInfo->weights.extensions * extensionScore;
+
+    if (rankInfo->scoreFun) {
+        out->score += rankInfo->scoreFun(out, rankInfo->pointer);
+    }
+
+    return true;
+}
+
+// Rank of a device type used to break ties between devices with the same score (higher is better).
+//
+static int _oriRankDeviceType(
+    const VkPhysicalDeviceType type
+) {
+    switch (type) {
+        case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:      return 4;
+        case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:    return 3;
+        case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:       return 2;
+        case VK_PHYSICAL_DEVICE_TYPE_CPU:               return 1;
+        default:                                        return 0;
+    }
+}
+
+// qsort() comparison function to sort ranked devices from best to worst.
+// Every field used is a total order, so the result does not depend on the order in which qsort() compares devices.
+//
+static int _oriCompareRankedPhysicalDevices(
+    const void *a,
+    const void *b
+) {
+    const oriRankedPhysicalDevice_t *da = a;
+    const oriRankedPhysicalDevice_t *db = b;
+
+    if (da->score != db->score) {
+        return (da->score < db->score) ? 1 : -1;
+    }
+
+    const int ta = _oriRankDeviceType(da->properties.deviceType);
+    const int tb = _oriRankDeviceType(db->properties.deviceType);
+    if (ta != tb) {
+        return tb - ta;
+    }
+
+    if (da->deviceLocalMemory != db->deviceLocalMemory) {
+        return (da->deviceLocalMemory < db->deviceLocalMemory) ? 1 : -1;
+    }
+    if (da->properties.vendorID != db->properties.vendorID) {
+        return (da->properties.vendorID < db->properties.vendorID) ? -1 : 1;
+    }
+    if (da->properties.deviceID != db->properties.deviceID) {
+        return (da->properties.deviceID < db->properties.deviceID) ? -1 : 1;
+    }
+
+    return (da->enumerationIndex < db->enumerationIndex) ? -1 : (da->enumerationIndex > db->enumerationIndex);
+}
+
+// Alignment limits are powers of two (the spec requires it), but 0 is treated as 1 so that the mask is never all ones.
+//
+static void _oriSetAlignment(
+    const VkDeviceSize alignment,
+    VkDeviceSize *alignmentOut,
+    VkDeviceSize *maskOut
+) {
+    *alignmentOut = (alignment) ? alignment : 1;
+    *maskOut = *alignmentOut - 1;
+}
+
+// Take the snapshot of the physical device limits kept on a device record, so that hot paths never need to query them.
+//
+// The limits of VK_EXT_external_memory_host are only queried if the extension is enabled and Vulkan 1.1 is available (only
+// then is vkGetPhysicalDeviceProperties2() called).
+//
+static void _oriSnapshotDeviceLimits(
+    const VkPhysicalDevice physicalDevice,
+    const bool externalMemoryHost,
+    oriDeviceLimits_t *limitsOut
+) {
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    const VkPhysicalDeviceLimits *l = &properties.limits;
+
+    VkPhysicalDeviceExternalMemoryHostPropertiesEXT hostProperties = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_MEMORY_HOST_PROPERTIES_EXT
+    };
+
+    if (externalMemoryHost) {
+        VkPhysicalDeviceProperties2 properties2 = {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+            .pNext = &hostProperties
+        };
+
+        vkGetPhysicalDeviceProperties2(physicalDevice, &properties2);
+    }
+
+    _oriSetAlignment(l->minUniformBufferOffsetAlignment, &limitsOut->uniformBufferOffsetAlignment, &limitsOut->uniformBufferOffsetMask);
+    _oriSetAlignment(l->minStorageBufferOffsetAlignment, &limitsOut->storageBufferOffsetAlignment, &limitsOut->storageBufferOffsetMask);
+    _oriSetAlignment(l->minTexelBufferOffsetAlignment, &limitsOut->texelBufferOffsetAlignment, &limitsOut->texelBufferOffsetMask);
+    _oriSetAlignment(l->nonCoherentAtomSize, &limitsOut->nonCoherentAtomSize, &limitsOut->nonCoherentAtomMask);
+    _oriSetAlignment(l->bufferImageGranularity, &limitsOut->bufferImageGranularity, &limitsOut->bufferImageGranularityMask);
+    _oriSetAlignment(l->optimalBufferCopyOffsetAlignment, &limitsOut->optimalBufferCopyOffsetAlignment, &limitsOut->optimalBufferCopyOffsetMask);
+    _oriSetAlignment(l->optimalBufferCopyRowPitchAlignment, &limitsOut->optimalBufferCopyRowPitchAlignment, &limitsOut->optimalBufferCopyRowPitchMask);
+    _oriSetAlignment(l->minMemoryMapAlignment, &limitsOut->minMemoryMapAlignment, &limitsOut->minMemoryMapMask);
+    _oriSetAlignment(hostProperties.minImportedHostPointerAlignment, &limitsOut->minImportedHostPointerAlignment,
+        &limitsOut->minImportedHostPointerMask);
+
+    limitsOut->maxMemoryAllocationCount = l->maxMemoryAllocationCount;
+    limitsOut->maxUniformBufferRange = l->maxUniformBufferRange;
+    limitsOut->maxStorageBufferRange = l->maxStorageBufferRange;
+    limitsOut->maxPushConstantsSize = l->maxPushConstantsSize;
+    limitsOut->timestampPeriod = l->timestampPeriod;
+}
+
+void _oriDestroyDeviceRecord(
+    _oriVkDevice_t *device
+) {
+    // any memory that the application didn't free has to be freed before the device is destroyed
+    _oriDestroyDeviceUploader(device);
+    _oriDestroyDeviceRing(device);
+    _oriDestroyMemoryManager(device);
+
+    _oriTrackObjectDestruction(VK_OBJECT_TYPE_DEVICE, _ORI_DISPATCHABLE_HANDLE_U64(device->handle));
+    vkDestroyDevice(device->handle, _orion.callbacks.vulkanAllocators);
+
+    _oriFreeStrings(device->extensionCount, device->extensions);
+    free(device);
+}
+
+
+// ============================================================================ //
+// *****                  Orion library public interface                  ***** //
+// ============================================================================ //
 
 
 // ----[Orion library public interface]---------------------------------------- //
@@ -43,6 +364,7 @@
 
 const oriReturnStatus_t oriCreateLogicalDevice(
     VkDevice *deviceOut,
+    oriHandle_t *handleOut,
     const VkDeviceCreateFlags deviceFlags,
     const VkPhysicalDevice physicalDevice,
     const unsigned int queueCreateInfoCount,
@@ -56,29 +378,19 @@ const oriReturnStatus_t oriCreateLogicalDevice(
         _oriWarning("all output variables NULL in call to %s", __func__);
         return ORION_RETURN_STATUS_NO_OUTPUT;
     }
-    if (!physicalDevice) { // there has to be a physical device referenced
+    if (_ORI_CONTRACT_BROKEN(!physicalDevice)) { // there has to be a physical device referenced
         _oriError(ORIERR_NULL_POINTER, __func__);
         return ORION_RETURN_STATUS_NULL_POINTER;
     }
-    if (!queueCreateInfos && queueCreateInfoCount) { // no queues specified but count is not 0
+    if (_ORI_CONTRACT_BROKEN(!queueCreateInfos && queueCreateInfoCount)) { // no queues specified but count is not 0
         _oriError(ORIERR_NULL_POINTER, __func__);
         return ORION_RETURN_STATUS_NULL_POINTER;
     }
-    if (!extensionNames && extensionCount) { // no exts given but count is not 0
+    if (_ORI_CONTRACT_BROKEN(!extensionNames && extensionCount)) { // no exts given but count is not 0
         _oriError(ORIERR_NULL_POINTER, __func__);
         return ORION_RETURN_STATUS_NULL_POINTER;
     }
 
-    // check if the given VkDevice pointer is already in the hash table of logical devices
-    {
-        _oriVkDevice_t *queryStructure;
-        HASH_FIND_PTR(_orion.allocatees.vkDevices, deviceOut, queryStructure);
-        if (queryStructure) { // uthash will have set queryStructure to NULL if it wasn't found so we can rely on this check
-            _oriWarning("orion already allocated logical device at %p (%s)", deviceOut, __func__);
-            return ORION_RETURN_STATUS_SKIPPED;
-        }
-    }
-
     // init device create-info struct
     VkDeviceCreateInfo createInfo = {};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -100,12 +412,13 @@ const oriReturnStatus_t oriCreateLogicalDevice(
         memset(logstr, 0, MAX_LOG_LEN);
 
         // we can also append the amount of queues as this won't change throughout the function
-        snprintf(logstr, MAX_LOG_LEN, "logical device created into %p (%s)\n\t%u queues requested", deviceOut, __func__, queueCreateInfoCount);
+        snprintf(logstr, MAX_LOG_LEN, "logical device created into %p (%s)\n\t%u queues requested", (void *) deviceOut, __func__, queueCreateInfoCount);
 #   endif
 
     // static array that will hold the compatible extensions
     // we are storing this in the primary function scope because they are referenced by vkCreateInstance() and so must be preserved until then.
-    const char *actualEnabledExts[extensionCount];
+    // (one extra element for VK_EXT_memory_budget, which is enabled automatically)
+    const char *actualEnabledExts[extensionCount + 1];
     unsigned int actualEnabledExtCount = 0;
 
     // validate extensions if there were any specified
@@ -123,34 +436,26 @@ const oriReturnStatus_t oriCreateLogicalDevice(
 
             // check if the current extension is provided by the Vulkan implementation
             if (oriCheckDeviceExtensionAvailability(physicalDevice, extensionNames[i], NULL)) {
-                actualEnabledExts[i] = extensionNames[i];
+                actualEnabledExts[actualEnabledExtCount] = extensionNames[i];
                 actualEnabledExtCount++;
                 provided = true;
             }
 
-            if (!provided) {
-                // iterate through each instance (there is rarely more than one so this is fine)
-                _oriVkInstance_t *cur;
-                for (cur = _orion.allocatees.vkInstances; cur != NULL; cur = cur->hh.next) {
-                    // get layers
-                    char **layers;
-                    unsigned int layerCount;
-                    if (oriEnumerateEnabledLayers(cur->handle, &layerCount, &layers)) {
-                        return ORION_RETURN_STATUS_ERROR;
-                    }
-
-                    // iterate through each of the instance's layers
-                    for (unsigned int j = 0; j < layerCount; j++) {
-                        if (oriCheckDeviceExtensionAvailability(physicalDevice, extensionNames[j], layers[j])) {
-                            actualEnabledExts[j] = extensionNames[j];
-                            actualEnabledExtCount++;
-                            provided = true;
+            // iterate through each instance (there is rarely more than one so this is fine)
+            for (unsigned int k = 0; !provided && k < _orion.allocatees.instances.used; k++) {
+                const _oriVkInstance_t *cur = _orion.allocatees.instances.records[k];
+                if (!cur) {
+                    continue;
+                }
 
-                            // set cur to NULL to break out of the nesting loop
-                            cur = NULL;
+                // iterate through each of the instance's layers
+                for (unsigned int j = 0; j < cur->layerCount; j++) {
+                    if (oriCheckDeviceExtensionAvailability(physicalDevice, extensionNames[i], cur->layers[j])) {
+                        actualEnabledExts[actualEnabledExtCount] = extensionNames[i];
+                        actualEnabledExtCount++;
+                        provided = true;
 
-                            break;
-                        }
+                        break;
                     }
                 }
             }
@@ -170,9 +475,6 @@ const oriReturnStatus_t oriCreateLogicalDevice(
 
         // pass now-filtered extension array to Vulkan
         if (actualEnabledExtCount) {
-            createInfo.enabledExtensionCount = actualEnabledExtCount;
-            createInfo.ppEnabledExtensionNames = (const char *const *) actualEnabledExts;
-
 #           ifdef __oridebug
                 // concatenate onto logstr
                 char s[MAX_LOG_LEN];
@@ -184,73 +486,184 @@ const oriReturnStatus_t oriCreateLogicalDevice(
         }
     }
 
+    // core Vulkan 1.1 functions can only be used if both the instance and the physical device have Vulkan 1.1
+    VkPhysicalDeviceProperties deviceProperties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &deviceProperties);
+    const uint32_t apiVersion = (_orion.apiVersion < deviceProperties.apiVersion) ? _orion.apiVersion : deviceProperties.apiVersion;
+    const bool vulkan11 = apiVersion >= VK_API_VERSION_1_1;
+
+    // the memory manager keeps each heap under the budget reported by VK_EXT_memory_budget, so it is enabled whenever it is available
+    // (it depends on vkGetPhysicalDeviceProperties2(), so only with Vulkan 1.1; otherwise the fallback budget is used)
+    bool memoryBudgetEnabled = false;
+    for (unsigned int i = 0; i < actualEnabledExtCount; i++) {
+        memoryBudgetEnabled |= !strcmp(actualEnabledExts[i], VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    }
+    if (vulkan11 && !memoryBudgetEnabled && oriCheckDeviceExtensionAvailability(physicalDevice, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME, NULL)) {
+        actualEnabledExts[actualEnabledExtCount++] = VK_EXT_MEMORY_BUDGET_EXTENSION_NAME;
+
+#       ifdef __oridebug
+            strncat(logstr, "\n\t" VK_EXT_MEMORY_BUDGET_EXTENSION_NAME " enabled automatically", MAX_LOG_LEN);
+#       endif
+    }
+
+    createInfo.enabledExtensionCount = actualEnabledExtCount;
+    createInfo.ppEnabledExtensionNames = (actualEnabledExtCount) ? (const char *const *) actualEnabledExts : NULL;
+
     if (vkCreateDevice(physicalDevice, &createInfo, _orion.callbacks.vulkanAllocators, deviceOut)) {
         _oriError(ORIERR_DEVICE_CREATION_FAIL, __func__);
         return ORION_RETURN_STATUS_ERROR;
     }
 
+    _oriTrackObjectCreation(VK_OBJECT_TYPE_DEVICE, _ORI_DISPATCHABLE_HANDLE_U64(*deviceOut), sizeof(_oriVkDevice_t));
+
+    // create a wrapper for the device which can be stored in _orion
+    _oriVkDevice_t *wrapper = malloc(sizeof(_oriVkDevice_t));
+    if (!wrapper) {
+        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+    wrapper->handle = *deviceOut;
+    wrapper->physicalDevice = physicalDevice;
+    wrapper->extensionCount = actualEnabledExtCount;
+    wrapper->extensions = _oriCopyStrings(actualEnabledExtCount, actualEnabledExts);
+    wrapper->vulkan11 = vulkan11;
+    wrapper->features = _oriGetChainedDeviceFeatures(deviceNext, apiVersion);
+
+    // host memory is only imported with Vulkan 1.1, as its limits are queried with vkGetPhysicalDeviceProperties2() and buffers
+    // bound to it are created with VkExternalMemoryBufferCreateInfo
+    bool externalMemoryHostEnabled = false;
+    for (unsigned int i = 0; vulkan11 && i < actualEnabledExtCount; i++) {
+        externalMemoryHostEnabled |= !strcmp(actualEnabledExts[i], VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME);
+    }
+
+    _oriSnapshotDeviceLimits(physicalDevice, externalMemoryHostEnabled, &wrapper->limits);
+    wrapper->getMemoryHostPointerProperties = (externalMemoryHostEnabled) ?
+        (PFN_vkGetMemoryHostPointerPropertiesEXT) vkGetDeviceProcAddr(*deviceOut, "vkGetMemoryHostPointerPropertiesEXT") : NULL;
+    wrapper->ring = NULL;
+    wrapper->uploader = NULL;
+
+    if (!_oriInitMemoryManager(wrapper)) {
+        _oriTrackObjectDestruction(VK_OBJECT_TYPE_DEVICE, _ORI_DISPATCHABLE_HANDLE_U64(wrapper->handle));
+        vkDestroyDevice(wrapper->handle, _orion.callbacks.vulkanAllocators);
+
+        _oriFreeStrings(wrapper->extensionCount, wrapper->extensions);
+        free(wrapper);
+
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    const oriHandle_t handle = _oriCreateHandle(&_orion.allocatees.devices, _ORI_HANDLE_TYPE_DEVICE, wrapper);
+    if (!handle) {
+        _oriDestroyDeviceRecord(wrapper);
+
+        _oriError(ORIERR_OBJECT_CREATION_FAIL, "device handle table is full");
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    if (handleOut) {
+        *handleOut = handle;
+    }
+
+#   ifdef __oridebug
+        _oriLog("%s", logstr);
+#   endif
+
     return ORION_RETURN_STATUS_OK;
 }
 
-const oriReturnStatus_t oriEnumerateSuitablePhysicalDevices(
-    const VkInstance *instance,
-    const oriPhysicalDeviceSuitabilityCheckfun checkFun,
-    unsigned int *countOut,
-    VkPhysicalDevice **devicesOut
+const oriReturnStatus_t oriDestroyLogicalDevice(
+    const oriHandle_t device
 ) {
-    if (!instance) { // instance is NULL
+    if (_ORI_CONTRACT_BROKEN(!device)) { // device is ORION_NULL_HANDLE
         _oriError(ORIERR_NULL_POINTER, __func__);
         return ORION_RETURN_STATUS_NULL_POINTER;
     }
-    if (!countOut && !devicesOut) { // both countOut and devicesOut are NULL
+
+    _oriVkDevice_t *deviceWrapper = _oriGetDevice(device, __func__);
+    if (!deviceWrapper) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriDestroyHandle(&_orion.allocatees.devices, device);
+    _oriDestroyDeviceRecord(deviceWrapper);
+
+#   ifdef __oridebug
+        _oriLog("logical device 0x%08X destroyed (%s)", device, __func__);
+#   endif
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+const VkDevice oriGetVkDevice(
+    const oriHandle_t device
+) {
+    _oriVkDevice_t *deviceWrapper = _oriGetDevice(device, __func__);
+    if (!deviceWrapper) {
+        return VK_NULL_HANDLE;
+    }
+
+    return deviceWrapper->handle;
+}
+
+const oriReturnStatus_t oriGetDeviceLimits(
+    const oriHandle_t device,
+    oriDeviceLimits_t *limitsOut
+) {
+    if (_ORI_CONTRACT_BROKEN(!device)) { // device is ORION_NULL_HANDLE
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+    if (!limitsOut) {
         _oriWarning("all output variables NULL in call to %s", __func__);
         return ORION_RETURN_STATUS_NO_OUTPUT;
     }
 
-    // c = number of available devices
-    unsigned int c;
-
-    // get number of available devices
-    if (vkEnumeratePhysicalDevices(*instance, &c, NULL)) {
-        _oriError(ORIERR_VULKAN_QUERY_FAIL, __func__);
+    const _oriVkDevice_t *deviceWrapper = _oriGetDevice(device, __func__);
+    if (!deviceWrapper) {
         return ORION_RETURN_STATUS_ERROR;
     }
 
-    if (!c) {
-        // no vulkan-supported GPUs were found
-#       ifdef __oridebug
-            _oriWarning("couldn't find any physical devices with Vulkan support (%s)", __func__);
-#       endif
+    *limitsOut = deviceWrapper->limits;
 
-        return ORION_RETURN_STATUS_OK;
+    return ORION_RETURN_STATUS_OK;
+}
+
+const oriReturnStatus_t oriEnumerateSuitablePhysicalDevices(
+    const oriHandle_t instance,
+    const oriPhysicalDeviceSuitabilityCheckfun checkFun,
+    unsigned int *countOut,
+    VkPhysicalDevice **devicesOut
+) {
+    if (_ORI_CONTRACT_BROKEN(!instance)) { // instance is NULL
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+    if (!countOut && !devicesOut) { // both countOut and devicesOut are NULL
+        _oriWarning("all output variables NULL in call to %s", __func__);
+        return ORION_RETURN_STATUS_NO_OUTPUT;
     }
 
-    // d = array of available devices
-    VkPhysicalDevice *d = malloc(c * sizeof(VkPhysicalDevice));
-    if (!d) {
-        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+    _oriVkInstance_t *instanceWrapper = _oriGetInstance(instance, __func__);
+    if (!instanceWrapper) {
         return ORION_RETURN_STATUS_ERROR;
     }
 
-    // get array of available devices
-    if (vkEnumeratePhysicalDevices(*instance, &c, d)) {
-        _oriError(ORIERR_VULKAN_QUERY_FAIL, __func__);
+    // c = number of available devices, d = array of available devices
+    unsigned int c;
+    VkPhysicalDevice *d;
+    if (_oriEnumeratePhysicalDevices(instanceWrapper, &c, &d)) {
         return ORION_RETURN_STATUS_ERROR;
     }
 
     // cr = number of suitable devices (will be returned into countOut)
-    unsigned int cr;
+    // suitable devices are moved to the front of d, so that d itself can be returned and each device is only checked once.
+    unsigned int cr = 0;
 
-    if (checkFun) {
-        // iterate through each device and check its suitability
-        for (unsigned int i = 0; i < c; i++) {
-            if (checkFun(d[i])) {
-                cr++;
-            }
-        }
-    } else {
+    for (unsigned int i = 0; i < c; i++) {
         // if checkFun is NULL then all available devices are considered suitable for the sake of this function
-        cr = c;
+        if (!checkFun || checkFun(d[i])) {
+            d[cr++] = d[i];
+        }
     }
 
     // return cr into countOut as it won't change after this point
@@ -258,16 +671,8 @@ const oriReturnStatus_t oriEnumerateSuitablePhysicalDevices(
         *countOut = cr;
     }
 
-    // now that we have returned the count, the only thing left to do is return the devices.
-    // however, deviceOut could be NULL, in which case no more work is needed.
-    if (!devicesOut) {
-        free(d); // (don't forget to free d)
-        d = NULL;
-        return ORION_RETURN_STATUS_OK;
-    }
-
-    // if there are no suitable or available devices
-    if (!cr) {
+    // if there are no suitable or available devices, or devicesOut is NULL, then d isn't needed
+    if (!devicesOut || !cr) {
         if (devicesOut) {
             *devicesOut = NULL;
         }
@@ -275,29 +680,173 @@ const oriReturnStatus_t oriEnumerateSuitablePhysicalDevices(
         free(d);
         d = NULL;
         return ORION_RETURN_STATUS_OK;
-    };
+    }
 
-    // if there are any suitable or available devices, then we can allocate and set devicesOut.
-    // we do this through a buffer variable (dr) to reduce dereferences.
-    VkPhysicalDevice *dr = malloc(cr * sizeof(VkPhysicalDevice));
-    if (!dr) {
-        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+    // finally, return d into devicesOut
+    // it is now up to the user to free this space.
+    *devicesOut = d;
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+const oriReturnStatus_t oriEnumerateSuitablePhysicalDevicesInto(
+    const oriHandle_t instance,
+    const oriPhysicalDeviceSuitabilityCheckfun checkFun,
+    unsigned int *count,
+    VkPhysicalDevice *devices
+) {
+    if (_ORI_CONTRACT_BROKEN(!instance || !count)) {
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    const _oriVkInstance_t *instanceWrapper = _oriGetInstance(instance, __func__);
+    if (!instanceWrapper) {
         return ORION_RETURN_STATUS_ERROR;
     }
 
-    // iterate through the devices again, this time if they are suitable then we give them to dr.
+    unsigned int c;
+    if (vkEnumeratePhysicalDevices(instanceWrapper->handle, &c, NULL)) {
+        _oriError(ORIERR_VULKAN_QUERY_FAIL, __func__);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    // all devices have to be checked even if the caller's array is smaller, so they are kept on the stack (there are only ever a few)
+    VkPhysicalDevice d[c ? c : 1];
+    if (c && vkEnumeratePhysicalDevices(instanceWrapper->handle, &c, d) < 0) {
+        _oriError(ORIERR_VULKAN_QUERY_FAIL, __func__);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    // cr = number of suitable devices found, written = number of those written to the caller's array
+    unsigned int cr = 0;
+    unsigned int written = 0;
+
     for (unsigned int i = 0; i < c; i++) {
-        if (!checkFun || checkFun(d[i])) {
-            dr[i] = d[i];
+        if (checkFun && !checkFun(d[i])) {
+            continue;
+        }
+
+        if (devices && written < *count) {
+            devices[written++] = d[i];
         }
+        cr++;
     }
 
-    // finally, return dr into devicesOut
-    // it is now up to the user to free this space.
-    *devicesOut = dr;
+    if (!devices) {
+        *count = cr;
+        return ORION_RETURN_STATUS_OK;
+    }
+
+    *count = written;
+
+    return (written < cr) ? ORION_RETURN_STATUS_SKIPPED : ORION_RETURN_STATUS_OK;
+}
+
+const oriPhysicalDeviceScoreWeights_t oriGetDefaultPhysicalDeviceScoreWeights() {
+    // the device type dominates so that a discrete GPU is always picked over an integrated one, then memory decides between
+    // devices of the same type
+    return (oriPhysicalDeviceScoreWeights_t) {
+        .deviceType = 8.0f,
+        .localMemory = 4.0f,
+        .queueFamilies = 2.0f,
+        .limits = 1.0f,
+        .extensions = 1.0f
+    };
+}
+
+const oriReturnStatus_t oriRankPhysicalDevices(
+    const oriHandle_t instance,
+    const oriPhysicalDeviceRankInfo_t *rankInfo,
+    unsigned int *countOut,
+    oriRankedPhysicalDevice_t **devicesOut
+) {
+    if (_ORI_CONTRACT_BROKEN(!instance)) { // instance is NULL
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+    if (_ORI_CONTRACT_BROKEN(rankInfo && ((!rankInfo->requiredExtensions && rankInfo->requiredExtensionCount) || (!rankInfo->preferredExtensions && rankInfo->preferredExtensionCount)))) {
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+    if (!countOut && !devicesOut) { // both countOut and devicesOut are NULL
+        _oriWarning("all output variables NULL in call to %s", __func__);
+        return ORION_RETURN_STATUS_NO_OUTPUT;
+    }
+
+    _oriVkInstance_t *instanceWrapper = _oriGetInstance(instance, __func__);
+    if (!instanceWrapper) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    // use the default model if no rank info was given
+    oriPhysicalDeviceRankInfo_t defaultRankInfo = { 0 };
+    if (!rankInfo) {
+        defaultRankInfo.weights = oriGetDefaultPhysicalDeviceScoreWeights();
+        rankInfo = &defaultRankInfo;
+    }
+
+    unsigned int c;
+    VkPhysicalDevice *d;
+    if (_oriEnumeratePhysicalDevices(instanceWrapper, &c, &d)) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    // every device is scored into this array, and unsuitable ones are skipped over (cr = number of ranked devices)
+    oriRankedPhysicalDevice_t *ranked = NULL;
+    unsigned int cr = 0;
+
+    if (c) {
+        ranked = malloc(c * sizeof(oriRankedPhysicalDevice_t));
+        if (!ranked) {
+            _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+            return ORION_RETURN_STATUS_ERROR;
+        }
+    }
+
+    for (unsigned int i = 0; i < c; i++) {
+        if (rankInfo->checkFun && !rankInfo->checkFun(d[i])) {
+            continue;
+        }
+
+        oriRankedPhysicalDevice_t *cur = &ranked[cr];
+        if (!_oriScorePhysicalDevice(d[i], i, rankInfo, cur)) {
+            continue;
+        }
+
+        cr++;
+    }
 
     free(d);
     d = NULL;
+
+    qsort(ranked, cr, sizeof(oriRankedPhysicalDevice_t), _oriCompareRankedPhysicalDevices);
+
+#   ifdef __oridebug
+        if (cr) {
+            _oriLog("%u of %u physical devices ranked, best is '%s' (score %.3f) (%s)", cr, c, ranked[0].properties.deviceName, ranked[0].score, __func__);
+        } else {
+            _oriWarning("none of %u physical devices are suitable (%s)", c, __func__);
+        }
+#   endif
+
+    if (countOut) {
+        *countOut = cr;
+    }
+
+    if (!devicesOut || !cr) {
+        if (devicesOut) {
+            *devicesOut = NULL;
+        }
+
+        free(ranked);
+        ranked = NULL;
+        return ORION_RETURN_STATUS_OK;
+    }
+
+    // it is now up to the user to free this space.
+    *devicesOut = ranked;
+
     return ORION_RETURN_STATUS_OK;
 }
 
@@ -306,7 +855,7 @@ const oriReturnStatus_t oriEnumerateAvailableQueueFamilies(
     unsigned int *countOut,
     VkQueueFamilyProperties **familiesOut
 ) {
-    if (!physicalDevice) { // physicalDevice is NULL
+    if (_ORI_CONTRACT_BROKEN(!physicalDevice)) { // physicalDevice is NULL
         _oriError(ORIERR_NULL_POINTER, __func__);
         return ORION_RETURN_STATUS_NULL_POINTER;
     }
@@ -352,3 +901,26 @@ const oriReturnStatus_t oriEnumerateAvailableQueueFamilies(
     // all info has been returned
     return ORION_RETURN_STATUS_OK;
 }
+
+const oriReturnStatus_t oriEnumerateAvailableQueueFamiliesInto(
+    const VkPhysicalDevice physicalDevice,
+    unsigned int *count,
+    VkQueueFamilyProperties *families
+) {
+    if (_ORI_CONTRACT_BROKEN(!physicalDevice || !count)) {
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    if (!families) {
+        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, count, NULL);
+        return ORION_RETURN_STATUS_OK;
+    }
+
+    // Vulkan writes at most *count families and sets *count to the amount written, so only the total needs to be checked
+    unsigned int c;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &c, NULL);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, count, families);
+
+    return (*count < c) ? ORION_RETURN_STATUS_SKIPPED : ORION_RETURN_STATUS_OK;
+}
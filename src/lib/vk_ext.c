@@ -33,22 +33,56 @@
 #include "orion.h"
 #include "orion_errors.h"
 #include "orion_funcs.h"
+#include "orion_structs.h"
 
 #include <stdlib.h>
 #include <string.h>
 
 
+// ============================================================================ //
+// *****                     Private/internal systems                     ***** //
+// ============================================================================ //
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                         Vulkan structure chain helpers                       //
+
+const void *_oriFindStructureInChain(
+    const void *chain,
+    const VkStructureType sType
+) {
+    for (const VkBaseInStructure *cur = chain; cur; cur = cur->pNext) {
+        if (cur->sType == sType) {
+            return cur;
+        }
+    }
+
+    return NULL;
+}
+
+
+// ============================================================================ //
+// *****                  Orion library public interface                  ***** //
+// ============================================================================ //
+
+
 // ----[Orion library public interface]---------------------------------------- //
 //                    Vulkan extensions and feature loading                     //
 
 const bool oriCheckLayerAvailability(
     const char *layer
 ) {
-    if (!layer) { // layer is NULL
+    if (_ORI_CONTRACT_BROKEN(!layer)) { // layer is NULL
         _oriError(ORIERR_NULL_POINTER, __func__);
         return false;
     }
 
+    // check the startup cache before asking the loader (see cache.c)
+    bool found = false;
+    if (_oriFindCachedName(_ORI_CACHE_INSTANCE_LAYERS, 0, layer, &found)) {
+        return found;
+    }
+
     unsigned int layerCount = 0;
     vkEnumerateInstanceLayerProperties(&layerCount, NULL);
 
@@ -58,9 +92,7 @@ const bool oriCheckLayerAvailability(
         return false; // this won't be reached since _oriFatalError halts the program but might as well put it here
     }
     vkEnumerateInstanceLayerProperties(&layerCount, availableLayers);
-
-    // we will return at the end to ensure that availableLayers is freed
-    bool found = false;
+    _oriStoreCachedNames(_ORI_CACHE_INSTANCE_LAYERS, 0, layerCount, availableLayers, sizeof(VkLayerProperties));
 
     for (unsigned int i = 0; i < layerCount; i++) {
         // check if any of the available layers is the specified layer
@@ -83,10 +115,10 @@ const bool oriCheckLayerAvailability(
 }
 
 const bool oriCheckLayerEnabled(
-    const VkInstance *instance,
+    const oriHandle_t instance,
     const char *layer
 ) {
-    if (!instance || !layer) { // necessary parameter is NULL
+    if (_ORI_CONTRACT_BROKEN(!instance || !layer)) { // necessary parameter is NULL
         _oriError(ORIERR_NULL_POINTER, __func__);
         return false;
     }
@@ -111,11 +143,11 @@ const bool oriCheckLayerEnabled(
 }
 
 const oriReturnStatus_t oriEnumerateEnabledLayers(
-    const VkInstance *instance,
+    const oriHandle_t instance,
     unsigned int *layerCountOut,
     char ***layerNamesOut
 ) {
-    if (!instance) { // instance is NULL
+    if (_ORI_CONTRACT_BROKEN(!instance)) { // instance is NULL
         _oriError(ORIERR_NULL_POINTER, __func__);
         return ORION_RETURN_STATUS_NULL_POINTER;
     }
@@ -124,12 +156,9 @@ const oriReturnStatus_t oriEnumerateEnabledLayers(
         return ORION_RETURN_STATUS_NO_OUTPUT;
     }
 
-    _oriVkInstance_t *instanceWrapper;
-    HASH_FIND_PTR(_orion.allocatees.vkInstances, &instance, instanceWrapper);
-
-    // if the instance was not found in the hash table, then it was not created with Orion (or it was not created at all)
+    // if the handle is invalid or stale, then the instance was not created with Orion (or it has since been destroyed)
+    _oriVkInstance_t *instanceWrapper = _oriGetInstance(instance, __func__);
     if (!instanceWrapper) {
-        _oriError(ORIERR_INVALID_OBJECT, __func__);
         return ORION_RETURN_STATUS_ERROR;
     }
 
@@ -147,11 +176,18 @@ const bool oriCheckInstanceExtensionAvailability(
     const char *extension,
     const char *layer
 ) {
-    if (!extension) { // extension is NULL
+    if (_ORI_CONTRACT_BROKEN(!extension)) { // extension is NULL
         _oriError(ORIERR_NULL_POINTER, __func__);
         return false;
     }
 
+    // check the startup cache before asking the loader (see cache.c)
+    const uint64_t cacheKey = _oriHashCacheString(layer);
+    bool found = false;
+    if (_oriFindCachedName(_ORI_CACHE_INSTANCE_EXTENSIONS, cacheKey, extension, &found)) {
+        return found;
+    }
+
     unsigned int extCount = 0;
     vkEnumerateInstanceExtensionProperties(layer, &extCount, NULL);
 
@@ -161,9 +197,7 @@ const bool oriCheckInstanceExtensionAvailability(
         return false; // this won't be reached since _oriFatalError halts the program but might as well put it here
     }
     vkEnumerateInstanceExtensionProperties(layer, &extCount, availableExts);
-
-    // we will return at the end to ensure that availableExts is freed
-    bool found = false;
+    _oriStoreCachedNames(_ORI_CACHE_INSTANCE_EXTENSIONS, cacheKey, extCount, availableExts, sizeof(VkExtensionProperties));
 
     for (unsigned int i = 0; i < extCount; i++) {
         // check if any of the available extensions is the specified extension
@@ -186,10 +220,10 @@ const bool oriCheckInstanceExtensionAvailability(
 }
 
 const bool oriCheckInstanceExtensionEnabled(
-    const VkInstance *instance,
+    const oriHandle_t instance,
     const char *extension
 ) {
-    if (!instance || !extension) { // necessary parameter is NULL
+    if (_ORI_CONTRACT_BROKEN(!instance || !extension)) { // necessary parameter is NULL
         _oriError(ORIERR_NULL_POINTER, __func__);
         return false;
     }
@@ -214,11 +248,11 @@ const bool oriCheckInstanceExtensionEnabled(
 }
 
 const oriReturnStatus_t oriEnumerateEnabledInstanceExtensions(
-    const VkInstance *instance,
+    const oriHandle_t instance,
     unsigned int *extCountOut,
     char ***extNamesOut
 ) {
-    if (!instance) { // instance is NULL
+    if (_ORI_CONTRACT_BROKEN(!instance)) { // instance is NULL
         _oriError(ORIERR_NULL_POINTER, __func__);
         return ORION_RETURN_STATUS_NULL_POINTER;
     }
@@ -227,12 +261,9 @@ const oriReturnStatus_t oriEnumerateEnabledInstanceExtensions(
         return ORION_RETURN_STATUS_NO_OUTPUT;
     }
 
-    _oriVkInstance_t *instanceWrapper;
-    HASH_FIND_PTR(_orion.allocatees.vkInstances, &instance, instanceWrapper);
-
-    // if the instance was not found in the hash table, then it was not created with Orion (or it was not created at all)
+    // if the handle is invalid or stale, then the instance was not created with Orion (or it has since been destroyed)
+    _oriVkInstance_t *instanceWrapper = _oriGetInstance(instance, __func__);
     if (!instanceWrapper) {
-        _oriError(ORIERR_INVALID_OBJECT, __func__);
         return ORION_RETURN_STATUS_ERROR;
     }
 
@@ -251,11 +282,19 @@ const bool oriCheckDeviceExtensionAvailability(
     const char *extension,
     const char *layer
 ) {
-    if (!physicalDevice || !extension) { // a required parameter is NULL
+    if (_ORI_CONTRACT_BROKEN(!physicalDevice || !extension)) { // a required parameter is NULL
         _oriError(ORIERR_NULL_POINTER, __func__);
         return false;
     }
 
+    // check the startup cache before asking the driver (see cache.c)
+    // (the key is only worked out if the cache is in use, as it needs the properties of the device)
+    const uint64_t cacheKey = (_orion.cache.path) ? _oriGetPhysicalDeviceCacheKey(physicalDevice) ^ _oriHashCacheString(layer) : 0;
+    bool found = false;
+    if (_oriFindCachedName(_ORI_CACHE_DEVICE_EXTENSIONS, cacheKey, extension, &found)) {
+        return found;
+    }
+
     unsigned int extCount = 0;
     vkEnumerateDeviceExtensionProperties(physicalDevice, layer, &extCount, NULL);
 
@@ -265,9 +304,7 @@ const bool oriCheckDeviceExtensionAvailability(
         return false;
     }
     vkEnumerateDeviceExtensionProperties(physicalDevice, layer, &extCount, availableExts);
-
-    // we will return at the end to ensure that availableExts is freed
-    bool found = false;
+    _oriStoreCachedNames(_ORI_CACHE_DEVICE_EXTENSIONS, cacheKey, extCount, availableExts, sizeof(VkExtensionProperties));
 
     for (unsigned int i = 0; i < extCount; i++) {
         // check if any of the available extensions is the specified extension
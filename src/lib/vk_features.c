@@ -0,0 +1,242 @@
+/* *************************************************************************************** */
+/*                       ORION GRAPHICS LIBRARY AND RENDERING ENGINE                       */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+
+// ============================================================================ //
+// *****                     Doxygen file information                     ***** //
+// ============================================================================ //
+
+/**
+ * @file vk_features.c
+ * @author jack bennett
+ * @brief Vulkan device feature sets
+ *
+ * @copyright Copyright (c) 2022 jack bennett
+ *
+ * This file contains the builder for chains of Vulkan feature structures that enable
+ * performance-related device features (timeline semaphores, synchronization2, ...), and
+ * the functions to check which of those features a logical device was created with.
+ *
+ */
+
+#include "orion.h"
+#include "orion_errors.h"
+#include "orion_funcs.h"
+#include "orion_structs.h"
+
+#include <stddef.h>
+#include <string.h>
+
+
+// ============================================================================ //
+// *****                     Private/internal systems                     ***** //
+// ============================================================================ //
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                             Device feature sets                              //
+
+// Returns true if the descriptor indexing features that ORION_DEVICE_FEATURE_DESCRIPTOR_INDEXING_BIT stands for are all on.
+//
+static bool _oriHasDescriptorIndexing(
+    const VkPhysicalDeviceVulkan12Features *f
+) {
+    return f->descriptorIndexing &&
+        f->runtimeDescriptorArray &&
+        f->descriptorBindingPartiallyBound &&
+        f->descriptorBindingVariableDescriptorCount &&
+        f->shaderSampledImageArrayNonUniformIndexing &&
+        f->descriptorBindingSampledImageUpdateAfterBind;
+}
+
+// Work out the oriDeviceFeatureBit_t flags that are on in a pair of 1.2/1.3 feature structures (either may be NULL).
+//
+static uint32_t _oriGetFeatureFlags(
+    const VkPhysicalDeviceVulkan12Features *vulkan12,
+    const VkPhysicalDeviceVulkan13Features *vulkan13
+) {
+    uint32_t flags = 0;
+
+    if (vulkan12) {
+        flags |= (vulkan12->timelineSemaphore) ? ORION_DEVICE_FEATURE_TIMELINE_SEMAPHORE_BIT : 0;
+        flags |= (vulkan12->bufferDeviceAddress) ? ORION_DEVICE_FEATURE_BUFFER_DEVICE_ADDRESS_BIT : 0;
+        flags |= (_oriHasDescriptorIndexing(vulkan12)) ? ORION_DEVICE_FEATURE_DESCRIPTOR_INDEXING_BIT : 0;
+    }
+
+    if (vulkan13) {
+        flags |= (vulkan13->synchronization2) ? ORION_DEVICE_FEATURE_SYNCHRONIZATION_2_BIT : 0;
+        flags |= (vulkan13->dynamicRendering) ? ORION_DEVICE_FEATURE_DYNAMIC_RENDERING_BIT : 0;
+        flags |= (vulkan13->maintenance4) ? ORION_DEVICE_FEATURE_MAINTENANCE_4_BIT : 0;
+    }
+
+    return flags;
+}
+
+const uint32_t _oriGetChainedDeviceFeatures(
+    const void *chain,
+    const uint32_t apiVersion
+) {
+    return _oriGetFeatureFlags(
+        (apiVersion >= VK_API_VERSION_1_2) ? _oriFindStructureInChain(chain, VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES) : NULL,
+        (apiVersion >= VK_API_VERSION_1_3) ? _oriFindStructureInChain(chain, VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES) : NULL
+    );
+}
+
+
+// ============================================================================ //
+// *****                   Orion library public interface                 ***** //
+// ============================================================================ //
+
+
+// ----[Orion library public interface]---------------------------------------- //
+//                          Vulkan device management                            //
+
+const oriReturnStatus_t oriBuildDeviceFeatureSet(
+    const VkPhysicalDevice physicalDevice,
+    const uint32_t requestedFeatures,
+    const VkPhysicalDeviceFeatures *baseFeatures,
+    oriDeviceFeatureSet_t *setOut
+) {
+    if (_ORI_CONTRACT_BROKEN(!physicalDevice)) {
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+    if (!setOut) {
+        _oriWarning("all output variables NULL in call to %s", __func__);
+        return ORION_RETURN_STATUS_NO_OUTPUT;
+    }
+
+    // the 1.2 and 1.3 feature structures can only be chained if both the instance and the device support those versions
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+    const uint32_t apiVersion = (_orion.apiVersion < properties.apiVersion) ? _orion.apiVersion : properties.apiVersion;
+
+    // (vkGetPhysicalDeviceFeatures2() is core in Vulkan 1.1)
+    if (apiVersion < VK_API_VERSION_1_1) {
+        _oriError(ORIERR_UNSUPPORTED_VERSION, __func__);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    const bool has12 = apiVersion >= VK_API_VERSION_1_2;
+    const bool has13 = apiVersion >= VK_API_VERSION_1_3;
+
+    // query support
+    // (the set itself is used for this, so that the chain only has to be built once)
+    memset(setOut, 0, sizeof(oriDeviceFeatureSet_t));
+
+    setOut->features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    setOut->vulkan12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    setOut->vulkan13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+
+    void **next = &setOut->features2.pNext;
+    if (has12) {
+        *next = &setOut->vulkan12;
+        next = &setOut->vulkan12.pNext;
+    }
+    if (has13) {
+        *next = &setOut->vulkan13;
+    }
+
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &setOut->features2);
+
+    const VkPhysicalDeviceFeatures supportedCore = setOut->features2.features;
+    const VkPhysicalDeviceVulkan12Features supported12 = setOut->vulkan12;
+    const VkPhysicalDeviceVulkan13Features supported13 = setOut->vulkan13;
+
+    const uint32_t supported = _oriGetFeatureFlags((has12) ? &supported12 : NULL, (has13) ? &supported13 : NULL);
+
+    // clear everything that was returned, keeping the chain itself
+    memset(&setOut->features2.features, 0, sizeof(VkPhysicalDeviceFeatures));
+    memset(&setOut->vulkan12.samplerMirrorClampToEdge, 0, sizeof(VkPhysicalDeviceVulkan12Features) - offsetof(VkPhysicalDeviceVulkan12Features, samplerMirrorClampToEdge));
+    memset(&setOut->vulkan13.robustImageAccess, 0, sizeof(VkPhysicalDeviceVulkan13Features) - offsetof(VkPhysicalDeviceVulkan13Features, robustImageAccess));
+
+    // enable the supported base features (VkPhysicalDeviceFeatures is just an array of VkBool32 members)
+    if (baseFeatures) {
+        const VkBool32 *base = (const VkBool32 *) baseFeatures;
+        const VkBool32 *support = (const VkBool32 *) &supportedCore;
+        VkBool32 *enabled = (VkBool32 *) &setOut->features2.features;
+
+        for (unsigned int i = 0; i < sizeof(VkPhysicalDeviceFeatures) / sizeof(VkBool32); i++) {
+            enabled[i] = base[i] && support[i];
+
+#           ifdef __oridebug
+                if (base[i] && !support[i]) {
+                    _oriWarning("core device feature at index %u not supported by physical device, so not enabled (%s)", i, __func__);
+                }
+#           endif
+        }
+    }
+
+    // enable the requested performance features
+    setOut->requested = requestedFeatures;
+    setOut->enabled = requestedFeatures & supported;
+
+    if (setOut->enabled & ORION_DEVICE_FEATURE_TIMELINE_SEMAPHORE_BIT) {
+        setOut->vulkan12.timelineSemaphore = VK_TRUE;
+    }
+    if (setOut->enabled & ORION_DEVICE_FEATURE_BUFFER_DEVICE_ADDRESS_BIT) {
+        setOut->vulkan12.bufferDeviceAddress = VK_TRUE;
+    }
+    if (setOut->enabled & ORION_DEVICE_FEATURE_DESCRIPTOR_INDEXING_BIT) {
+        setOut->vulkan12.descriptorIndexing = VK_TRUE;
+        setOut->vulkan12.runtimeDescriptorArray = VK_TRUE;
+        setOut->vulkan12.descriptorBindingPartiallyBound = VK_TRUE;
+        setOut->vulkan12.descriptorBindingVariableDescriptorCount = VK_TRUE;
+        setOut->vulkan12.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+        setOut->vulkan12.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+    }
+    if (setOut->enabled & ORION_DEVICE_FEATURE_SYNCHRONIZATION_2_BIT) {
+        setOut->vulkan13.synchronization2 = VK_TRUE;
+    }
+    if (setOut->enabled & ORION_DEVICE_FEATURE_DYNAMIC_RENDERING_BIT) {
+        setOut->vulkan13.dynamicRendering = VK_TRUE;
+    }
+    if (setOut->enabled & ORION_DEVICE_FEATURE_MAINTENANCE_4_BIT) {
+        setOut->vulkan13.maintenance4 = VK_TRUE;
+    }
+
+#   ifdef __oridebug
+        if (setOut->enabled != requestedFeatures) {
+            _oriWarning("device feature set built with features 0x%02x of requested 0x%02x (device API version %u.%u) (%s)", setOut->enabled,
+                requestedFeatures, VK_API_VERSION_MAJOR(properties.apiVersion), VK_API_VERSION_MINOR(properties.apiVersion), __func__);
+        } else {
+            _oriLog("device feature set built with features 0x%02x (%s)", setOut->enabled, __func__);
+        }
+#   endif
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+const uint32_t oriGetEnabledDeviceFeatures(
+    const oriHandle_t device
+) {
+    const _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return 0;
+    }
+
+    return record->features;
+}
+
+const bool oriIsDeviceFeatureEnabled(
+    const oriHandle_t device,
+    const uint32_t features
+) {
+    const _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return false;
+    }
+
+    return (record->features & features) == features;
+}
@@ -0,0 +1,344 @@
+/* *************************************************************************************** */
+/*                       ORION GRAPHICS LIBRARY AND RENDERING ENGINE                       */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+
+// ============================================================================ //
+// *****                     Doxygen file information                     ***** //
+// ============================================================================ //
+
+/**
+ * @file vk_format.c
+ * @author jack bennett
+ * @brief Vulkan format support
+ *
+ * @copyright Copyright (c) 2022 jack bennett
+ *
+ * This file contains the per-physical-device tables of format properties, and the
+ * functions that choose formats from them.
+ *
+ * Each table is filled once (either lazily, or eagerly in a background thread with
+ * oriPrefetchFormatProperties()), after which format queries never reach the driver.
+ * Tables are kept in a list that is only ever pushed to, so they can be found without
+ * taking a lock.
+ *
+ */
+
+#include "orion.h"
+#include "orion_errors.h"
+#include "orion_flags.h"
+#include "orion_funcs.h"
+#include "orion_structs.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+
+
+// ============================================================================ //
+// *****                     Private/internal systems                     ***** //
+// ============================================================================ //
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                            Format property tables                            //
+
+// Find the format table of a physical device, creating (but not filling) it if there isn't one yet.
+// Returns NULL if there was a memory error.
+//
+static _oriFormatTable_t *_oriAcquireFormatTable(
+    const VkPhysicalDevice physicalDevice
+) {
+    _oriFormatTable_t *head = atomic_load_explicit(&_orion.formatTables, memory_order_acquire);
+
+    for (_oriFormatTable_t *cur = head; cur; cur = cur->next) {
+        if (cur->physicalDevice == physicalDevice) {
+            return cur;
+        }
+    }
+
+    _oriFormatTable_t *table = calloc(1, sizeof(_oriFormatTable_t));
+    if (!table) {
+        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+        return NULL;
+    }
+    table->physicalDevice = physicalDevice;
+    atomic_init(&table->state, _ORI_FORMAT_TABLE_EMPTY);
+
+    // push the table, unless another thread pushes one for the same device first
+    do {
+        for (_oriFormatTable_t *cur = head; cur; cur = cur->next) {
+            if (cur->physicalDevice == physicalDevice) {
+                free(table);
+                return cur;
+            }
+        }
+
+        table->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&_orion.formatTables, &head, table, memory_order_acq_rel, memory_order_acquire));
+
+    return table;
+}
+
+static void _oriFillFormatTable(
+    _oriFormatTable_t *table
+) {
+    // the table may be in the startup cache (see cache.c)
+    const uint64_t cacheKey = (_orion.cache.path) ? _oriGetPhysicalDeviceCacheKey(table->physicalDevice) : 0;
+    uint32_t size = 0;
+    const void *cached = _oriFindCacheEntry(_ORI_CACHE_FORMAT_TABLE, cacheKey, &size);
+
+    if (cached && size == sizeof(table->properties)) {
+        memcpy(table->properties, cached, sizeof(table->properties));
+    } else {
+        for (unsigned int i = 0; i < FORMAT_TABLE_SIZE; i++) {
+            vkGetPhysicalDeviceFormatProperties(table->physicalDevice, (VkFormat) i, &table->properties[i]);
+        }
+
+        _oriStoreCacheEntry(_ORI_CACHE_FORMAT_TABLE, cacheKey, table->properties, sizeof(table->properties));
+    }
+
+    atomic_store_explicit(&table->state, _ORI_FORMAT_TABLE_READY, memory_order_release);
+}
+
+static int _oriFillFormatTableThread(
+    void *table
+) {
+    _oriFillFormatTable(table);
+    return 0;
+}
+
+// Get the format table of a physical device, ready to be read; it is filled here if nobody else has started to.
+//
+static const _oriFormatTable_t *_oriGetFormatTable(
+    const VkPhysicalDevice physicalDevice
+) {
+    _oriFormatTable_t *table = _oriAcquireFormatTable(physicalDevice);
+    if (!table) {
+        return NULL;
+    }
+
+    int state = atomic_load_explicit(&table->state, memory_order_acquire);
+    if (state == _ORI_FORMAT_TABLE_READY) {
+        return table;
+    }
+
+    if (state == _ORI_FORMAT_TABLE_EMPTY && atomic_compare_exchange_strong(&table->state, &state, _ORI_FORMAT_TABLE_FILLING)) {
+        _oriFillFormatTable(table);
+        return table;
+    }
+
+    // another thread is filling the table
+    while (atomic_load_explicit(&table->state, memory_order_acquire) != _ORI_FORMAT_TABLE_READY) {
+        thrd_yield();
+    }
+
+    return table;
+}
+
+// Look up the properties of a format (querying the driver for formats that aren't in the tables).
+// Returns false if there was a memory error.
+//
+static bool _oriLookupFormat(
+    const VkPhysicalDevice physicalDevice,
+    const VkFormat format,
+    VkFormatProperties *propertiesOut
+) {
+    if ((unsigned int) format >= FORMAT_TABLE_SIZE) {
+        vkGetPhysicalDeviceFormatProperties(physicalDevice, format, propertiesOut);
+        return true;
+    }
+
+    const _oriFormatTable_t *table = _oriGetFormatTable(physicalDevice);
+    if (!table) {
+        return false;
+    }
+
+    *propertiesOut = table->properties[format];
+    return true;
+}
+
+void _oriFreeFormatTables() {
+    _oriFormatTable_t *cur = atomic_exchange(&_orion.formatTables, NULL);
+
+    while (cur) {
+        _oriFormatTable_t *next = cur->next;
+
+        if (cur->threaded) {
+            thrd_join(cur->thread, NULL);
+        }
+        free(cur);
+
+        cur = next;
+    }
+}
+
+// Candidate formats for each oriFormatUsage_t (most preferred first), and the features they need with optimal tiling.
+//
+#define _ORI_MAX_FORMAT_CANDIDATES 4
+
+static const struct {
+    VkFormatFeatureFlags features;
+    unsigned int candidateCount;
+    VkFormat candidates[_ORI_MAX_FORMAT_CANDIDATES];
+} _oriFormatUsages[] = {
+    [ORION_FORMAT_USAGE_COLOR_TEXTURE] = {
+        VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT, 4,
+        { VK_FORMAT_BC7_UNORM_BLOCK, VK_FORMAT_ASTC_4x4_UNORM_BLOCK, VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK, VK_FORMAT_R8G8B8A8_UNORM }
+    },
+    [ORION_FORMAT_USAGE_COLOR_TEXTURE_SRGB] = {
+        VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT, 4,
+        { VK_FORMAT_BC7_SRGB_BLOCK, VK_FORMAT_ASTC_4x4_SRGB_BLOCK, VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK, VK_FORMAT_R8G8B8A8_SRGB }
+    },
+    [ORION_FORMAT_USAGE_NORMAL_MAP] = {
+        VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT, 3,
+        { VK_FORMAT_BC5_UNORM_BLOCK, VK_FORMAT_EAC_R11G11_UNORM_BLOCK, VK_FORMAT_R8G8_UNORM }
+    },
+    [ORION_FORMAT_USAGE_HDR_TEXTURE] = {
+        VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT, 4,
+        { VK_FORMAT_BC6H_UFLOAT_BLOCK, VK_FORMAT_B10G11R11_UFLOAT_PACK32, VK_FORMAT_E5B9G9R9_UFLOAT_PACK32, VK_FORMAT_R16G16B16A16_SFLOAT }
+    },
+    [ORION_FORMAT_USAGE_COLOR_ATTACHMENT] = {
+        VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT | VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BLEND_BIT, 3,
+        { VK_FORMAT_B8G8R8A8_UNORM, VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_A2B10G10R10_UNORM_PACK32 }
+    },
+    [ORION_FORMAT_USAGE_HDR_COLOR_ATTACHMENT] = {
+        VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT | VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BLEND_BIT, 3,
+        { VK_FORMAT_B10G11R11_UFLOAT_PACK32, VK_FORMAT_R16G16B16A16_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT }
+    },
+    [ORION_FORMAT_USAGE_DEPTH_ATTACHMENT] = {
+        VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT, 3,
+        { VK_FORMAT_D32_SFLOAT, VK_FORMAT_X8_D24_UNORM_PACK32, VK_FORMAT_D16_UNORM }
+    },
+    [ORION_FORMAT_USAGE_DEPTH_STENCIL_ATTACHMENT] = {
+        VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT, 3,
+        { VK_FORMAT_D24_UNORM_S8_UINT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D16_UNORM_S8_UINT }
+    },
+};
+
+
+// ============================================================================ //
+// *****                   Orion library public interface                 ***** //
+// ============================================================================ //
+
+
+// ----[Orion library public interface]---------------------------------------- //
+//                              Vulkan format support                           //
+
+const oriReturnStatus_t oriPrefetchFormatProperties(
+    const VkPhysicalDevice physicalDevice,
+    const bool background
+) {
+    if (_ORI_CONTRACT_BROKEN(!physicalDevice)) {
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    _oriFormatTable_t *table = _oriAcquireFormatTable(physicalDevice);
+    if (!table) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    int state = _ORI_FORMAT_TABLE_EMPTY;
+    if (!atomic_compare_exchange_strong(&table->state, &state, _ORI_FORMAT_TABLE_FILLING)) {
+        return ORION_RETURN_STATUS_SKIPPED;
+    }
+
+    // fall back to filling the table here if the thread can't be started
+    if (background && thrd_create(&table->thread, _oriFillFormatTableThread, table) == thrd_success) {
+        table->threaded = true;
+
+#       ifdef __oridebug
+            _oriLog("filling format table of physical device %p in the background (%s)", (void *) physicalDevice, __func__);
+#       endif
+
+        return ORION_RETURN_STATUS_OK;
+    }
+
+    _oriFillFormatTable(table);
+
+#   ifdef __oridebug
+        _oriLog("filled format table of physical device %p (%s)", (void *) physicalDevice, __func__);
+#   endif
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+const oriReturnStatus_t oriGetFormatProperties(
+    const VkPhysicalDevice physicalDevice,
+    const VkFormat format,
+    VkFormatProperties *propertiesOut
+) {
+    if (_ORI_CONTRACT_BROKEN(!physicalDevice)) {
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+    if (!propertiesOut) {
+        _oriWarning("all output variables NULL in call to %s", __func__);
+        return ORION_RETURN_STATUS_NO_OUTPUT;
+    }
+
+    if (!_oriLookupFormat(physicalDevice, format, propertiesOut)) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+const oriReturnStatus_t oriFindSupportedFormat(
+    const VkPhysicalDevice physicalDevice,
+    const VkImageTiling tiling,
+    const VkFormatFeatureFlags features,
+    const unsigned int candidateCount,
+    const VkFormat *candidates,
+    VkFormat *formatOut
+) {
+    if (_ORI_CONTRACT_BROKEN(!physicalDevice || (!candidates && candidateCount))) {
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+    if (!formatOut) {
+        _oriWarning("all output variables NULL in call to %s", __func__);
+        return ORION_RETURN_STATUS_NO_OUTPUT;
+    }
+
+    *formatOut = VK_FORMAT_UNDEFINED;
+
+    for (unsigned int i = 0; i < candidateCount; i++) {
+        VkFormatProperties properties;
+        if (!_oriLookupFormat(physicalDevice, candidates[i], &properties)) {
+            return ORION_RETURN_STATUS_ERROR;
+        }
+
+        const VkFormatFeatureFlags supported = (tiling == VK_IMAGE_TILING_LINEAR) ? properties.linearTilingFeatures : properties.optimalTilingFeatures;
+        if ((supported & features) == features) {
+            *formatOut = candidates[i];
+            return ORION_RETURN_STATUS_OK;
+        }
+    }
+
+    return ORION_RETURN_STATUS_SKIPPED;
+}
+
+const oriReturnStatus_t oriFindBestFormat(
+    const VkPhysicalDevice physicalDevice,
+    const oriFormatUsage_t usage,
+    VkFormat *formatOut
+) {
+    if ((unsigned int) usage >= sizeof(_oriFormatUsages) / sizeof(_oriFormatUsages[0])) {
+        _oriError(ORIERR_INVALID_OBJECT, __func__);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    return oriFindSupportedFormat(physicalDevice, VK_IMAGE_TILING_OPTIMAL, _oriFormatUsages[usage].features, _oriFormatUsages[usage].candidateCount,
+        _oriFormatUsages[usage].candidates, formatOut);
+}
@@ -0,0 +1,298 @@
+/* *************************************************************************************** */
+/*                       ORION GRAPHICS LIBRARY AND RENDERING ENGINE                       */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+
+// ============================================================================ //
+// *****                     Doxygen file information                     ***** //
+// ============================================================================ //
+
+/**
+ * @file vk_mapping.c
+ * @author jack bennett
+ * @brief Flushing and invalidation of mapped device memory
+ *
+ * @copyright Copyright (c) 2022 jack bennett
+ *
+ * Every host-visible block of the memory manager is mapped once, when it is allocated (see
+ * vk_memory.c), so allocations are written through a pointer that never changes.
+ *
+ * Writes to memory that is not host-coherent are recorded as ranges, rounded out to
+ * nonCoherentAtomSize, and merged as they come in; all of them are then flushed in a single
+ * vkFlushMappedMemoryRanges() call, once per queue submission. Writes to host-coherent memory
+ * are not recorded at all, and neither are writes to imported host memory, which is not
+ * mapped through Vulkan.
+ *
+ */
+
+#include "orion.h"
+#include "orion_errors.h"
+#include "orion_funcs.h"
+#include "orion_structs.h"
+
+#include <stdlib.h>
+#include <threads.h>
+
+
+// ============================================================================ //
+// *****                     Private/internal systems                     ***** //
+// ============================================================================ //
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                                 Mapped memory                                //
+
+// Get the range of device memory covered by a range of an allocation, rounded out to nonCoherentAtomSize (without going past
+// the end of the allocation's block).
+// Returns false (with an error) if the allocation is not mapped, or if the range is out of its bounds.
+//
+static const bool _oriGetMappedRange(
+    const _oriVkDevice_t *device,
+    const _oriMemoryChunk_t *chunk,
+    const VkDeviceSize offset,
+    const VkDeviceSize size,
+    VkMappedMemoryRange *rangeOut,
+    const char *func
+) {
+    if (!chunk->block->data || offset > chunk->size || (size != VK_WHOLE_SIZE && size > chunk->size - offset)) {
+        _oriError(ORIERR_INVALID_MAPPED_RANGE, func);
+        return false;
+    }
+
+    const VkDeviceSize begin = chunk->offset + offset;
+    const VkDeviceSize end = (size == VK_WHOLE_SIZE) ? chunk->offset + chunk->size : begin + size;
+
+    // (a range that ends at the end of the memory doesn't have to be a multiple of the atom size)
+    const VkDeviceSize alignedEnd = oriAlignUp(end, device->limits.nonCoherentAtomMask);
+
+    rangeOut->sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+    rangeOut->pNext = NULL;
+    rangeOut->memory = chunk->block->memory;
+    rangeOut->offset = oriAlignDown(begin, device->limits.nonCoherentAtomMask);
+    rangeOut->size = ((alignedEnd < chunk->block->size) ? alignedEnd : chunk->block->size) - rangeOut->offset;
+
+    return true;
+}
+
+// Returns true if writes to an allocation never need to be flushed or invalidated: either its memory type is host-coherent, or
+// it is imported host memory, which is never mapped with vkMapMemory() and so can't be flushed or invalidated.
+//
+static const bool _oriIsCoherent(
+    const _oriMemoryManager_t *manager,
+    const _oriMemoryChunk_t *chunk
+) {
+    return chunk->block->imported ||
+        (manager->properties.memoryTypes[chunk->block->memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+}
+
+// Returns true if two ranges of device memory overlap or touch.
+//
+static const bool _oriRangesTouch(
+    const VkMappedMemoryRange *a,
+    const VkMappedMemoryRange *b
+) {
+    return a->memory == b->memory && a->offset <= b->offset + b->size && b->offset <= a->offset + a->size;
+}
+
+// Grow a range of device memory to cover another that it touches.
+//
+static void _oriMergeRange(
+    VkMappedMemoryRange *range,
+    const VkMappedMemoryRange *other
+) {
+    const VkDeviceSize rangeEnd = range->offset + range->size;
+    const VkDeviceSize otherEnd = other->offset + other->size;
+
+    if (other->offset < range->offset) {
+        range->offset = other->offset;
+    }
+    range->size = ((otherEnd > rangeEnd) ? otherEnd : rangeEnd) - range->offset;
+}
+
+// Record a range of device memory as written (the memory lock must be held).
+// Returns false if there was an error.
+//
+static const bool _oriAddDirtyRange(
+    _oriMemoryManager_t *manager,
+    const VkMappedMemoryRange *range
+) {
+    // consecutive writes to the same allocation are by far the most common case, so they are merged straight away
+    if (manager->dirtyRangeCount) {
+        VkMappedMemoryRange *last = &manager->dirtyRanges[manager->dirtyRangeCount - 1];
+        if (_oriRangesTouch(last, range)) {
+            _oriMergeRange(last, range);
+            return true;
+        }
+    }
+
+    if (manager->dirtyRangeCount == manager->dirtyRangeCapacity) {
+        const unsigned int capacity = (manager->dirtyRangeCapacity) ? manager->dirtyRangeCapacity * 2 : 64;
+
+        VkMappedMemoryRange *ranges = realloc(manager->dirtyRanges, capacity * sizeof(VkMappedMemoryRange));
+        if (!ranges) {
+            _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+            return false;
+        }
+
+        manager->dirtyRanges = ranges;
+        manager->dirtyRangeCapacity = capacity;
+    }
+
+    manager->dirtyRanges[manager->dirtyRangeCount++] = *range;
+    return true;
+}
+
+// Order ranges of device memory by memory object, then by offset (for qsort()).
+//
+static int _oriCompareRanges(
+    const void *a,
+    const void *b
+) {
+    const VkMappedMemoryRange *rangeA = a;
+    const VkMappedMemoryRange *rangeB = b;
+
+    const uint64_t memoryA = _ORI_NON_DISPATCHABLE_HANDLE_U64(rangeA->memory);
+    const uint64_t memoryB = _ORI_NON_DISPATCHABLE_HANDLE_U64(rangeB->memory);
+    if (memoryA != memoryB) {
+        return (memoryA < memoryB) ? -1 : 1;
+    }
+
+    return (rangeA->offset > rangeB->offset) - (rangeA->offset < rangeB->offset);
+}
+
+void _oriDropDirtyRanges(
+    _oriMemoryManager_t *manager,
+    const VkDeviceMemory memory
+) {
+    unsigned int kept = 0;
+    for (unsigned int i = 0; i < manager->dirtyRangeCount; i++) {
+        if (manager->dirtyRanges[i].memory != memory) {
+            manager->dirtyRanges[kept++] = manager->dirtyRanges[i];
+        }
+    }
+
+    manager->dirtyRangeCount = kept;
+}
+
+
+// ============================================================================ //
+// *****                   Orion library public interface                 ***** //
+// ============================================================================ //
+
+
+// ----[Orion library public interface]---------------------------------------- //
+//                           Vulkan memory management                           //
+
+const oriReturnStatus_t oriMarkAllocationWritten(
+    const oriHandle_t device,
+    const oriHandle_t allocation,
+    const VkDeviceSize offset,
+    const VkDeviceSize size
+) {
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriMemoryManager_t *manager = &record->memory;
+
+    mtx_lock(&manager->lock);
+
+    oriReturnStatus_t status = ORION_RETURN_STATUS_ERROR;
+    const _oriMemoryChunk_t *chunk = _oriGetAllocation(record, allocation, __func__);
+
+    VkMappedMemoryRange range;
+    if (chunk && _oriGetMappedRange(record, chunk, offset, size, &range, __func__)) {
+        if (_oriIsCoherent(manager, chunk) || _oriAddDirtyRange(manager, &range)) {
+            status = ORION_RETURN_STATUS_OK;
+        }
+    }
+
+    mtx_unlock(&manager->lock);
+
+    return status;
+}
+
+const oriReturnStatus_t oriFlushAllocations(
+    const oriHandle_t device
+) {
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriMemoryManager_t *manager = &record->memory;
+
+    mtx_lock(&manager->lock);
+
+    if (!manager->dirtyRangeCount) {
+        mtx_unlock(&manager->lock);
+        return ORION_RETURN_STATUS_SKIPPED;
+    }
+
+    // merge every range that touches another, so that each byte is flushed once
+    qsort(manager->dirtyRanges, manager->dirtyRangeCount, sizeof(VkMappedMemoryRange), _oriCompareRanges);
+
+    unsigned int count = 1;
+    for (unsigned int i = 1; i < manager->dirtyRangeCount; i++) {
+        if (_oriRangesTouch(&manager->dirtyRanges[count - 1], &manager->dirtyRanges[i])) {
+            _oriMergeRange(&manager->dirtyRanges[count - 1], &manager->dirtyRanges[i]);
+        } else {
+            manager->dirtyRanges[count++] = manager->dirtyRanges[i];
+        }
+    }
+
+    const VkResult result = vkFlushMappedMemoryRanges(record->handle, count, manager->dirtyRanges);
+    manager->dirtyRangeCount = 0;
+
+    mtx_unlock(&manager->lock);
+
+    if (result) {
+        _oriError(ORIERR_VULKAN_QUERY_FAIL, __func__);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+const oriReturnStatus_t oriInvalidateAllocation(
+    const oriHandle_t device,
+    const oriHandle_t allocation,
+    const VkDeviceSize offset,
+    const VkDeviceSize size
+) {
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriMemoryManager_t *manager = &record->memory;
+
+    mtx_lock(&manager->lock);
+
+    oriReturnStatus_t status = ORION_RETURN_STATUS_ERROR;
+    const _oriMemoryChunk_t *chunk = _oriGetAllocation(record, allocation, __func__);
+
+    VkMappedMemoryRange range;
+    if (chunk && _oriGetMappedRange(record, chunk, offset, size, &range, __func__)) {
+        status = ORION_RETURN_STATUS_OK;
+
+        if (!_oriIsCoherent(manager, chunk) && vkInvalidateMappedMemoryRanges(record->handle, 1, &range)) {
+            _oriError(ORIERR_VULKAN_QUERY_FAIL, __func__);
+            status = ORION_RETURN_STATUS_ERROR;
+        }
+    }
+
+    mtx_unlock(&manager->lock);
+
+    return status;
+}
@@ -0,0 +1,1713 @@
+/* *************************************************************************************** */
+/*                       ORION GRAPHICS LIBRARY AND RENDERING ENGINE                       */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+
+// ============================================================================ //
+// *****                     Doxygen file information                     ***** //
+// ============================================================================ //
+
+/**
+ * @file vk_memory.c
+ * @author jack bennett
+ * @brief Vulkan device memory management
+ *
+ * @copyright Copyright (c) 2022 jack bennett
+ *
+ * This file contains the memory manager of each logical device, which allocates large
+ * blocks of device memory and sub-allocates buffers and images from them.
+ *
+ * Each block is sub-allocated with a TLSF (two-level segregated fit) allocator, so both
+ * allocating and freeing take constant time regardless of how many allocations a block
+ * holds. Allocations are referred to by handles, like other library-owned objects.
+ *
+ * bufferImageGranularity is respected by giving optimally tiled images whole pages of
+ * the granularity to themselves, so a linear resource can never share a page with one.
+ *
+ * The memory types suitable for each oriMemoryUsage_t are ranked once, when the manager
+ * is initialised, taking into account whether the device has resizable BAR.
+ *
+ * Host memory imported with VK_EXT_external_memory_host is kept as a dedicated block like
+ * any other, except that the application owns (and has already mapped) the memory.
+ *
+ */
+
+#include "orion.h"
+#include "orion_errors.h"
+#include "orion_flags.h"
+#include "orion_funcs.h"
+#include "orion_structs.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+
+
+// ============================================================================ //
+// *****                     Private/internal systems                     ***** //
+// ============================================================================ //
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                               TLSF sub-allocator                             //
+
+#define _ORI_TLSF_SL_COUNT (1u << MEMORY_TLSF_SL_BITS)
+#define _ORI_MEMORY_MIN_MASK ((VkDeviceSize) MEMORY_MIN_ALLOCATION_SIZE - 1)
+
+// Index of the highest set bit of a non-zero value.
+//
+static unsigned int _oriFindLastSet(
+    const uint64_t x
+) {
+#   if defined(__GNUC__) || defined(__clang__)
+        return 63 - (unsigned int) __builtin_clzll(x);
+#   else
+        unsigned int i = 0;
+        while (x >> (i + 1)) {
+            i++;
+        }
+        return i;
+#   endif
+}
+
+// Index of the lowest set bit of a non-zero value.
+//
+static unsigned int _oriFindFirstSet(
+    const uint64_t x
+) {
+#   if defined(__GNUC__) || defined(__clang__)
+        return (unsigned int) __builtin_ctzll(x);
+#   else
+        unsigned int i = 0;
+        while (!(x & (1ull << i))) {
+            i++;
+        }
+        return i;
+#   endif
+}
+
+// Get the size class (first and second level indices) of a size of at least MEMORY_MIN_ALLOCATION_SIZE.
+//
+static void _oriTlsfMapping(
+    const VkDeviceSize size,
+    unsigned int *fl,
+    unsigned int *sl
+) {
+    *fl = _oriFindLastSet(size);
+    *sl = (unsigned int) (size >> (*fl - MEMORY_TLSF_SL_BITS)) & (_ORI_TLSF_SL_COUNT - 1);
+}
+
+static void _oriInsertFreeChunk(
+    _oriMemoryBlock_t *block,
+    _oriMemoryChunk_t *chunk
+) {
+    unsigned int fl, sl;
+    _oriTlsfMapping(chunk->size, &fl, &sl);
+
+    chunk->free = true;
+    chunk->prevFree = NULL;
+    chunk->nextFree = block->freeLists[fl][sl];
+    if (chunk->nextFree) {
+        chunk->nextFree->prevFree = chunk;
+    }
+    block->freeLists[fl][sl] = chunk;
+
+    block->flBitmap |= 1ull << fl;
+    block->slBitmaps[fl] |= 1u << sl;
+}
+
+static void _oriRemoveFreeChunk(
+    _oriMemoryBlock_t *block,
+    _oriMemoryChunk_t *chunk
+) {
+    unsigned int fl, sl;
+    _oriTlsfMapping(chunk->size, &fl, &sl);
+
+    if (chunk->prevFree) {
+        chunk->prevFree->nextFree = chunk->nextFree;
+    } else {
+        block->freeLists[fl][sl] = chunk->nextFree;
+    }
+    if (chunk->nextFree) {
+        chunk->nextFree->prevFree = chunk->prevFree;
+    }
+
+    if (!block->freeLists[fl][sl]) {
+        block->slBitmaps[fl] &= ~(1u << sl);
+        if (!block->slBitmaps[fl]) {
+            block->flBitmap &= ~(1ull << fl);
+        }
+    }
+}
+
+// Find a free chunk of at least 'size' bytes.
+//
+static _oriMemoryChunk_t *_oriFindFreeChunk(
+    const _oriMemoryBlock_t *block,
+    const VkDeviceSize size
+) {
+    unsigned int fl, sl;
+
+    // look in the lists of the next size class up and larger (good fit: the size is rounded up to the next class, so the first
+    // chunk of any list found there is large enough)
+    _oriTlsfMapping(size + (1ull << (_oriFindLastSet(size) - MEMORY_TLSF_SL_BITS)) - 1, &fl, &sl);
+
+    uint32_t slMap = block->slBitmaps[fl] & (~0u << sl);
+    if (!slMap) {
+        const uint64_t flMap = (fl < 63) ? block->flBitmap & (~0ull << (fl + 1)) : 0;
+        if (flMap) {
+            fl = _oriFindFirstSet(flMap);
+            slMap = block->slBitmaps[fl];
+        }
+    }
+    if (slMap) {
+        return block->freeLists[fl][_oriFindFirstSet(slMap)];
+    }
+
+    // otherwise, the first chunk in the size's own class may still be large enough (this is always the case for a new block)
+    _oriTlsfMapping(size, &fl, &sl);
+
+    _oriMemoryChunk_t *chunk = block->freeLists[fl][sl];
+    return (chunk && chunk->size >= size) ? chunk : NULL;
+}
+
+const bool _oriReserveChunks(
+    _oriMemoryManager_t *manager,
+    unsigned int count
+) {
+    for (const _oriMemoryChunk_t *cur = manager->spareChunks; cur && count; cur = cur->nextFree) {
+        count--;
+    }
+
+    while (count--) {
+        _oriMemoryChunk_t *chunk = malloc(sizeof(_oriMemoryChunk_t));
+        if (!chunk) {
+            _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+            return false;
+        }
+
+        chunk->nextFree = manager->spareChunks;
+        manager->spareChunks = chunk;
+    }
+
+    return true;
+}
+
+// Take a spare chunk record (_oriReserveChunks() must have been called first).
+//
+static _oriMemoryChunk_t *_oriTakeChunk(
+    _oriMemoryManager_t *manager
+) {
+    _oriMemoryChunk_t *chunk = manager->spareChunks;
+    manager->spareChunks = chunk->nextFree;
+
+    memset(chunk, 0, sizeof(_oriMemoryChunk_t));
+    return chunk;
+}
+
+static void _oriRecycleChunk(
+    _oriMemoryManager_t *manager,
+    _oriMemoryChunk_t *chunk
+) {
+    chunk->nextFree = manager->spareChunks;
+    manager->spareChunks = chunk;
+}
+
+_oriMemoryChunk_t *_oriAllocateFromBlock(
+    _oriMemoryManager_t *manager,
+    _oriMemoryBlock_t *block,
+    const VkDeviceSize size,
+    const VkDeviceSize alignment
+) {
+    // every chunk starts at a multiple of MEMORY_MIN_ALLOCATION_SIZE, so smaller alignments never need padding
+    const VkDeviceSize search = size + ((alignment > MEMORY_MIN_ALLOCATION_SIZE) ? alignment - MEMORY_MIN_ALLOCATION_SIZE : 0);
+    if (search > block->size - block->allocatedSize) {
+        return NULL;
+    }
+
+    _oriMemoryChunk_t *chunk = _oriFindFreeChunk(block, search);
+    if (!chunk) {
+        return NULL;
+    }
+    _oriRemoveFreeChunk(block, chunk);
+
+    // split off padding at the front (the previous chunk can't be free, as free neighbours are always merged)
+    const VkDeviceSize padding = oriAlignUp(chunk->offset, alignment - 1) - chunk->offset;
+    if (padding) {
+        _oriMemoryChunk_t *front = _oriTakeChunk(manager);
+        front->block = block;
+        front->offset = chunk->offset;
+        front->size = padding;
+        front->prevPhysical = chunk->prevPhysical;
+        front->nextPhysical = chunk;
+
+        if (front->prevPhysical) {
+            front->prevPhysical->nextPhysical = front;
+        } else {
+            block->firstChunk = front;
+        }
+        chunk->prevPhysical = front;
+        chunk->offset += padding;
+        chunk->size -= padding;
+
+        _oriInsertFreeChunk(block, front);
+    }
+
+    // split off whatever is left at the back
+    if (chunk->size > size) {
+        _oriMemoryChunk_t *back = _oriTakeChunk(manager);
+        back->block = block;
+        back->offset = chunk->offset + size;
+        back->size = chunk->size - size;
+        back->prevPhysical = chunk;
+        back->nextPhysical = chunk->nextPhysical;
+
+        if (back->nextPhysical) {
+            back->nextPhysical->prevPhysical = back;
+        }
+        chunk->nextPhysical = back;
+        chunk->size = size;
+
+        _oriInsertFreeChunk(block, back);
+    }
+
+    chunk->free = false;
+    block->allocatedSize += chunk->size;
+    block->allocationCount++;
+
+    return chunk;
+}
+
+// Return an allocated chunk to its block, merging it with any free neighbours.
+//
+static void _oriFreeToBlock(
+    _oriMemoryManager_t *manager,
+    _oriMemoryChunk_t *chunk
+) {
+    _oriMemoryBlock_t *block = chunk->block;
+
+    block->allocatedSize -= chunk->size;
+    block->allocationCount--;
+
+    if (chunk->evictionCallback) {
+        _oriClearEvictable(manager, chunk);
+    }
+
+    chunk->handle = ORION_NULL_HANDLE;
+    chunk->buffer = VK_NULL_HANDLE;
+    chunk->movable = false;
+    chunk->retired = false;
+
+    _oriMemoryChunk_t *next = chunk->nextPhysical;
+    if (next && next->free) {
+        _oriRemoveFreeChunk(block, next);
+
+        chunk->size += next->size;
+        chunk->nextPhysical = next->nextPhysical;
+        if (chunk->nextPhysical) {
+            chunk->nextPhysical->prevPhysical = chunk;
+        }
+
+        _oriRecycleChunk(manager, next);
+    }
+
+    _oriMemoryChunk_t *prev = chunk->prevPhysical;
+    if (prev && prev->free) {
+        _oriRemoveFreeChunk(block, prev);
+
+        prev->size += chunk->size;
+        prev->nextPhysical = chunk->nextPhysical;
+        if (prev->nextPhysical) {
+            prev->nextPhysical->prevPhysical = prev;
+        }
+
+        _oriRecycleChunk(manager, chunk);
+        chunk = prev;
+    }
+
+    _oriInsertFreeChunk(block, chunk);
+}
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                                 Memory blocks                                //
+
+// Allocate a new block of device memory and add it to the front of the list of blocks of its memory type.
+// If 'dedicated' is true, or 'importInfo' is not NULL, the block is made a dedicated block: its only chunk is allocated straight
+// away. 'dedicatedInfo' or 'importInfo', if not NULL (only one may be), is chained to the allocation.
+// Returns NULL (with the Vulkan error in resultOut) if the memory could not be allocated.
+//
+static _oriMemoryBlock_t *_oriCreateMemoryBlock(
+    _oriVkDevice_t *device,
+    const uint32_t memoryTypeIndex,
+    const VkDeviceSize size,
+    const bool dedicated,
+    const VkMemoryDedicatedAllocateInfo *dedicatedInfo,
+    const VkImportMemoryHostPointerInfoEXT *importInfo,
+    VkResult *resultOut
+) {
+    _oriMemoryManager_t *manager = &device->memory;
+
+    if (manager->deviceMemoryCount >= device->limits.maxMemoryAllocationCount) {
+        *resultOut = VK_ERROR_TOO_MANY_OBJECTS;
+        return NULL;
+    }
+
+    _oriMemoryBlock_t *block = calloc(1, sizeof(_oriMemoryBlock_t));
+    if (!block) {
+        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+        *resultOut = VK_ERROR_OUT_OF_HOST_MEMORY;
+        return NULL;
+    }
+
+    const VkMemoryAllocateInfo allocateInfo = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .pNext = (importInfo) ? (const void *) importInfo : (const void *) dedicatedInfo,
+        .allocationSize = size,
+        .memoryTypeIndex = memoryTypeIndex
+    };
+
+    *resultOut = vkAllocateMemory(device->handle, &allocateInfo, _orion.callbacks.vulkanAllocators, &block->memory);
+    if (*resultOut) {
+        free(block);
+        return NULL;
+    }
+
+    // host-visible blocks are mapped once, for their whole lifetime, so allocations never need to be mapped and unmapped
+    // (imported host memory is already mapped by the application)
+    if (importInfo) {
+        block->imported = true;
+        if (manager->properties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+            block->data = importInfo->pHostPointer;
+        }
+    } else if (manager->properties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+        void *data;
+        *resultOut = vkMapMemory(device->handle, block->memory, 0, VK_WHOLE_SIZE, 0, &data);
+        if (*resultOut) {
+            vkFreeMemory(device->handle, block->memory, _orion.callbacks.vulkanAllocators);
+            free(block);
+            return NULL;
+        }
+        block->data = data;
+    }
+
+    _oriTrackObjectCreation(VK_OBJECT_TYPE_DEVICE_MEMORY, _ORI_NON_DISPATCHABLE_HANDLE_U64(block->memory), size);
+
+    block->size = size;
+    block->memoryTypeIndex = memoryTypeIndex;
+
+    // the block starts as a single free chunk (or, if it is dedicated, a single allocated one)
+    block->firstChunk = _oriTakeChunk(manager);
+    block->firstChunk->block = block;
+    block->firstChunk->size = size;
+
+    if (dedicated || importInfo) {
+        block->dedicated = true;
+        block->allocatedSize = size;
+        block->allocationCount = 1;
+    } else {
+        _oriInsertFreeChunk(block, block->firstChunk);
+    }
+
+    block->next = manager->blocks[memoryTypeIndex];
+    manager->blocks[memoryTypeIndex] = block;
+    manager->deviceMemoryCount++;
+
+    _oriAccountDeviceMemory(device, memoryTypeIndex, size, true);
+
+#   ifdef __oridebug
+        _oriLog("%llu byte %smemory block allocated from memory type %u (%s)", (unsigned long long) size,
+            (importInfo) ? "imported " : (dedicated) ? "dedicated " : "", memoryTypeIndex, __func__);
+#   endif
+
+    return block;
+}
+
+// Free a block of device memory, along with all of its chunk records.
+//
+static void _oriFreeMemoryBlock(
+    _oriVkDevice_t *device,
+    _oriMemoryBlock_t *block
+) {
+    _oriMemoryManager_t *manager = &device->memory;
+
+    for (_oriMemoryBlock_t **cur = &manager->blocks[block->memoryTypeIndex]; *cur; cur = &(*cur)->next) {
+        if (*cur == block) {
+            *cur = block->next;
+            break;
+        }
+    }
+
+    _oriMemoryChunk_t *chunk = block->firstChunk;
+    while (chunk) {
+        _oriMemoryChunk_t *next = chunk->nextPhysical;
+        _oriRecycleChunk(manager, chunk);
+        chunk = next;
+    }
+
+    if (block->data) {
+        _oriDropDirtyRanges(manager, block->memory);
+    }
+
+    // (unmapped implicitly)
+    _oriTrackObjectDestruction(VK_OBJECT_TYPE_DEVICE_MEMORY, _ORI_NON_DISPATCHABLE_HANDLE_U64(block->memory));
+    vkFreeMemory(device->handle, block->memory, _orion.callbacks.vulkanAllocators);
+    manager->deviceMemoryCount--;
+
+    _oriAccountDeviceMemory(device, block->memoryTypeIndex, block->size, false);
+
+    free(block);
+}
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                           Device memory management                           //
+
+// How the memory type of an allocation is chosen: either from the types ranked for a usage when the manager was initialised
+// (of which only those with every required property are allowed), or by counting the preferred properties of each type
+// that has every required property.
+//
+typedef struct _oriMemoryTypeChoice_t {
+    bool byUsage;
+    oriMemoryUsage_t usage;
+    VkMemoryPropertyFlags requiredFlags;
+    VkMemoryPropertyFlags preferredFlags;
+} _oriMemoryTypeChoice_t;
+
+// Score a memory type for a usage, the higher the better. Returns -1 if the memory type can't be used for it at all.
+//
+static int _oriScoreMemoryType(
+    const oriMemoryUsage_t usage,
+    const VkMemoryPropertyFlags flags,
+    const bool resizableBar
+) {
+    // (device-coherent memory is uncached on the device, which makes it much slower to use)
+    if (flags & (VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT | VK_MEMORY_PROPERTY_PROTECTED_BIT | VK_MEMORY_PROPERTY_DEVICE_COHERENT_BIT_AMD)) {
+        return -1;
+    }
+
+    const bool deviceLocal = flags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    const bool hostVisible = flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+    const bool hostCoherent = flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    const bool hostCached = flags & VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+
+    switch (usage) {
+        // the small host-visible heap of devices without resizable BAR is left for memory that the CPU writes to every frame
+        case ORION_MEMORY_USAGE_GPU_ONLY:
+            return deviceLocal * 4 + !hostVisible * 2;
+        case ORION_MEMORY_USAGE_UPLOAD_ONCE:
+            return deviceLocal * 4 + (hostVisible == resizableBar) * 2;
+
+        // the GPU reads host-visible device-local memory over BAR, which is faster than reading system memory over PCIe
+        case ORION_MEMORY_USAGE_CPU_TO_GPU:
+            return (hostVisible) ? deviceLocal * 4 + hostCoherent * 2 + !hostCached : -1;
+
+        // the CPU reads uncached memory (and device-local memory over BAR) very slowly
+        case ORION_MEMORY_USAGE_GPU_TO_CPU:
+            return (hostVisible) ? hostCached * 4 + !deviceLocal * 2 + hostCoherent : -1;
+
+        // the copy engine reads system memory just as well, so device-local memory is kept for resources
+        case ORION_MEMORY_USAGE_STAGING:
+            return (hostVisible) ? !deviceLocal * 4 + hostCoherent * 2 + !hostCached : -1;
+
+        default:
+            return -1;
+    }
+}
+
+// Rank the memory types of each usage (which is done once, when the manager is initialised).
+//
+static void _oriBuildMemoryUsageTable(
+    _oriMemoryManager_t *manager
+) {
+    const VkPhysicalDeviceMemoryProperties *properties = &manager->properties;
+
+    // a host-visible device-local heap larger than MEMORY_SMALL_HEAP_SIZE means resizable BAR (or memory shared with the host)
+    manager->resizableBar = false;
+    for (uint32_t i = 0; i < properties->memoryTypeCount; i++) {
+        const VkMemoryPropertyFlags flags = properties->memoryTypes[i].propertyFlags;
+
+        manager->resizableBar |= (flags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) && (flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) &&
+            properties->memoryHeaps[properties->memoryTypes[i].heapIndex].size > MEMORY_SMALL_HEAP_SIZE;
+    }
+
+    for (unsigned int usage = 0; usage < _ORI_MEMORY_USAGE_COUNT; usage++) {
+        int scores[VK_MAX_MEMORY_TYPES];
+        unsigned int count = 0;
+
+        for (uint32_t i = 0; i < properties->memoryTypeCount; i++) {
+            const int score = _oriScoreMemoryType((oriMemoryUsage_t) usage, properties->memoryTypes[i].propertyFlags, manager->resizableBar);
+            if (score < 0) {
+                continue;
+            }
+
+            // insertion sort, keeping types with equal scores in index order
+            unsigned int j = count++;
+            for (; j > 0 && scores[j - 1] < score; j--) {
+                scores[j] = scores[j - 1];
+                manager->usageTypes[usage][j] = manager->usageTypes[usage][j - 1];
+            }
+            scores[j] = score;
+            manager->usageTypes[usage][j] = i;
+        }
+
+        manager->usageTypeCounts[usage] = count;
+    }
+}
+
+const bool _oriInitMemoryManager(
+    _oriVkDevice_t *device
+) {
+    _oriMemoryManager_t *manager = &device->memory;
+    memset(manager, 0, sizeof(_oriMemoryManager_t));
+
+    if (mtx_init(&manager->lock, mtx_plain) != thrd_success) {
+        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+        return false;
+    }
+
+    vkGetPhysicalDeviceMemoryProperties(device->physicalDevice, &manager->properties);
+
+    // blocks are sized so that small heaps (e.g. the host-visible device-local heap without resizable BAR) can't be taken up
+    // by one or two of them
+    for (uint32_t i = 0; i < manager->properties.memoryTypeCount; i++) {
+        const VkDeviceSize heapSize = manager->properties.memoryHeaps[manager->properties.memoryTypes[i].heapIndex].size;
+
+        manager->blockSizes[i] = (heapSize <= MEMORY_SMALL_HEAP_SIZE) ? oriAlignUp(heapSize / 8, _ORI_MEMORY_MIN_MASK) : MEMORY_BLOCK_SIZE;
+    }
+
+    _oriBuildMemoryUsageTable(manager);
+    _oriInitMemoryBudget(device);
+
+    return true;
+}
+
+void _oriDestroyMemoryManager(
+    _oriVkDevice_t *device
+) {
+    _oriMemoryManager_t *manager = &device->memory;
+
+#   ifdef __oridebug
+        const unsigned int leaked = manager->allocations.used - manager->allocations.freeCount;
+        if (leaked) {
+            _oriWarning("%u memory allocation%s not freed before device was destroyed (%s)", leaked, (leaked == 1) ? "" : "s", __func__);
+        }
+#   endif
+
+    for (uint32_t i = 0; i < VK_MAX_MEMORY_TYPES; i++) {
+        while (manager->blocks[i]) {
+            // buffers owned by allocations (including those waiting to be released by the defragmenter) are destroyed with them
+            for (const _oriMemoryChunk_t *chunk = manager->blocks[i]->firstChunk; chunk; chunk = chunk->nextPhysical) {
+                if (chunk->buffer) {
+                    _oriTrackObjectDestruction(VK_OBJECT_TYPE_BUFFER, _ORI_NON_DISPATCHABLE_HANDLE_U64(chunk->buffer));
+                    vkDestroyBuffer(device->handle, chunk->buffer, _orion.callbacks.vulkanAllocators);
+                }
+            }
+
+            _oriFreeMemoryBlock(device, manager->blocks[i]);
+        }
+    }
+
+    while (manager->spareChunks) {
+        _oriMemoryChunk_t *next = manager->spareChunks->nextFree;
+        free(manager->spareChunks);
+        manager->spareChunks = next;
+    }
+
+    free(manager->dirtyRanges);
+
+    _oriFreeHandleTable(&manager->allocations);
+    mtx_destroy(&manager->lock);
+}
+
+// Count the bits set in a memory property mask.
+//
+static unsigned int _oriCountFlags(
+    VkMemoryPropertyFlags flags
+) {
+    unsigned int count = 0;
+    for (; flags; flags &= flags - 1) {
+        count++;
+    }
+
+    return count;
+}
+
+// List the memory types allowed by 'typeBits' that have every required property, those with the most preferred properties first.
+// Returns the amount of types listed.
+//
+static unsigned int _oriRankMemoryTypes(
+    const _oriMemoryManager_t *manager,
+    const uint32_t typeBits,
+    const VkMemoryPropertyFlags requiredFlags,
+    const VkMemoryPropertyFlags preferredFlags,
+    uint32_t *typesOut
+) {
+    unsigned int scores[VK_MAX_MEMORY_TYPES];
+    unsigned int count = 0;
+
+    for (uint32_t i = 0; i < manager->properties.memoryTypeCount; i++) {
+        const VkMemoryPropertyFlags flags = manager->properties.memoryTypes[i].propertyFlags;
+        if (!(typeBits & (1u << i)) || (flags & requiredFlags) != requiredFlags) {
+            continue;
+        }
+
+        // insertion sort, keeping types with equal scores in index order
+        const unsigned int score = _oriCountFlags(flags & preferredFlags);
+
+        unsigned int j = count++;
+        for (; j > 0 && scores[j - 1] < score; j--) {
+            scores[j] = scores[j - 1];
+            typesOut[j] = typesOut[j - 1];
+        }
+        scores[j] = score;
+        typesOut[j] = i;
+    }
+
+    return count;
+}
+
+// List the memory types allowed by 'typeBits' in the order given by a choice.
+// Returns the amount of types listed.
+//
+static unsigned int _oriListMemoryTypes(
+    const _oriMemoryManager_t *manager,
+    const _oriMemoryTypeChoice_t *choice,
+    const uint32_t typeBits,
+    uint32_t *typesOut
+) {
+    if (!choice->byUsage) {
+        return _oriRankMemoryTypes(manager, typeBits, choice->requiredFlags, choice->preferredFlags, typesOut);
+    }
+
+    unsigned int count = 0;
+    for (unsigned int i = 0; i < manager->usageTypeCounts[choice->usage]; i++) {
+        const uint32_t type = manager->usageTypes[choice->usage][i];
+        const VkMemoryPropertyFlags flags = manager->properties.memoryTypes[type].propertyFlags;
+
+        if ((typeBits & (1u << type)) && (flags & choice->requiredFlags) == choice->requiredFlags) {
+            typesOut[count++] = type;
+        }
+    }
+
+    return count;
+}
+
+// Memory requirements of a resource, and whether the driver wants it to have its own device memory.
+//
+typedef struct _oriResourceRequirements_t {
+    VkMemoryRequirements memory;
+    bool prefersDedicated;
+    bool requiresDedicated;
+
+    // the resource, if known (for VkMemoryDedicatedAllocateInfo)
+    VkBuffer buffer;
+    VkImage image;
+} _oriResourceRequirements_t;
+
+// Query the memory requirements of a buffer or image (the other must be VK_NULL_HANDLE).
+// Without Vulkan 1.1, the driver can't say whether it wants dedicated memory, so it is never asked for.
+//
+static void _oriGetResourceRequirements(
+    const _oriVkDevice_t *device,
+    const VkBuffer buffer,
+    const VkImage image,
+    _oriResourceRequirements_t *requirementsOut
+) {
+    *requirementsOut = (_oriResourceRequirements_t) {
+        .buffer = buffer,
+        .image = image
+    };
+
+    if (!device->vulkan11) {
+        if (buffer) {
+            vkGetBufferMemoryRequirements(device->handle, buffer, &requirementsOut->memory);
+        } else {
+            vkGetImageMemoryRequirements(device->handle, image, &requirementsOut->memory);
+        }
+
+        return;
+    }
+
+    VkMemoryDedicatedRequirements dedicated = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS
+    };
+
+    VkMemoryRequirements2 requirements = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2,
+        .pNext = &dedicated
+    };
+
+    if (buffer) {
+        const VkBufferMemoryRequirementsInfo2 info = {
+            .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_REQUIREMENTS_INFO_2,
+            .buffer = buffer
+        };
+
+        vkGetBufferMemoryRequirements2(device->handle, &info, &requirements);
+    } else {
+        const VkImageMemoryRequirementsInfo2 info = {
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2,
+            .image = image
+        };
+
+        vkGetImageMemoryRequirements2(device->handle, &info, &requirements);
+    }
+
+    requirementsOut->memory = requirements.memoryRequirements;
+    requirementsOut->prefersDedicated = dedicated.prefersDedicatedAllocation;
+    requirementsOut->requiresDedicated = dedicated.requiresDedicatedAllocation;
+}
+
+// Allocate memory for a resource and create a handle for it (the device's memory lock must be held).
+// Resources that the driver asks for dedicated memory for, and those of at least MEMORY_DEDICATED_ALLOCATION_SIZE bytes, are
+// given a dedicated block; unless it is required, they are sub-allocated if no dedicated block could be allocated.
+//
+static const oriReturnStatus_t _oriAllocateMemoryLocked(
+    _oriVkDevice_t *device,
+    const _oriResourceRequirements_t *resource,
+    const _oriMemoryTypeChoice_t *choice,
+    const bool linear,
+    _oriMemoryChunk_t **chunkOut,
+    oriHandle_t *allocationOut,
+    const char *func
+) {
+    _oriMemoryManager_t *manager = &device->memory;
+    const VkMemoryRequirements *requirements = &resource->memory;
+
+    VkDeviceSize alignment = (requirements->alignment > MEMORY_MIN_ALLOCATION_SIZE) ? requirements->alignment : MEMORY_MIN_ALLOCATION_SIZE;
+    VkDeviceSize size = oriAlignUp((requirements->size) ? requirements->size : 1, _ORI_MEMORY_MIN_MASK);
+
+    // optimally tiled images are given whole pages of bufferImageGranularity, so that no linear resource can share a page with them
+    if (!linear && device->limits.bufferImageGranularity > alignment) {
+        alignment = device->limits.bufferImageGranularity;
+        size = oriAlignUp(size, device->limits.bufferImageGranularityMask);
+    }
+
+    uint32_t types[VK_MAX_MEMORY_TYPES];
+    const unsigned int typeCount = _oriListMemoryTypes(manager, choice, requirements->memoryTypeBits, types);
+    if (!typeCount) {
+        _oriError(ORIERR_NO_SUITABLE_MEMORY_TYPE, func);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    // (one record for a new block, and two for the chunks split off in _oriAllocateFromBlock())
+    if (!_oriReserveChunks(manager, 3)) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriMemoryChunk_t *chunk = NULL;
+    VkResult result = VK_SUCCESS;
+
+    if (resource->requiresDedicated || resource->prefersDedicated || requirements->size >= MEMORY_DEDICATED_ALLOCATION_SIZE) {
+        // (dedicated memory must be exactly the size of the resource)
+        const VkMemoryDedicatedAllocateInfo dedicatedInfo = {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO,
+            .image = resource->image,
+            .buffer = resource->buffer
+        };
+
+        // the driver is only told which resource the memory is for if there is one (raw allocations have none), and if it
+        // supports VkMemoryDedicatedAllocateInfo at all (Vulkan 1.1)
+        const VkMemoryDedicatedAllocateInfo *info = (device->vulkan11 && (resource->image || resource->buffer)) ? &dedicatedInfo : NULL;
+
+        for (unsigned int i = 0; !chunk && i < typeCount; i++) {
+            _oriMemoryBlock_t *block = _oriCreateMemoryBlock(device, types[i], requirements->size, true, info, NULL, &result);
+            if (block) {
+                chunk = block->firstChunk;
+            }
+        }
+    }
+
+    // try each suitable memory type in order, falling back to the next if a new block can't be allocated from one
+    for (unsigned int i = 0; !chunk && !resource->requiresDedicated && i < typeCount; i++) {
+        for (_oriMemoryBlock_t *block = manager->blocks[types[i]]; !chunk && block; block = block->next) {
+            chunk = _oriAllocateFromBlock(manager, block, size, alignment);
+        }
+
+        if (!chunk) {
+            const VkDeviceSize minBlockSize = oriAlignUp(size + alignment, _ORI_MEMORY_MIN_MASK);
+            const VkDeviceSize blockSize = (manager->blockSizes[types[i]] > minBlockSize) ? manager->blockSizes[types[i]] : minBlockSize;
+
+            _oriMemoryBlock_t *block = _oriCreateMemoryBlock(device, types[i], blockSize, false, NULL, NULL, &result);
+            if (block) {
+                chunk = _oriAllocateFromBlock(manager, block, size, alignment);
+            }
+        }
+    }
+
+    if (!chunk) {
+#       ifdef __oridebug
+            _oriWarning("failed to allocate %llu bytes of device memory (VkResult %d) (%s)", (unsigned long long) size, result, func);
+#       endif
+
+        _oriError(ORIERR_MEMORY_ALLOCATION_FAIL, func);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    const oriHandle_t handle = _oriCreateHandle(&manager->allocations, _ORI_HANDLE_TYPE_ALLOCATION, chunk);
+    if (!handle) {
+        _oriReleaseChunk(device, chunk);
+
+        _oriError(ORIERR_OBJECT_CREATION_FAIL, "allocation handle table is full");
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    chunk->handle = handle;
+    chunk->alignment = alignment;
+
+    *chunkOut = chunk;
+    *allocationOut = handle;
+    return ORION_RETURN_STATUS_OK;
+}
+
+const bool _oriAllocateDeviceMemory(
+    _oriVkDevice_t *device,
+    const VkMemoryRequirements *requirements,
+    const oriMemoryUsage_t usage,
+    const VkMemoryPropertyFlags requiredFlags,
+    VkDeviceMemory *memoryOut,
+    uint32_t *memoryTypeOut,
+    const char *func
+) {
+    _oriMemoryManager_t *manager = &device->memory;
+
+    const _oriMemoryTypeChoice_t choice = {
+        .byUsage = true,
+        .usage = usage,
+        .requiredFlags = requiredFlags
+    };
+
+    uint32_t types[VK_MAX_MEMORY_TYPES];
+    const unsigned int typeCount = _oriListMemoryTypes(manager, &choice, requirements->memoryTypeBits, types);
+    if (!typeCount) {
+        _oriError(ORIERR_NO_SUITABLE_MEMORY_TYPE, func);
+        return false;
+    }
+
+    VkResult result = VK_ERROR_TOO_MANY_OBJECTS;
+
+    mtx_lock(&manager->lock);
+
+    for (unsigned int i = 0; i < typeCount && manager->deviceMemoryCount < device->limits.maxMemoryAllocationCount; i++) {
+        const VkMemoryAllocateInfo allocateInfo = {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+            .allocationSize = requirements->size,
+            .memoryTypeIndex = types[i]
+        };
+
+        result = vkAllocateMemory(device->handle, &allocateInfo, _orion.callbacks.vulkanAllocators, memoryOut);
+        if (!result) {
+            manager->deviceMemoryCount++;
+            _oriAccountDeviceMemory(device, types[i], requirements->size, true);
+
+            *memoryTypeOut = types[i];
+            break;
+        }
+    }
+
+    mtx_unlock(&manager->lock);
+
+    if (result) {
+#       ifdef __oridebug
+            _oriWarning("failed to allocate %llu bytes of device memory (VkResult %d) (%s)", (unsigned long long) requirements->size, result, func);
+#       endif
+
+        _oriError(ORIERR_MEMORY_ALLOCATION_FAIL, func);
+        return false;
+    }
+
+    _oriTrackObjectCreation(VK_OBJECT_TYPE_DEVICE_MEMORY, _ORI_NON_DISPATCHABLE_HANDLE_U64(*memoryOut), requirements->size);
+    return true;
+}
+
+void _oriFreeDeviceMemory(
+    _oriVkDevice_t *device,
+    const VkDeviceMemory memory,
+    const uint32_t memoryTypeIndex,
+    const VkDeviceSize size
+) {
+    _oriTrackObjectDestruction(VK_OBJECT_TYPE_DEVICE_MEMORY, _ORI_NON_DISPATCHABLE_HANDLE_U64(memory));
+    vkFreeMemory(device->handle, memory, _orion.callbacks.vulkanAllocators);
+
+    mtx_lock(&device->memory.lock);
+    device->memory.deviceMemoryCount--;
+    _oriAccountDeviceMemory(device, memoryTypeIndex, size, false);
+    mtx_unlock(&device->memory.lock);
+}
+
+const VkDeviceSize _oriReleaseChunk(
+    _oriVkDevice_t *device,
+    _oriMemoryChunk_t *chunk
+) {
+    _oriMemoryManager_t *manager = &device->memory;
+    _oriMemoryBlock_t *block = chunk->block;
+
+    if (chunk->buffer) {
+        _oriTrackObjectDestruction(VK_OBJECT_TYPE_BUFFER, _ORI_NON_DISPATCHABLE_HANDLE_U64(chunk->buffer));
+        vkDestroyBuffer(device->handle, chunk->buffer, _orion.callbacks.vulkanAllocators);
+    }
+
+    // (dedicated blocks are released along with their allocation; their chunk never goes into the free lists)
+    if (block->dedicated) {
+        if (chunk->evictionCallback) {
+            _oriClearEvictable(manager, chunk);
+        }
+
+        const VkDeviceSize size = block->size;
+        _oriFreeMemoryBlock(device, block);
+
+        return size;
+    }
+
+    _oriFreeToBlock(manager, chunk);
+
+    // empty blocks are released, except for the last block of each memory type (so that allocating and freeing a single
+    // resource repeatedly doesn't allocate device memory every time)
+    if (!block->allocationCount && (manager->blocks[block->memoryTypeIndex] != block || block->next)) {
+        const VkDeviceSize size = block->size;
+        _oriFreeMemoryBlock(device, block);
+
+        return size;
+    }
+
+    return 0;
+}
+
+// Free an allocation (the device's memory lock must be held and the handle must be valid).
+//
+static void _oriFreeMemoryLocked(
+    _oriVkDevice_t *device,
+    const oriHandle_t allocation,
+    _oriMemoryChunk_t *chunk
+) {
+    _oriDestroyHandle(&device->memory.allocations, allocation);
+    _oriReleaseChunk(device, chunk);
+}
+
+// Bind a buffer or image to an allocation (the device's memory lock must be held).
+//
+static const oriReturnStatus_t _oriBindMemoryLocked(
+    _oriVkDevice_t *device,
+    const _oriMemoryChunk_t *chunk,
+    const VkBuffer buffer,
+    const VkImage image,
+    const VkDeviceSize offset,
+    const char *func
+) {
+    // (Vulkan can't tell that a resource running past the end of an allocation overlaps its neighbours in the block)
+    VkMemoryRequirements requirements;
+    if (buffer) {
+        vkGetBufferMemoryRequirements(device->handle, buffer, &requirements);
+    } else {
+        vkGetImageMemoryRequirements(device->handle, image, &requirements);
+    }
+
+    if (offset >= chunk->size || requirements.size > chunk->size - offset ||
+        !oriIsAligned(chunk->offset + offset, requirements.alignment - 1)
+    ) {
+        _oriError(ORIERR_OFFSET_OUT_OF_RANGE, func);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    const VkResult result = (buffer) ?
+        vkBindBufferMemory(device->handle, buffer, chunk->block->memory, chunk->offset + offset) :
+        vkBindImageMemory(device->handle, image, chunk->block->memory, chunk->offset + offset);
+
+    if (result) {
+        _oriError(ORIERR_MEMORY_ALLOCATION_FAIL, func);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+// Evict allocations if an allocation has taken a heap over its budget (the memory lock must NOT be held, as eviction callbacks
+// are called without it).
+//
+static void _oriCheckMemoryBudget(
+    _oriVkDevice_t *device,
+    const oriHandle_t deviceHandle
+) {
+    if (atomic_load(&device->memory.overBudget)) {
+        _oriEnforceMemoryBudget(device, deviceHandle);
+    }
+}
+
+
+// Implementation of oriAllocateMemory() and oriAllocateMemoryForUsage().
+//
+static const oriReturnStatus_t _oriAllocateMemory(
+    const oriHandle_t device,
+    const VkMemoryRequirements *requirements,
+    const _oriMemoryTypeChoice_t *choice,
+    const bool linear,
+    oriHandle_t *allocationOut,
+    const char *func
+) {
+    if (_ORI_CONTRACT_BROKEN(!requirements)) {
+        _oriError(ORIERR_NULL_POINTER, func);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+    if (!allocationOut) {
+        _oriWarning("all output variables NULL in call to %s", func);
+        return ORION_RETURN_STATUS_NO_OUTPUT;
+    }
+
+    _oriVkDevice_t *record = _oriGetDevice(device, func);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    // (the resource isn't known, so only its size can make it dedicated)
+    const _oriResourceRequirements_t resource = {
+        .memory = *requirements
+    };
+
+    _oriMemoryChunk_t *chunk;
+
+    mtx_lock(&record->memory.lock);
+    const oriReturnStatus_t status = _oriAllocateMemoryLocked(record, &resource, choice, linear, &chunk, allocationOut, func);
+    mtx_unlock(&record->memory.lock);
+
+    _oriCheckMemoryBudget(record, device);
+
+    return status;
+}
+
+// Implementation of oriCreateBuffer() and oriCreateBufferForUsage().
+//
+static const oriReturnStatus_t _oriCreateBuffer(
+    const oriHandle_t device,
+    const VkBufferCreateInfo *createInfo,
+    const _oriMemoryTypeChoice_t *choice,
+    oriHandle_t *allocationOut,
+    VkBuffer *bufferOut,
+    const char *func
+) {
+    if (_ORI_CONTRACT_BROKEN(!createInfo)) {
+        _oriError(ORIERR_NULL_POINTER, func);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+    if (!allocationOut) {
+        _oriWarning("all output variables NULL in call to %s", func);
+        return ORION_RETURN_STATUS_NO_OUTPUT;
+    }
+
+    _oriVkDevice_t *record = _oriGetDevice(device, func);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    VkBuffer buffer;
+    if (vkCreateBuffer(record->handle, createInfo, _orion.callbacks.vulkanAllocators, &buffer)) {
+        _oriError(ORIERR_OBJECT_CREATION_FAIL, "failed to create buffer");
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriTrackObjectCreation(VK_OBJECT_TYPE_BUFFER, _ORI_NON_DISPATCHABLE_HANDLE_U64(buffer), createInfo->size);
+
+    _oriResourceRequirements_t resource;
+    _oriGetResourceRequirements(record, buffer, VK_NULL_HANDLE, &resource);
+
+    _oriMemoryChunk_t *chunk;
+    oriHandle_t allocation;
+
+    mtx_lock(&record->memory.lock);
+
+    oriReturnStatus_t status = _oriAllocateMemoryLocked(record, &resource, choice, true, &chunk, &allocation, func);
+    if (!status) {
+        status = _oriBindMemoryLocked(record, chunk, buffer, VK_NULL_HANDLE, 0, func);
+        if (status) {
+            _oriFreeMemoryLocked(record, allocation, chunk);
+        }
+    }
+
+    if (!status) {
+        // the buffer can be recreated elsewhere by the defragmenter if it is sub-allocated, it can be copied, nothing that the library doesn't know
+        // about (extension structures, queue family indices) went into creating it, and nothing depends on its address
+        chunk->buffer = buffer;
+        chunk->bufferSize = createInfo->size;
+        chunk->bufferUsage = createInfo->usage;
+        chunk->bufferFlags = createInfo->flags;
+        chunk->movable = !chunk->block->dedicated && !createInfo->pNext && createInfo->sharingMode == VK_SHARING_MODE_EXCLUSIVE &&
+            !(createInfo->flags & (VK_BUFFER_CREATE_SPARSE_BINDING_BIT | VK_BUFFER_CREATE_DEVICE_ADDRESS_CAPTURE_REPLAY_BIT)) &&
+            !(createInfo->usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) &&
+            (createInfo->usage & (VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT)) ==
+                (VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+    }
+
+    mtx_unlock(&record->memory.lock);
+
+    _oriCheckMemoryBudget(record, device);
+
+    if (status) {
+        _oriTrackObjectDestruction(VK_OBJECT_TYPE_BUFFER, _ORI_NON_DISPATCHABLE_HANDLE_U64(buffer));
+        vkDestroyBuffer(record->handle, buffer, _orion.callbacks.vulkanAllocators);
+
+        return status;
+    }
+
+    *allocationOut = allocation;
+    if (bufferOut) {
+        *bufferOut = buffer;
+    }
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+
+// Import host memory as a dedicated block and create a handle for it, binding a buffer to it if there is one (the device's
+// memory lock must be held).
+// The block covers whole multiples of minImportedHostPointerAlignment around the application's data; the allocation starts at
+// the data itself, 'padding' bytes into the block.
+//
+static const oriReturnStatus_t _oriImportHostMemoryLocked(
+    _oriVkDevice_t *device,
+    const VkImportMemoryHostPointerInfoEXT *importInfo,
+    const VkDeviceSize padding,
+    const VkDeviceSize size,
+    const uint32_t *types,
+    const unsigned int typeCount,
+    const VkBuffer buffer,
+    _oriMemoryChunk_t **chunkOut,
+    oriHandle_t *allocationOut,
+    const char *func
+) {
+    _oriMemoryManager_t *manager = &device->memory;
+    const VkDeviceSize importSize = oriAlignUp(padding + size, device->limits.minImportedHostPointerMask);
+
+    if (!_oriReserveChunks(manager, 1)) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriMemoryBlock_t *block = NULL;
+    VkResult result = VK_SUCCESS;
+    for (unsigned int i = 0; !block && i < typeCount; i++) {
+        block = _oriCreateMemoryBlock(device, types[i], importSize, true, NULL, importInfo, &result);
+    }
+
+    if (!block) {
+#       ifdef __oridebug
+            _oriWarning("failed to import %llu bytes of host memory (VkResult %d) (%s)", (unsigned long long) importSize, result, func);
+#       endif
+
+        _oriError(ORIERR_MEMORY_ALLOCATION_FAIL, func);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriMemoryChunk_t *chunk = block->firstChunk;
+    chunk->offset = padding;
+    chunk->size = size;
+
+    if (buffer && vkBindBufferMemory(device->handle, buffer, block->memory, padding)) {
+        _oriReleaseChunk(device, chunk);
+
+        _oriError(ORIERR_MEMORY_ALLOCATION_FAIL, func);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    const oriHandle_t handle = _oriCreateHandle(&manager->allocations, _ORI_HANDLE_TYPE_ALLOCATION, chunk);
+    if (!handle) {
+        _oriReleaseChunk(device, chunk);
+
+        _oriError(ORIERR_OBJECT_CREATION_FAIL, "allocation handle table is full");
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    chunk->handle = handle;
+    chunk->alignment = 1;
+
+    *chunkOut = chunk;
+    *allocationOut = handle;
+    return ORION_RETURN_STATUS_OK;
+}
+
+// ============================================================================ //
+// *****                   Orion library public interface                 ***** //
+// ============================================================================ //
+
+
+// ----[Orion library public interface]---------------------------------------- //
+//                           Vulkan memory management                           //
+
+const oriReturnStatus_t oriFindMemoryTypeForUsage(
+    const oriHandle_t device,
+    const oriMemoryUsage_t usage,
+    const uint32_t memoryTypeBits,
+    uint32_t *memoryTypeIndexOut
+) {
+    if (!memoryTypeIndexOut) {
+        _oriWarning("all output variables NULL in call to %s", __func__);
+        return ORION_RETURN_STATUS_NO_OUTPUT;
+    }
+    if ((unsigned int) usage >= _ORI_MEMORY_USAGE_COUNT) {
+        _oriError(ORIERR_INVALID_OBJECT, __func__);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    // (the table never changes after the device is created, so it can be read without the lock)
+    const _oriMemoryManager_t *manager = &record->memory;
+    for (unsigned int i = 0; i < manager->usageTypeCounts[usage]; i++) {
+        if (memoryTypeBits & (1u << manager->usageTypes[usage][i])) {
+            *memoryTypeIndexOut = manager->usageTypes[usage][i];
+            return ORION_RETURN_STATUS_OK;
+        }
+    }
+
+    _oriError(ORIERR_NO_SUITABLE_MEMORY_TYPE, __func__);
+    return ORION_RETURN_STATUS_ERROR;
+}
+
+const oriReturnStatus_t oriAllocateMemory(
+    const oriHandle_t device,
+    const VkMemoryRequirements *requirements,
+    const VkMemoryPropertyFlags requiredFlags,
+    const VkMemoryPropertyFlags preferredFlags,
+    const bool linear,
+    oriHandle_t *allocationOut
+) {
+    const _oriMemoryTypeChoice_t choice = {
+        .requiredFlags = requiredFlags,
+        .preferredFlags = preferredFlags
+    };
+
+    return _oriAllocateMemory(device, requirements, &choice, linear, allocationOut, __func__);
+}
+
+const oriReturnStatus_t oriAllocateMemoryForUsage(
+    const oriHandle_t device,
+    const VkMemoryRequirements *requirements,
+    const oriMemoryUsage_t usage,
+    const bool linear,
+    oriHandle_t *allocationOut
+) {
+    if ((unsigned int) usage >= _ORI_MEMORY_USAGE_COUNT) {
+        _oriError(ORIERR_INVALID_OBJECT, __func__);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    const _oriMemoryTypeChoice_t choice = {
+        .byUsage = true,
+        .usage = usage
+    };
+
+    return _oriAllocateMemory(device, requirements, &choice, linear, allocationOut, __func__);
+}
+
+const oriReturnStatus_t oriAllocateBufferMemory(
+    const oriHandle_t device,
+    const VkBuffer buffer,
+    const VkMemoryPropertyFlags requiredFlags,
+    const VkMemoryPropertyFlags preferredFlags,
+    oriHandle_t *allocationOut
+) {
+    if (_ORI_CONTRACT_BROKEN(!buffer)) {
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriResourceRequirements_t resource;
+    _oriGetResourceRequirements(record, buffer, VK_NULL_HANDLE, &resource);
+
+    const _oriMemoryTypeChoice_t choice = {
+        .requiredFlags = requiredFlags,
+        .preferredFlags = preferredFlags
+    };
+
+    _oriMemoryChunk_t *chunk;
+    oriHandle_t allocation;
+
+    mtx_lock(&record->memory.lock);
+
+    oriReturnStatus_t status = _oriAllocateMemoryLocked(record, &resource, &choice, true, &chunk, &allocation, __func__);
+    if (!status) {
+        status = _oriBindMemoryLocked(record, chunk, buffer, VK_NULL_HANDLE, 0, __func__);
+        if (status) {
+            _oriFreeMemoryLocked(record, allocation, chunk);
+        }
+    }
+
+    mtx_unlock(&record->memory.lock);
+
+    _oriCheckMemoryBudget(record, device);
+
+    if (!status && allocationOut) {
+        *allocationOut = allocation;
+    }
+
+    return status;
+}
+
+const oriReturnStatus_t oriAllocateImageMemory(
+    const oriHandle_t device,
+    const VkImage image,
+    const VkMemoryPropertyFlags requiredFlags,
+    const VkMemoryPropertyFlags preferredFlags,
+    oriHandle_t *allocationOut
+) {
+    if (_ORI_CONTRACT_BROKEN(!image)) {
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriResourceRequirements_t resource;
+    _oriGetResourceRequirements(record, VK_NULL_HANDLE, image, &resource);
+
+    const _oriMemoryTypeChoice_t choice = {
+        .requiredFlags = requiredFlags,
+        .preferredFlags = preferredFlags
+    };
+
+    _oriMemoryChunk_t *chunk;
+    oriHandle_t allocation;
+
+    mtx_lock(&record->memory.lock);
+
+    // (the tiling of an image can't be queried, so images are always treated as optimally tiled - this only costs some padding
+    // for the rare linear image)
+    oriReturnStatus_t status = _oriAllocateMemoryLocked(record, &resource, &choice, false, &chunk, &allocation, __func__);
+    if (!status) {
+        status = _oriBindMemoryLocked(record, chunk, VK_NULL_HANDLE, image, 0, __func__);
+        if (status) {
+            _oriFreeMemoryLocked(record, allocation, chunk);
+        }
+    }
+
+    mtx_unlock(&record->memory.lock);
+
+    _oriCheckMemoryBudget(record, device);
+
+    if (!status && allocationOut) {
+        *allocationOut = allocation;
+    }
+
+    return status;
+}
+
+const oriReturnStatus_t oriCreateBuffer(
+    const oriHandle_t device,
+    const VkBufferCreateInfo *createInfo,
+    const VkMemoryPropertyFlags requiredFlags,
+    const VkMemoryPropertyFlags preferredFlags,
+    oriHandle_t *allocationOut,
+    VkBuffer *bufferOut
+) {
+    const _oriMemoryTypeChoice_t choice = {
+        .requiredFlags = requiredFlags,
+        .preferredFlags = preferredFlags
+    };
+
+    return _oriCreateBuffer(device, createInfo, &choice, allocationOut, bufferOut, __func__);
+}
+
+const oriReturnStatus_t oriCreateBufferForUsage(
+    const oriHandle_t device,
+    const VkBufferCreateInfo *createInfo,
+    const oriMemoryUsage_t usage,
+    oriHandle_t *allocationOut,
+    VkBuffer *bufferOut
+) {
+    if ((unsigned int) usage >= _ORI_MEMORY_USAGE_COUNT) {
+        _oriError(ORIERR_INVALID_OBJECT, __func__);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    const _oriMemoryTypeChoice_t choice = {
+        .byUsage = true,
+        .usage = usage
+    };
+
+    return _oriCreateBuffer(device, createInfo, &choice, allocationOut, bufferOut, __func__);
+}
+
+const oriReturnStatus_t oriBindBufferMemory(
+    const oriHandle_t device,
+    const oriHandle_t allocation,
+    const VkBuffer buffer,
+    const VkDeviceSize offset
+) {
+    if (_ORI_CONTRACT_BROKEN(!buffer)) {
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    mtx_lock(&record->memory.lock);
+
+    oriReturnStatus_t status = ORION_RETURN_STATUS_ERROR;
+    const _oriMemoryChunk_t *chunk = _oriGetAllocation(record, allocation, __func__);
+    if (chunk) {
+        status = _oriBindMemoryLocked(record, chunk, buffer, VK_NULL_HANDLE, offset, __func__);
+    }
+
+    mtx_unlock(&record->memory.lock);
+
+    return status;
+}
+
+const oriReturnStatus_t oriBindImageMemory(
+    const oriHandle_t device,
+    const oriHandle_t allocation,
+    const VkImage image,
+    const VkDeviceSize offset
+) {
+    if (_ORI_CONTRACT_BROKEN(!image)) {
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    mtx_lock(&record->memory.lock);
+
+    oriReturnStatus_t status = ORION_RETURN_STATUS_ERROR;
+    const _oriMemoryChunk_t *chunk = _oriGetAllocation(record, allocation, __func__);
+    if (chunk) {
+        status = _oriBindMemoryLocked(record, chunk, VK_NULL_HANDLE, image, offset, __func__);
+    }
+
+    mtx_unlock(&record->memory.lock);
+
+    return status;
+}
+
+const oriReturnStatus_t oriFreeMemory(
+    const oriHandle_t device,
+    const oriHandle_t allocation
+) {
+    if (_ORI_CONTRACT_BROKEN(!allocation)) { // allocation is ORION_NULL_HANDLE
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    mtx_lock(&record->memory.lock);
+
+    oriReturnStatus_t status = ORION_RETURN_STATUS_ERROR;
+    _oriMemoryChunk_t *chunk = _oriGetAllocation(record, allocation, __func__);
+    if (chunk) {
+        _oriFreeMemoryLocked(record, allocation, chunk);
+        status = ORION_RETURN_STATUS_OK;
+    }
+
+    mtx_unlock(&record->memory.lock);
+
+    return status;
+}
+
+const oriReturnStatus_t oriGetAllocationInfo(
+    const oriHandle_t device,
+    const oriHandle_t allocation,
+    oriAllocationInfo_t *infoOut
+) {
+    if (!infoOut) {
+        _oriWarning("all output variables NULL in call to %s", __func__);
+        return ORION_RETURN_STATUS_NO_OUTPUT;
+    }
+
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    mtx_lock(&record->memory.lock);
+
+    oriReturnStatus_t status = ORION_RETURN_STATUS_ERROR;
+    const _oriMemoryChunk_t *chunk = _oriGetAllocation(record, allocation, __func__);
+    if (chunk) {
+        infoOut->memory = chunk->block->memory;
+        infoOut->offset = chunk->offset;
+        infoOut->size = chunk->size;
+        infoOut->memoryTypeIndex = chunk->block->memoryTypeIndex;
+        infoOut->propertyFlags = record->memory.properties.memoryTypes[chunk->block->memoryTypeIndex].propertyFlags;
+        infoOut->buffer = chunk->buffer;
+        infoOut->dedicated = chunk->block->dedicated;
+        infoOut->mappedData = (chunk->block->data) ? chunk->block->data + chunk->offset : NULL;
+        status = ORION_RETURN_STATUS_OK;
+    }
+
+    mtx_unlock(&record->memory.lock);
+
+    return status;
+}
+
+const oriReturnStatus_t oriImportHostMemory(
+    const oriHandle_t device,
+    void *hostPointer,
+    const VkDeviceSize size,
+    const VkBufferUsageFlags bufferUsage,
+    oriHandle_t *allocationOut,
+    VkBuffer *bufferOut
+) {
+    if (_ORI_CONTRACT_BROKEN(!hostPointer)) {
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+    if (!allocationOut) {
+        _oriWarning("all output variables NULL in call to %s", __func__);
+        return ORION_RETURN_STATUS_NO_OUTPUT;
+    }
+
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    // (VkExternalMemoryBufferCreateInfo is core in Vulkan 1.1)
+    if (!record->vulkan11) {
+        _oriError(ORIERR_UNSUPPORTED_VERSION, __func__);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+    if (!record->getMemoryHostPointerProperties) {
+        _oriError(ORIERR_EXTENSION_NOT_ENABLED, VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+    if (!size) {
+        _oriError(ORIERR_OBJECT_CREATION_FAIL, "imported host memory must not be empty");
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    // host pointers can only be imported from a multiple of minImportedHostPointerAlignment, so the import starts at the
+    // multiple below the data and ends at the one above it (the alignment is the page size in practice, so the padding is in
+    // pages that are mapped anyway)
+    const VkDeviceSize padding = (uintptr_t) hostPointer & record->limits.minImportedHostPointerMask;
+
+    const VkImportMemoryHostPointerInfoEXT importInfo = {
+        .sType = VK_STRUCTURE_TYPE_IMPORT_MEMORY_HOST_POINTER_INFO_EXT,
+        .handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT,
+        .pHostPointer = (unsigned char *) hostPointer - padding
+    };
+
+    VkMemoryHostPointerPropertiesEXT pointerProperties = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT
+    };
+
+    if (record->getMemoryHostPointerProperties(record->handle, importInfo.handleType, importInfo.pHostPointer, &pointerProperties)) {
+        _oriError(ORIERR_VULKAN_QUERY_FAIL, __func__);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    uint32_t typeBits = pointerProperties.memoryTypeBits;
+
+    // buffers bound to imported memory must say so when they are created
+    VkBuffer buffer = VK_NULL_HANDLE;
+    if (bufferUsage) {
+        const VkExternalMemoryBufferCreateInfo externalInfo = {
+            .sType = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO,
+            .handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT
+        };
+
+        const VkBufferCreateInfo bufferInfo = {
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .pNext = &externalInfo,
+            .size = size,
+            .usage = bufferUsage,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+        };
+
+        if (vkCreateBuffer(record->handle, &bufferInfo, _orion.callbacks.vulkanAllocators, &buffer)) {
+            _oriError(ORIERR_OBJECT_CREATION_FAIL, "failed to create buffer");
+            return ORION_RETURN_STATUS_ERROR;
+        }
+
+        _oriTrackObjectCreation(VK_OBJECT_TYPE_BUFFER, _ORI_NON_DISPATCHABLE_HANDLE_U64(buffer), size);
+
+        VkMemoryRequirements requirements;
+        vkGetBufferMemoryRequirements(record->handle, buffer, &requirements);
+        typeBits &= requirements.memoryTypeBits;
+
+        // the buffer starts at the data, so the data must be aligned well enough for it
+        if (!oriIsAligned(padding, requirements.alignment - 1) ||
+            padding + requirements.size > oriAlignUp(padding + size, record->limits.minImportedHostPointerMask)
+        ) {
+            _oriTrackObjectDestruction(VK_OBJECT_TYPE_BUFFER, _ORI_NON_DISPATCHABLE_HANDLE_U64(buffer));
+            vkDestroyBuffer(record->handle, buffer, _orion.callbacks.vulkanAllocators);
+
+            _oriError(ORIERR_OBJECT_CREATION_FAIL, "host pointer is not aligned for the buffer");
+            return ORION_RETURN_STATUS_ERROR;
+        }
+    }
+
+    // host-coherent types are preferred, so that transfers can read the data without it being flushed
+    const _oriMemoryTypeChoice_t choice = {
+        .preferredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+    };
+
+    uint32_t types[VK_MAX_MEMORY_TYPES];
+    const unsigned int typeCount = _oriListMemoryTypes(&record->memory, &choice, typeBits, types);
+
+    _oriMemoryChunk_t *chunk;
+    oriHandle_t allocation;
+    oriReturnStatus_t status = ORION_RETURN_STATUS_ERROR;
+
+    if (!typeCount) {
+        _oriError(ORIERR_NO_SUITABLE_MEMORY_TYPE, __func__);
+    } else {
+        mtx_lock(&record->memory.lock);
+
+        status = _oriImportHostMemoryLocked(record, &importInfo, padding, size, types, typeCount, buffer, &chunk, &allocation, __func__);
+        if (!status && buffer) {
+            // (never movable, as the memory belongs to the application)
+            chunk->buffer = buffer;
+            chunk->bufferSize = size;
+            chunk->bufferUsage = bufferUsage;
+        }
+
+        mtx_unlock(&record->memory.lock);
+
+        _oriCheckMemoryBudget(record, device);
+    }
+
+    if (status) {
+        if (buffer) {
+            _oriTrackObjectDestruction(VK_OBJECT_TYPE_BUFFER, _ORI_NON_DISPATCHABLE_HANDLE_U64(buffer));
+            vkDestroyBuffer(record->handle, buffer, _orion.callbacks.vulkanAllocators);
+        }
+
+        return status;
+    }
+
+    *allocationOut = allocation;
+    if (bufferOut) {
+        *bufferOut = buffer;
+    }
+
+    return ORION_RETURN_STATUS_OK;
+}
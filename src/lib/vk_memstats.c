@@ -0,0 +1,319 @@
+/* *************************************************************************************** */
+/*                       ORION GRAPHICS LIBRARY AND RENDERING ENGINE                       */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+
+// ============================================================================ //
+// *****                     Doxygen file information                     ***** //
+// ============================================================================ //
+
+/**
+ * @file vk_memstats.c
+ * @author jack bennett
+ * @brief Device memory statistics
+ *
+ * @copyright Copyright (c) 2022 jack bennett
+ *
+ * This file contains the statistics of the memory manager of each logical device (per heap,
+ * per memory type and per block), and the JSON dump of the layout of every block.
+ *
+ * Statistics are gathered by walking the chunks of every block when they are asked for, so
+ * they cost nothing while allocating.
+ *
+ */
+
+#include "orion.h"
+#include "orion_errors.h"
+#include "orion_funcs.h"
+#include "orion_structs.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <threads.h>
+
+
+// ============================================================================ //
+// *****                     Private/internal systems                     ***** //
+// ============================================================================ //
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                               Memory statistics                              //
+
+// Add the chunks of a block to a set of statistics (the memory lock must be held).
+//
+static void _oriAddBlockStatistics(
+    const _oriMemoryBlock_t *block,
+    oriMemoryStatistics_t *stats
+) {
+    stats->blockCount++;
+    stats->allocationCount += block->allocationCount;
+    stats->blockBytes += block->size;
+
+    for (const _oriMemoryChunk_t *chunk = block->firstChunk; chunk; chunk = chunk->nextPhysical) {
+        if (!chunk->free) {
+            // (the padding of imported host memory around the application's data is in use as much as the data is)
+            stats->usedBytes += (block->imported) ? block->size : chunk->size;
+            continue;
+        }
+
+        stats->freeBytes += chunk->size;
+        stats->freeRangeCount++;
+        if (chunk->size > stats->largestFreeRange) {
+            stats->largestFreeRange = chunk->size;
+        }
+    }
+}
+
+// Work out the fragmentation of a set of statistics once every block has been added.
+//
+static void _oriFinishStatistics(
+    oriMemoryStatistics_t *stats
+) {
+    stats->fragmentation = (stats->freeBytes) ? 1.0f - (float) stats->largestFreeRange / (float) stats->freeBytes : 0.0f;
+}
+
+// Add one set of statistics to another (before either is finished).
+//
+static void _oriMergeStatistics(
+    oriMemoryStatistics_t *stats,
+    const oriMemoryStatistics_t *other
+) {
+    stats->blockCount += other->blockCount;
+    stats->allocationCount += other->allocationCount;
+    stats->blockBytes += other->blockBytes;
+    stats->usedBytes += other->usedBytes;
+    stats->freeBytes += other->freeBytes;
+    stats->freeRangeCount += other->freeRangeCount;
+    if (other->largestFreeRange > stats->largestFreeRange) {
+        stats->largestFreeRange = other->largestFreeRange;
+    }
+}
+
+// Write a set of statistics as a JSON object.
+//
+static void _oriWriteStatisticsJson(
+    FILE *file,
+    const oriMemoryStatistics_t *stats
+) {
+    fprintf(file,
+        "{\"blockCount\": %u, \"allocationCount\": %u, \"blockBytes\": %" PRIu64 ", \"usedBytes\": %" PRIu64 ", \"freeBytes\": %" PRIu64
+        ", \"freeRangeCount\": %u, \"largestFreeRange\": %" PRIu64 ", \"fragmentation\": %.4f}",
+        stats->blockCount, stats->allocationCount, (uint64_t) stats->blockBytes, (uint64_t) stats->usedBytes, (uint64_t) stats->freeBytes,
+        stats->freeRangeCount, (uint64_t) stats->largestFreeRange, (double) stats->fragmentation
+    );
+}
+
+// Gather the statistics of every memory type and heap of a device (the memory lock must be held).
+//
+static void _oriGatherStatistics(
+    const _oriMemoryManager_t *manager,
+    oriDeviceMemoryStatistics_t *statsOut
+) {
+    memset(statsOut, 0, sizeof(oriDeviceMemoryStatistics_t));
+
+    statsOut->heapCount = manager->properties.memoryHeapCount;
+    statsOut->memoryTypeCount = manager->properties.memoryTypeCount;
+
+    for (uint32_t i = 0; i < manager->properties.memoryTypeCount; i++) {
+        for (const _oriMemoryBlock_t *block = manager->blocks[i]; block; block = block->next) {
+            _oriAddBlockStatistics(block, &statsOut->memoryTypes[i]);
+        }
+
+        _oriMergeStatistics(&statsOut->heaps[manager->properties.memoryTypes[i].heapIndex], &statsOut->memoryTypes[i]);
+        _oriMergeStatistics(&statsOut->total, &statsOut->memoryTypes[i]);
+        _oriFinishStatistics(&statsOut->memoryTypes[i]);
+    }
+
+    for (uint32_t i = 0; i < manager->properties.memoryHeapCount; i++) {
+        _oriFinishStatistics(&statsOut->heaps[i]);
+    }
+    _oriFinishStatistics(&statsOut->total);
+}
+
+
+// ============================================================================ //
+// *****                   Orion library public interface                 ***** //
+// ============================================================================ //
+
+
+// ----[Orion library public interface]---------------------------------------- //
+//                           Vulkan memory management                           //
+
+const oriReturnStatus_t oriGetMemoryStatistics(
+    const oriHandle_t device,
+    oriDeviceMemoryStatistics_t *statisticsOut
+) {
+    if (!statisticsOut) {
+        _oriWarning("all output variables NULL in call to %s", __func__);
+        return ORION_RETURN_STATUS_NO_OUTPUT;
+    }
+
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    mtx_lock(&record->memory.lock);
+    _oriGatherStatistics(&record->memory, statisticsOut);
+    mtx_unlock(&record->memory.lock);
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+const oriReturnStatus_t oriEnumerateMemoryBlocks(
+    const oriHandle_t device,
+    const unsigned int maxCount,
+    unsigned int *countOut,
+    oriMemoryBlockStatistics_t *blocksOut
+) {
+    if (!countOut && !blocksOut) {
+        _oriWarning("all output variables NULL in call to %s", __func__);
+        return ORION_RETURN_STATUS_NO_OUTPUT;
+    }
+
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriMemoryManager_t *manager = &record->memory;
+
+    mtx_lock(&manager->lock);
+
+    unsigned int count = 0;
+    bool truncated = false;
+    for (uint32_t i = 0; !truncated && i < manager->properties.memoryTypeCount; i++) {
+        for (const _oriMemoryBlock_t *block = manager->blocks[i]; block; block = block->next) {
+            if (blocksOut) {
+                if (count >= maxCount) {
+                    truncated = true;
+                    break;
+                }
+
+                memset(&blocksOut[count], 0, sizeof(oriMemoryBlockStatistics_t));
+                blocksOut[count].memory = block->memory;
+                blocksOut[count].memoryTypeIndex = i;
+                blocksOut[count].dedicated = block->dedicated;
+                blocksOut[count].imported = block->imported;
+
+                _oriAddBlockStatistics(block, &blocksOut[count].statistics);
+                _oriFinishStatistics(&blocksOut[count].statistics);
+            }
+
+            count++;
+        }
+    }
+
+    mtx_unlock(&manager->lock);
+
+    if (countOut) {
+        *countOut = count;
+    }
+
+    return (truncated) ? ORION_RETURN_STATUS_SKIPPED : ORION_RETURN_STATUS_OK;
+}
+
+const oriReturnStatus_t oriWriteMemoryMap(
+    const oriHandle_t device,
+    const char *path
+) {
+    if (_ORI_CONTRACT_BROKEN(!path)) {
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriMemoryManager_t *manager = &record->memory;
+
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        _oriWarning("failed to open '%s' to write memory map (%s)", path, __func__);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    mtx_lock(&manager->lock);
+
+    oriDeviceMemoryStatistics_t stats;
+    _oriGatherStatistics(manager, &stats);
+
+    fputs("{\n\t\"total\": ", file);
+    _oriWriteStatisticsJson(file, &stats.total);
+
+    fputs(",\n\t\"heaps\": [", file);
+    for (uint32_t i = 0; i < manager->properties.memoryHeapCount; i++) {
+        fprintf(file, "%s\n\t\t{\"index\": %u, \"size\": %" PRIu64 ", \"flags\": %u, \"budget\": %" PRIu64 ", \"allocated\": %" PRIu64 ", \"statistics\": ",
+            (i) ? "," : "", i, (uint64_t) manager->properties.memoryHeaps[i].size, (unsigned int) manager->properties.memoryHeaps[i].flags,
+            (uint64_t) manager->heapBudget[i], (uint64_t) manager->heapAllocated[i]);
+        _oriWriteStatisticsJson(file, &stats.heaps[i]);
+        fputc('}', file);
+    }
+
+    fputs("\n\t],\n\t\"memoryTypes\": [", file);
+    for (uint32_t i = 0; i < manager->properties.memoryTypeCount; i++) {
+        fprintf(file, "%s\n\t\t{\"index\": %u, \"heapIndex\": %u, \"propertyFlags\": %u, \"statistics\": ", (i) ? "," : "", i,
+            manager->properties.memoryTypes[i].heapIndex, (unsigned int) manager->properties.memoryTypes[i].propertyFlags);
+        _oriWriteStatisticsJson(file, &stats.memoryTypes[i]);
+        fputc('}', file);
+    }
+
+    // every range of every block, in offset order, so that the layout can be drawn
+    fputs("\n\t],\n\t\"blocks\": [", file);
+    unsigned int blockCount = 0;
+    for (uint32_t i = 0; i < manager->properties.memoryTypeCount; i++) {
+        for (const _oriMemoryBlock_t *block = manager->blocks[i]; block; block = block->next) {
+            oriMemoryStatistics_t blockStats = { 0 };
+            _oriAddBlockStatistics(block, &blockStats);
+            _oriFinishStatistics(&blockStats);
+
+            fprintf(file, "%s\n\t\t{\"memoryType\": %u, \"size\": %" PRIu64 ", \"dedicated\": %s, \"imported\": %s, \"statistics\": ",
+                (blockCount++) ? "," : "", i, (uint64_t) block->size, (block->dedicated) ? "true" : "false", (block->imported) ? "true" : "false");
+            _oriWriteStatisticsJson(file, &blockStats);
+            fputs(", \"ranges\": [", file);
+
+            for (const _oriMemoryChunk_t *chunk = block->firstChunk; chunk; chunk = chunk->nextPhysical) {
+                fprintf(file, "%s\n\t\t\t{\"offset\": %" PRIu64 ", \"size\": %" PRIu64, (chunk != block->firstChunk) ? "," : "",
+                    (uint64_t) chunk->offset, (uint64_t) chunk->size);
+
+                if (chunk->free) {
+                    fputs(", \"free\": true}", file);
+                    continue;
+                }
+
+                fprintf(file, ", \"free\": false, \"ownsBuffer\": %s, \"movable\": %s, \"retired\": %s, \"evictable\": %s}",
+                    (chunk->buffer) ? "true" : "false", (chunk->movable) ? "true" : "false", (chunk->retired) ? "true" : "false",
+                    (chunk->evictionCallback) ? "true" : "false");
+            }
+
+            fputs("\n\t\t]}", file);
+        }
+    }
+    fputs("\n\t]\n}\n", file);
+
+    mtx_unlock(&manager->lock);
+
+    if (fclose(file)) {
+        _oriWarning("failed to write memory map '%s' (%s)", path, __func__);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+#   ifdef __oridebug
+        _oriLog("memory map of %u block%s written to '%s' (%s)", blockCount, (blockCount == 1) ? "" : "s", path, __func__);
+#   endif
+
+    return ORION_RETURN_STATUS_OK;
+}
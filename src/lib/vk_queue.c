@@ -0,0 +1,412 @@
+/* *************************************************************************************** */
+/*                       ORION GRAPHICS LIBRARY AND RENDERING ENGINE                       */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+
+// ============================================================================ //
+// *****                     Doxygen file information                     ***** //
+// ============================================================================ //
+
+/**
+ * @file vk_queue.c
+ * @author jack bennett
+ * @brief Vulkan queue family selection
+ *
+ * @copyright Copyright (c) 2022 jack bennett
+ *
+ * This file contains the solver that chooses which queue families and queues a logical
+ * device should be created with, given the roles (graphics, present, async compute, ...)
+ * that the application needs queues for.
+ *
+ */
+
+#include "orion.h"
+#include "orion_errors.h"
+#include "orion_funcs.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+// ============================================================================ //
+// *****                     Private/internal systems                     ***** //
+// ============================================================================ //
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                            Queue family solver                               //
+
+// State of a queue family while roles are being assigned.
+//
+typedef struct _oriQueueFamilyState_t {
+    VkQueueFlags flags;
+    unsigned int queueCount;
+    unsigned int usedQueues;
+    bool presentSupport;
+} _oriQueueFamilyState_t;
+
+#ifdef __oridebug
+    static const char *_oriQueueRoleNames[ORION_QUEUE_ROLE_COUNT] = {
+        "graphics",
+        "present",
+        "async compute",
+        "transfer",
+        "sparse"
+    };
+#endif
+
+// Returns true if a queue family can fulfil a role.
+//
+static bool _oriQueueFamilySupportsRole(
+    const _oriQueueFamilyState_t *family,
+    const oriQueueRole_t role
+) {
+    switch (role) {
+        case ORION_QUEUE_ROLE_GRAPHICS:
+            return family->flags & VK_QUEUE_GRAPHICS_BIT;
+        case ORION_QUEUE_ROLE_PRESENT:
+            return family->presentSupport;
+        case ORION_QUEUE_ROLE_ASYNC_COMPUTE:
+            return family->flags & VK_QUEUE_COMPUTE_BIT;
+        case ORION_QUEUE_ROLE_TRANSFER:
+            // graphics and compute families support transfers even if they don't report VK_QUEUE_TRANSFER_BIT
+            return family->flags & (VK_QUEUE_TRANSFER_BIT | VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+        case ORION_QUEUE_ROLE_SPARSE:
+            return family->flags & VK_QUEUE_SPARSE_BINDING_BIT;
+    }
+
+    return false;
+}
+
+// How specialised a queue family is for a role (higher is better); families without the capabilities of the more general
+// roles usually correspond to separate hardware engines that can run alongside the graphics queue.
+//
+static unsigned int _oriQueueFamilySpecialisation(
+    const _oriQueueFamilyState_t *family,
+    const oriQueueRole_t role
+) {
+    switch (role) {
+        case ORION_QUEUE_ROLE_ASYNC_COMPUTE:
+        case ORION_QUEUE_ROLE_SPARSE:
+            return (family->flags & VK_QUEUE_GRAPHICS_BIT) ? 0 : 2;
+        case ORION_QUEUE_ROLE_TRANSFER:
+            if (family->flags & VK_QUEUE_GRAPHICS_BIT) {
+                return 0;
+            }
+            return (family->flags & VK_QUEUE_COMPUTE_BIT) ? 1 : 2;
+        default:
+            return 0;
+    }
+}
+
+// Assign a queue to a role, taking a new queue from the chosen family if it has any left and sharing the last queue
+// of the family otherwise.
+//
+static void _oriAssignQueue(
+    _oriQueueFamilyState_t *families,
+    const unsigned int familyIndex,
+    const oriQueueRole_t role,
+    oriQueueAssignment_t *assignment
+) {
+    _oriQueueFamilyState_t *family = &families[familyIndex];
+
+    assignment->assigned = true;
+    assignment->familyIndex = familyIndex;
+    assignment->dedicated = _oriQueueFamilySpecialisation(family, role) == 2;
+
+    if (family->usedQueues < family->queueCount) {
+        assignment->queueIndex = family->usedQueues++;
+        assignment->exclusive = true;
+    } else {
+        assignment->queueIndex = family->queueCount - 1;
+        assignment->exclusive = false;
+    }
+}
+
+// Choose a queue family for a (non-present) role, returning false if no family can fulfil it.
+//
+static bool _oriSolveQueueRole(
+    _oriQueueFamilyState_t *families,
+    const unsigned int familyCount,
+    const oriQueueRole_t role,
+    const bool preferPresent,
+    oriQueueAssignment_t *assignment
+) {
+    int best = -1;
+    unsigned int bestScore = 0;
+
+    for (unsigned int i = 0; i < familyCount; i++) {
+        if (!_oriQueueFamilySupportsRole(&families[i], role)) {
+            continue;
+        }
+
+        // a dedicated family is worth more than a queue of our own, as queues of the same family usually share hardware
+        unsigned int score = 1;
+        score += _oriQueueFamilySpecialisation(&families[i], role) * 8;
+        score += (families[i].usedQueues < families[i].queueCount) ? 4 : 0;
+        score += (!families[i].usedQueues) ? 2 : 0;
+        score += (preferPresent && families[i].presentSupport) ? 1 : 0;
+
+        // ties go to the family with the lowest index
+        if (score > bestScore) {
+            best = i;
+            bestScore = score;
+        }
+    }
+
+    if (best < 0) {
+        return false;
+    }
+
+    _oriAssignQueue(families, best, role, assignment);
+
+    return true;
+}
+
+// Choose a queue for the present role once every other role has been solved.
+// Presenting doesn't benefit from a queue of its own, so an existing queue is reused where possible (the graphics queue first).
+//
+static bool _oriSolvePresentRole(
+    _oriQueueFamilyState_t *families,
+    const unsigned int familyCount,
+    oriQueueSolution_t *solution
+) {
+    oriQueueAssignment_t *present = &solution->assignments[ORION_QUEUE_ROLE_PRESENT];
+
+    for (unsigned int r = 0; r < ORION_QUEUE_ROLE_COUNT; r++) {
+        const oriQueueAssignment_t *other = &solution->assignments[r];
+        if (r == ORION_QUEUE_ROLE_PRESENT || !other->assigned || !families[other->familyIndex].presentSupport) {
+            continue;
+        }
+
+        present->assigned = true;
+        present->familyIndex = other->familyIndex;
+        present->queueIndex = other->queueIndex;
+        present->exclusive = false;
+        present->dedicated = false;
+
+        return true;
+    }
+
+    return _oriSolveQueueRole(families, familyCount, ORION_QUEUE_ROLE_PRESENT, false, present);
+}
+
+// qsort() comparison function to order role requests by priority (required roles first).
+// Requests are compared by address last so that the first of any duplicate requests is always solved first.
+//
+static int _oriCompareQueueRoleRequests(
+    const void *a,
+    const void *b
+) {
+    const oriQueueRoleRequest_t *ra = *(const oriQueueRoleRequest_t **) a;
+    const oriQueueRoleRequest_t *rb = *(const oriQueueRoleRequest_t **) b;
+
+    if (ra->required != rb->required) {
+        return (ra->required) ? -1 : 1;
+    }
+    if (ra->priority != rb->priority) {
+        return (ra->priority > rb->priority) ? -1 : 1;
+    }
+
+    return (ra < rb) ? -1 : (ra > rb);
+}
+
+static float _oriClampQueuePriority(
+    const float priority
+) {
+    return (priority > 1.0f) ? 1.0f : (priority < 0.0f) ? 0.0f : priority;
+}
+
+
+// ============================================================================ //
+// *****                   Orion library public interface                 ***** //
+// ============================================================================ //
+
+
+// ----[Orion library public interface]---------------------------------------- //
+//                          Vulkan device management                            //
+
+const oriReturnStatus_t oriSolveQueueFamilies(
+    const VkPhysicalDevice physicalDevice,
+    const VkSurfaceKHR surface,
+    const unsigned int requestCount,
+    const oriQueueRoleRequest_t *requests,
+    oriQueueSolution_t *solutionOut
+) {
+    if (_ORI_CONTRACT_BROKEN(!physicalDevice || (!requests && requestCount))) {
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+    if (!solutionOut) {
+        _oriWarning("all output variables NULL in call to %s", __func__);
+        return ORION_RETURN_STATUS_NO_OUTPUT;
+    }
+
+    // (the solution is left zeroed if the function fails)
+    memset(solutionOut, 0, sizeof(oriQueueSolution_t));
+
+    // the effective request for each role (the first request for a role wins)
+    const oriQueueRoleRequest_t *sorted[requestCount ? requestCount : 1];
+    bool requested[ORION_QUEUE_ROLE_COUNT] = { false };
+    bool presentRequired = false;
+    float presentPriority = 0.0f;
+    unsigned int sortedCount = 0;
+
+    for (unsigned int i = 0; i < requestCount; i++) {
+        if ((unsigned int) requests[i].role >= ORION_QUEUE_ROLE_COUNT) {
+            _oriError(ORIERR_INVALID_OBJECT, __func__);
+            return ORION_RETURN_STATUS_ERROR;
+        }
+
+        if (requested[requests[i].role]) {
+            continue;
+        }
+        requested[requests[i].role] = true;
+
+        if (requests[i].role == ORION_QUEUE_ROLE_PRESENT) {
+            if (_ORI_CONTRACT_BROKEN(!surface)) {
+                _oriError(ORIERR_NULL_POINTER, __func__);
+                return ORION_RETURN_STATUS_NULL_POINTER;
+            }
+
+            presentRequired = requests[i].required;
+            presentPriority = requests[i].priority;
+            continue;
+        }
+
+        sorted[sortedCount++] = &requests[i];
+    }
+
+    qsort(sorted, sortedCount, sizeof(oriQueueRoleRequest_t *), _oriCompareQueueRoleRequests);
+
+    // query queue families
+    unsigned int familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, NULL);
+    if (!familyCount) {
+        _oriError(ORIERR_VULKAN_QUERY_FAIL, __func__);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    VkQueueFamilyProperties *properties = malloc(familyCount * sizeof(VkQueueFamilyProperties));
+    _oriQueueFamilyState_t *families = calloc(familyCount, sizeof(_oriQueueFamilyState_t));
+    if (!properties || !families) {
+        free(properties);
+        free(families);
+
+        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, properties);
+
+    for (unsigned int i = 0; i < familyCount; i++) {
+        families[i].flags = properties[i].queueFlags;
+        families[i].queueCount = properties[i].queueCount;
+
+        if (requested[ORION_QUEUE_ROLE_PRESENT]) {
+            VkBool32 support = VK_FALSE;
+            vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, surface, &support);
+            families[i].presentSupport = support;
+        }
+    }
+
+    free(properties);
+    properties = NULL;
+
+    // the priority of each role that was assigned a queue
+    float priorities[ORION_QUEUE_ROLE_COUNT] = { 0.0f };
+
+    // solve each role in order of priority
+    for (unsigned int i = 0; i < sortedCount; i++) {
+        const oriQueueRole_t role = sorted[i]->role;
+
+        // the graphics family should also be able to present, if possible, so that no ownership transfers are needed
+        const bool preferPresent = role == ORION_QUEUE_ROLE_GRAPHICS && requested[ORION_QUEUE_ROLE_PRESENT];
+
+        if (!_oriSolveQueueRole(families, familyCount, role, preferPresent, &solutionOut->assignments[role])) {
+            if (sorted[i]->required) {
+#               ifdef __oridebug
+                    _oriLog("no queue family supports the required %s queue role (%s)", _oriQueueRoleNames[role], __func__);
+#               endif
+
+                free(families);
+                families = NULL;
+                memset(solutionOut, 0, sizeof(oriQueueSolution_t));
+
+                _oriError(ORIERR_QUEUE_ROLE_UNSATISFIED, __func__);
+                return ORION_RETURN_STATUS_ERROR;
+            }
+
+            continue;
+        }
+
+        priorities[role] = _oriClampQueuePriority(sorted[i]->priority);
+    }
+
+    if (requested[ORION_QUEUE_ROLE_PRESENT]) {
+        if (!_oriSolvePresentRole(families, familyCount, solutionOut)) {
+            if (presentRequired) {
+                free(families);
+                families = NULL;
+                memset(solutionOut, 0, sizeof(oriQueueSolution_t));
+
+                _oriError(ORIERR_QUEUE_ROLE_UNSATISFIED, __func__);
+                return ORION_RETURN_STATUS_ERROR;
+            }
+        } else {
+            priorities[ORION_QUEUE_ROLE_PRESENT] = _oriClampQueuePriority(presentPriority);
+        }
+    }
+
+    // build one create info structure per family used, in order of family index
+    // (a queue shared by several roles gets the highest priority among them)
+    for (unsigned int f = 0; f < familyCount; f++) {
+        if (!families[f].usedQueues) {
+            continue;
+        }
+
+        const unsigned int c = solutionOut->queueCreateInfoCount++;
+        float *queuePriorities = solutionOut->queuePriorities[c];
+
+        for (unsigned int r = 0; r < ORION_QUEUE_ROLE_COUNT; r++) {
+            const oriQueueAssignment_t *assignment = &solutionOut->assignments[r];
+            if (assignment->assigned && assignment->familyIndex == f && priorities[r] > queuePriorities[assignment->queueIndex]) {
+                queuePriorities[assignment->queueIndex] = priorities[r];
+            }
+        }
+
+        solutionOut->queueCreateInfos[c] = (VkDeviceQueueCreateInfo) {
+            .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+            .pNext = NULL,
+            .flags = 0,
+            .queueFamilyIndex = f,
+            .queueCount = families[f].usedQueues,
+            .pQueuePriorities = queuePriorities
+        };
+    }
+
+#   ifdef __oridebug
+        for (unsigned int r = 0; r < ORION_QUEUE_ROLE_COUNT; r++) {
+            const oriQueueAssignment_t *assignment = &solutionOut->assignments[r];
+            if (assignment->assigned) {
+                _oriLog("%s queue role assigned to queue %u of family %u (%s%s) (%s)", _oriQueueRoleNames[r],
+                    assignment->queueIndex, assignment->familyIndex, (assignment->exclusive) ? "exclusive" : "shared",
+                    (assignment->dedicated) ? ", dedicated family" : "", __func__);
+            }
+        }
+#   endif
+
+    free(families);
+    families = NULL;
+
+    return ORION_RETURN_STATUS_OK;
+}
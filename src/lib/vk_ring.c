@@ -0,0 +1,369 @@
+/* *************************************************************************************** */
+/*                       ORION GRAPHICS LIBRARY AND RENDERING ENGINE                       */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+
+// ============================================================================ //
+// *****                     Doxygen file information                     ***** //
+// ============================================================================ //
+
+/**
+ * @file vk_ring.c
+ * @author jack bennett
+ * @brief Per-device ring buffers for transient data
+ *
+ * @copyright Copyright (c) 2022 jack bennett
+ *
+ * This file contains the ring buffer of each logical device: a persistently mapped,
+ * host-visible buffer that data living for a single frame (uniforms, dynamic vertices,
+ * indirect arguments, ...) is allocated from by bumping a pointer.
+ *
+ * Space is reclaimed a whole frame at a time, once the application reports that the GPU
+ * has finished with the frame (by frame index or timeline semaphore value).
+ *
+ */
+
+#include "orion.h"
+#include "orion_errors.h"
+#include "orion_flags.h"
+#include "orion_funcs.h"
+#include "orion_structs.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+
+
+// ============================================================================ //
+// *****                     Private/internal systems                     ***** //
+// ============================================================================ //
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                                 Ring buffers                                 //
+
+// Free the Vulkan objects of a ring buffer (the buffer and memory may be VK_NULL_HANDLE).
+//
+static void _oriFreeRingObjects(
+    _oriVkDevice_t *device,
+    _oriRingBuffer_t *ring
+) {
+    if (ring->buffer) {
+        _oriTrackObjectDestruction(VK_OBJECT_TYPE_BUFFER, _ORI_NON_DISPATCHABLE_HANDLE_U64(ring->buffer));
+        vkDestroyBuffer(device->handle, ring->buffer, _orion.callbacks.vulkanAllocators);
+    }
+    if (ring->memory) {
+        // (unmapped implicitly)
+        _oriFreeDeviceMemory(device, ring->memory, ring->memoryTypeIndex, ring->memorySize);
+    }
+}
+
+const bool _oriInitRing(
+    _oriVkDevice_t *device,
+    _oriRingBuffer_t *ring,
+    const VkDeviceSize size,
+    const VkDeviceSize alignmentMask,
+    const VkBufferUsageFlags usage,
+    const oriMemoryUsage_t memoryUsage,
+    const char *func
+) {
+    memset(ring, 0, sizeof(_oriRingBuffer_t));
+
+    // every allocation starts at a multiple of the alignment, so the size is rounded up to one as well
+    ring->alignmentMask = alignmentMask;
+    ring->size = oriAlignUp(size, alignmentMask);
+
+    const VkBufferCreateInfo bufferInfo = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size = ring->size,
+        .usage = usage,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+    };
+
+    if (vkCreateBuffer(device->handle, &bufferInfo, _orion.callbacks.vulkanAllocators, &ring->buffer)) {
+        _oriError(ORIERR_OBJECT_CREATION_FAIL, "failed to create ring buffer");
+        return false;
+    }
+
+    _oriTrackObjectCreation(VK_OBJECT_TYPE_BUFFER, _ORI_NON_DISPATCHABLE_HANDLE_U64(ring->buffer), ring->size);
+
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(device->handle, ring->buffer, &requirements);
+
+    // host-coherent memory is required so that allocations never have to be flushed (a host-visible, host-coherent memory
+    // type always exists)
+    if (!_oriAllocateDeviceMemory(device, &requirements, memoryUsage, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        &ring->memory, &ring->memoryTypeIndex, func)
+    ) {
+        _oriFreeRingObjects(device, ring);
+        return false;
+    }
+
+    void *data;
+    if (vkBindBufferMemory(device->handle, ring->buffer, ring->memory, 0) ||
+        vkMapMemory(device->handle, ring->memory, 0, VK_WHOLE_SIZE, 0, &data)
+    ) {
+        _oriFreeRingObjects(device, ring);
+
+        _oriError(ORIERR_MEMORY_ALLOCATION_FAIL, func);
+        return false;
+    }
+    ring->data = data;
+    ring->memorySize = requirements.size;
+
+    if (mtx_init(&ring->lock, mtx_plain) != thrd_success) {
+        _oriFreeRingObjects(device, ring);
+
+        _oriFatalError(ORIFERR_MEMORY_ERROR, func);
+        return false;
+    }
+
+#   ifdef __oridebug
+        _oriLog("%llu byte ring buffer created in memory type %u (%s)", (unsigned long long) ring->size, ring->memoryTypeIndex, func);
+#   endif
+
+    return true;
+}
+
+void _oriFreeRing(
+    _oriVkDevice_t *device,
+    _oriRingBuffer_t *ring
+) {
+    _oriFreeRingObjects(device, ring);
+    mtx_destroy(&ring->lock);
+}
+
+const bool _oriRingAllocate(
+    _oriRingBuffer_t *ring,
+    const VkDeviceSize size,
+    VkDeviceSize *offsetOut
+) {
+    // rounding the size up keeps the head aligned, so no allocation needs padding at the front
+    const VkDeviceSize alignedSize = oriAlignUp((size) ? size : 1, ring->alignmentMask);
+
+    mtx_lock(&ring->lock);
+
+    // an allocation that would run past the end of the buffer starts at the beginning of the next lap instead
+    VkDeviceSize offset = ring->head % ring->size;
+    uint64_t head = ring->head;
+    if (offset + alignedSize > ring->size) {
+        head += ring->size - offset;
+        offset = 0;
+    }
+    head += alignedSize;
+
+    // (if the ring is empty, the space skipped at the end of the lap isn't in use, so it's reclaimed straight away)
+    const uint64_t tail = (ring->head == ring->tail) ? head - alignedSize : ring->tail;
+
+    const bool full = head - tail > ring->size;
+    if (!full) {
+        ring->head = head;
+        ring->tail = tail;
+    }
+
+    mtx_unlock(&ring->lock);
+
+    *offsetOut = offset;
+    return !full;
+}
+
+void _oriRingEndFrame(
+    _oriRingBuffer_t *ring,
+    const uint64_t value
+) {
+    mtx_lock(&ring->lock);
+
+    if (ring->frameCount == MEMORY_RING_MAX_FRAMES) {
+        // merge the two oldest frames by forgetting the oldest (its space is then reclaimed along with the next frame's)
+        ring->firstFrame = (ring->firstFrame + 1) % MEMORY_RING_MAX_FRAMES;
+        ring->frameCount--;
+
+#       ifdef __oridebug
+            _oriWarning("more than %d ring buffer frames waiting to be reclaimed (%s)", MEMORY_RING_MAX_FRAMES, __func__);
+#       endif
+    }
+
+    _oriRingFrame_t *frame = &ring->frames[(ring->firstFrame + ring->frameCount) % MEMORY_RING_MAX_FRAMES];
+    frame->value = value;
+    frame->end = ring->head;
+    ring->frameCount++;
+
+    mtx_unlock(&ring->lock);
+}
+
+void _oriRingReclaim(
+    _oriRingBuffer_t *ring,
+    const uint64_t completedValue
+) {
+    mtx_lock(&ring->lock);
+
+    while (ring->frameCount && ring->frames[ring->firstFrame].value <= completedValue) {
+        // (an empty ring's tail may have moved past the end of frames with nothing left in them)
+        if (ring->frames[ring->firstFrame].end > ring->tail) {
+            ring->tail = ring->frames[ring->firstFrame].end;
+        }
+
+        ring->firstFrame = (ring->firstFrame + 1) % MEMORY_RING_MAX_FRAMES;
+        ring->frameCount--;
+    }
+
+    mtx_unlock(&ring->lock);
+}
+
+void _oriDestroyDeviceRing(
+    _oriVkDevice_t *device
+) {
+    if (!device->ring) {
+        return;
+    }
+
+    _oriFreeRing(device, device->ring);
+
+    free(device->ring);
+    device->ring = NULL;
+}
+
+
+// ============================================================================ //
+// *****                   Orion library public interface                 ***** //
+// ============================================================================ //
+
+
+// ----[Orion library public interface]---------------------------------------- //
+//                           Vulkan memory management                           //
+
+const oriReturnStatus_t oriCreateDeviceRing(
+    const oriHandle_t device,
+    const VkDeviceSize size,
+    const VkBufferUsageFlags usage
+) {
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    if (record->ring) {
+        _oriWarning("device already has a ring buffer (%s)", __func__);
+        return ORION_RETURN_STATUS_SKIPPED;
+    }
+
+    // dynamic offsets are 32-bit
+    if (!size || size > UINT32_MAX) {
+        _oriError(ORIERR_OBJECT_CREATION_FAIL, "ring buffer size must be between 1 byte and 4 GiB");
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriRingBuffer_t *ring = malloc(sizeof(_oriRingBuffer_t));
+    if (!ring) {
+        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    // (indirect arguments need at least 4 byte alignment)
+    if (!_oriInitRing(record, ring, size, record->limits.uniformBufferOffsetMask | 3, usage, ORION_MEMORY_USAGE_CPU_TO_GPU, __func__)) {
+        free(ring);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    // the ring is set under the memory lock in case another thread created one at the same time
+    mtx_lock(&record->memory.lock);
+
+    const bool raced = record->ring != NULL;
+    if (!raced) {
+        record->ring = ring;
+    }
+
+    mtx_unlock(&record->memory.lock);
+
+    if (raced) {
+        _oriFreeRing(record, ring);
+        free(ring);
+
+        _oriWarning("device already has a ring buffer (%s)", __func__);
+        return ORION_RETURN_STATUS_SKIPPED;
+    }
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+const oriReturnStatus_t oriRingAllocate(
+    const oriHandle_t device,
+    const VkDeviceSize size,
+    oriRingAllocation_t *allocationOut
+) {
+    if (!allocationOut) {
+        _oriWarning("all output variables NULL in call to %s", __func__);
+        return ORION_RETURN_STATUS_NO_OUTPUT;
+    }
+
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriRingBuffer_t *ring = record->ring;
+    if (_ORI_CONTRACT_BROKEN(!ring)) { // oriCreateDeviceRing() not called
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    VkDeviceSize offset;
+    if (!_oriRingAllocate(ring, size, &offset)) {
+        _oriError(ORIERR_RING_BUFFER_FULL, __func__);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    allocationOut->buffer = ring->buffer;
+    allocationOut->offset = offset;
+    allocationOut->dynamicOffset = (uint32_t) offset;
+    allocationOut->data = ring->data + offset;
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+const oriReturnStatus_t oriRingEndFrame(
+    const oriHandle_t device,
+    const uint64_t value
+) {
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    if (_ORI_CONTRACT_BROKEN(!record->ring)) { // oriCreateDeviceRing() not called
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    _oriRingEndFrame(record->ring, value);
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+const oriReturnStatus_t oriRingReclaim(
+    const oriHandle_t device,
+    const uint64_t completedValue
+) {
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    if (_ORI_CONTRACT_BROKEN(!record->ring)) { // oriCreateDeviceRing() not called
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    _oriRingReclaim(record->ring, completedValue);
+
+    return ORION_RETURN_STATUS_OK;
+}
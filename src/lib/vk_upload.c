@@ -0,0 +1,857 @@
+/* *************************************************************************************** */
+/*                       ORION GRAPHICS LIBRARY AND RENDERING ENGINE                       */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+
+// ============================================================================ //
+// *****                     Doxygen file information                     ***** //
+// ============================================================================ //
+
+/**
+ * @file vk_upload.c
+ * @author jack bennett
+ * @brief Batched staging uploads
+ *
+ * @copyright Copyright (c) 2022 jack bennett
+ *
+ * This file contains the uploader of each logical device, which copies data for buffers
+ * and images into a pooled staging ring buffer and records the copies, sorted by
+ * destination and with adjacent regions merged, into one command buffer per submission on
+ * a transfer queue.
+ *
+ * Each submission signals a timeline semaphore (or a fence, if timeline semaphores are not
+ * enabled on the device) with an increasing value, which is also used to reclaim the
+ * submission's staging memory.
+ *
+ */
+
+#include "orion.h"
+#include "orion_errors.h"
+#include "orion_flags.h"
+#include "orion_funcs.h"
+#include "orion_structs.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+
+
+// ============================================================================ //
+// *****                     Private/internal systems                     ***** //
+// ============================================================================ //
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                              Upload submissions                              //
+
+// Check which submissions have completed, and reclaim their staging memory (the uploader's lock must be held).
+//
+static void _oriUpdateCompletedUploads(
+    const _oriVkDevice_t *device,
+    _oriUploader_t *uploader
+) {
+    if (uploader->timeline) {
+        uint64_t value;
+        if (!vkGetSemaphoreCounterValue(device->handle, uploader->timeline, &value)) {
+            uploader->completedValue = value;
+        }
+    } else {
+        // fences are signalled in submission order
+        while (uploader->completedValue < uploader->submittedValue &&
+            vkGetFenceStatus(device->handle, uploader->fences[(uploader->completedValue + 1) % MEMORY_UPLOAD_MAX_SUBMISSIONS]) == VK_SUCCESS
+        ) {
+            uploader->completedValue++;
+        }
+    }
+
+    _oriRingReclaim(&uploader->staging, uploader->completedValue);
+}
+
+// Wait until a submission has completed, and reclaim its staging memory (the uploader's lock must be held).
+//
+static void _oriWaitForUpload(
+    const _oriVkDevice_t *device,
+    _oriUploader_t *uploader,
+    const uint64_t value
+) {
+    if (value <= uploader->completedValue) {
+        return;
+    }
+
+    if (uploader->timeline) {
+        const VkSemaphoreWaitInfo waitInfo = {
+            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+            .semaphoreCount = 1,
+            .pSemaphores = &uploader->timeline,
+            .pValues = &value
+        };
+
+        vkWaitSemaphores(device->handle, &waitInfo, UINT64_MAX);
+    } else {
+        vkWaitForFences(device->handle, 1, &uploader->fences[value % MEMORY_UPLOAD_MAX_SUBMISSIONS], VK_TRUE, UINT64_MAX);
+    }
+
+    uploader->completedValue = value;
+    _oriRingReclaim(&uploader->staging, value);
+}
+
+// qsort() comparison function to order buffer uploads by destination buffer, then destination offset.
+//
+static int _oriCompareBufferUploads(
+    const void *a,
+    const void *b
+) {
+    const _oriBufferUpload_t *ua = a;
+    const _oriBufferUpload_t *ub = b;
+
+    const uint64_t da = _ORI_NON_DISPATCHABLE_HANDLE_U64(ua->dst);
+    const uint64_t db = _ORI_NON_DISPATCHABLE_HANDLE_U64(ub->dst);
+    if (da != db) {
+        return (da < db) ? -1 : 1;
+    }
+    if (ua->region.dstOffset != ub->region.dstOffset) {
+        return (ua->region.dstOffset < ub->region.dstOffset) ? -1 : 1;
+    }
+
+    return (ua->order < ub->order) ? -1 : 1;
+}
+
+// qsort() comparison function to order offsets.
+//
+static int _oriCompareOffsets(
+    const void *a,
+    const void *b
+) {
+    const VkDeviceSize oa = *(const VkDeviceSize *) a;
+    const VkDeviceSize ob = *(const VkDeviceSize *) b;
+
+    return (oa > ob) - (oa < ob);
+}
+
+// Add a copy region to a list, merging it into the last region if it follows on from it in both the staging buffer and the
+// destination (e.g. the pieces of a large upload, or consecutive uploads of a mesh's vertices).
+//
+static void _oriAppendBufferRegion(
+    VkBufferCopy *regions,
+    unsigned int *regionCount,
+    const VkBufferCopy *region
+) {
+    VkBufferCopy *last = (*regionCount) ? &regions[*regionCount - 1] : NULL;
+
+    if (last && last->srcOffset + last->size == region->srcOffset && last->dstOffset + last->size == region->dstOffset) {
+        last->size += region->size;
+    } else {
+        regions[(*regionCount)++] = *region;
+    }
+}
+
+// Add the regions of a run of overlapping uploads to the same buffer (ordered by destination offset) to a list, trimmed so that
+// each byte is only copied from the upload that was made last. Vulkan doesn't order the regions of a copy command, so
+// overlapping regions would leave the destination undefined.
+// A run of n uploads gives at most 2n - 1 regions. Returns false if there was an error.
+//
+static bool _oriAppendOverlappingUploads(
+    const _oriBufferUpload_t *uploads,
+    const unsigned int uploadCount,
+    VkBufferCopy *regions,
+    unsigned int *regionCount
+) {
+    // the run is cut at the start and end of every upload, and each piece is taken from the last upload that covers it
+    VkDeviceSize *bounds = malloc(uploadCount * 2 * sizeof(VkDeviceSize));
+    if (!bounds) {
+        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+        return false;
+    }
+
+    for (unsigned int i = 0; i < uploadCount; i++) {
+        bounds[i * 2] = uploads[i].region.dstOffset;
+        bounds[i * 2 + 1] = uploads[i].region.dstOffset + uploads[i].region.size;
+    }
+    qsort(bounds, uploadCount * 2, sizeof(VkDeviceSize), _oriCompareOffsets);
+
+    for (unsigned int b = 0; b + 1 < uploadCount * 2; b++) {
+        if (bounds[b] == bounds[b + 1]) {
+            continue;
+        }
+
+        const _oriBufferUpload_t *winner = NULL;
+        for (unsigned int i = 0; i < uploadCount; i++) {
+            const VkBufferCopy *region = &uploads[i].region;
+            if (region->dstOffset <= bounds[b] && region->dstOffset + region->size >= bounds[b + 1] &&
+                (!winner || uploads[i].order > winner->order)
+            ) {
+                winner = &uploads[i];
+            }
+        }
+
+        if (winner) {
+            const VkBufferCopy piece = {
+                .srcOffset = winner->region.srcOffset + (bounds[b] - winner->region.dstOffset),
+                .dstOffset = bounds[b],
+                .size = bounds[b + 1] - bounds[b]
+            };
+
+            _oriAppendBufferRegion(regions, regionCount, &piece);
+        }
+    }
+
+    free(bounds);
+    return true;
+}
+
+// qsort() comparison function to order image uploads by destination image (and otherwise keep them in order).
+//
+static int _oriCompareImageUploads(
+    const void *a,
+    const void *b
+) {
+    const _oriImageUpload_t *ua = a;
+    const _oriImageUpload_t *ub = b;
+
+    const uint64_t da = _ORI_NON_DISPATCHABLE_HANDLE_U64(ua->dst);
+    const uint64_t db = _ORI_NON_DISPATCHABLE_HANDLE_U64(ub->dst);
+    if (da != db) {
+        return (da < db) ? -1 : 1;
+    }
+
+    return (ua->order < ub->order) ? -1 : 1;
+}
+
+// Record the pending buffer uploads into a command buffer, with one copy command per destination buffer, adjacent regions merged
+// and overlapping regions trimmed.
+// Returns false if there was an error.
+//
+static bool _oriRecordBufferUploads(
+    _oriUploader_t *uploader,
+    const VkCommandBuffer commandBuffer
+) {
+    if (!uploader->bufferUploadCount) {
+        return true;
+    }
+
+    // (trimming overlapping uploads can split them, see _oriAppendOverlappingUploads())
+    VkBufferCopy *regions = malloc(uploader->bufferUploadCount * 2 * sizeof(VkBufferCopy));
+    if (!regions) {
+        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+        return false;
+    }
+
+    qsort(uploader->bufferUploads, uploader->bufferUploadCount, sizeof(_oriBufferUpload_t), _oriCompareBufferUploads);
+
+    const _oriBufferUpload_t *uploads = uploader->bufferUploads;
+    const unsigned int uploadCount = uploader->bufferUploadCount;
+
+    unsigned int first = 0;
+    while (first < uploadCount) {
+        const VkBuffer dst = uploads[first].dst;
+
+        unsigned int regionCount = 0;
+        unsigned int i = first;
+        while (i < uploadCount && uploads[i].dst == dst) {
+            // find the run of uploads that overlap each other, starting from this one
+            VkDeviceSize runEnd = uploads[i].region.dstOffset + uploads[i].region.size;
+            unsigned int runLength = 1;
+            while (i + runLength < uploadCount && uploads[i + runLength].dst == dst && uploads[i + runLength].region.dstOffset < runEnd) {
+                const VkDeviceSize end = uploads[i + runLength].region.dstOffset + uploads[i + runLength].region.size;
+                if (end > runEnd) {
+                    runEnd = end;
+                }
+                runLength++;
+            }
+
+            if (runLength == 1) {
+                _oriAppendBufferRegion(regions, &regionCount, &uploads[i].region);
+            } else if (!_oriAppendOverlappingUploads(&uploads[i], runLength, regions, &regionCount)) {
+                free(regions);
+                return false;
+            }
+
+            i += runLength;
+        }
+
+        vkCmdCopyBuffer(commandBuffer, uploader->staging.buffer, dst, regionCount, regions);
+        first = i;
+    }
+
+    free(regions);
+    return true;
+}
+
+// Record the pending image uploads into a command buffer, with one copy command per destination image.
+// Returns false if there was an error.
+//
+static bool _oriRecordImageUploads(
+    _oriUploader_t *uploader,
+    const VkCommandBuffer commandBuffer
+) {
+    if (!uploader->imageUploadCount) {
+        return true;
+    }
+
+    VkBufferImageCopy *regions = malloc(uploader->imageUploadCount * sizeof(VkBufferImageCopy));
+    if (!regions) {
+        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+        return false;
+    }
+
+    qsort(uploader->imageUploads, uploader->imageUploadCount, sizeof(_oriImageUpload_t), _oriCompareImageUploads);
+
+    unsigned int first = 0;
+    while (first < uploader->imageUploadCount) {
+        const VkImage dst = uploader->imageUploads[first].dst;
+
+        unsigned int regionCount = 0;
+        unsigned int i = first;
+        for (; i < uploader->imageUploadCount && uploader->imageUploads[i].dst == dst; i++) {
+            regions[regionCount++] = uploader->imageUploads[i].region;
+        }
+
+        vkCmdCopyBufferToImage(commandBuffer, uploader->staging.buffer, dst, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, regionCount, regions);
+        first = i;
+    }
+
+    free(regions);
+    return true;
+}
+
+// Record and submit all pending uploads (the uploader's lock must be held).
+// If there are no pending uploads, nothing is submitted (but signalSemaphore is still signalled, if not VK_NULL_HANDLE).
+//
+static const oriReturnStatus_t _oriSubmitUploadsLocked(
+    const _oriVkDevice_t *device,
+    _oriUploader_t *uploader,
+    const VkSemaphore signalSemaphore,
+    const char *func
+) {
+    if (!uploader->bufferUploadCount && !uploader->imageUploadCount && !signalSemaphore) {
+        return ORION_RETURN_STATUS_SKIPPED;
+    }
+
+    const uint64_t value = uploader->submittedValue + 1;
+    const unsigned int slot = value % MEMORY_UPLOAD_MAX_SUBMISSIONS;
+
+    // the command buffer (and fence) of the slot can only be reused once its last submission has completed
+    if (value > MEMORY_UPLOAD_MAX_SUBMISSIONS) {
+        _oriWaitForUpload(device, uploader, value - MEMORY_UPLOAD_MAX_SUBMISSIONS);
+    }
+
+    const VkCommandBuffer commandBuffer = uploader->commandBuffers[slot];
+    vkResetCommandBuffer(commandBuffer, 0);
+
+    const VkCommandBufferBeginInfo beginInfo = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+    };
+
+    if (vkBeginCommandBuffer(commandBuffer, &beginInfo) ||
+        !_oriRecordBufferUploads(uploader, commandBuffer) ||
+        !_oriRecordImageUploads(uploader, commandBuffer) ||
+        vkEndCommandBuffer(commandBuffer)
+    ) {
+        _oriError(ORIERR_VULKAN_QUERY_FAIL, func);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    VkSemaphore signalSemaphores[2];
+    uint64_t signalValues[2];
+    uint32_t signalCount = 0;
+
+    if (uploader->timeline) {
+        signalSemaphores[signalCount] = uploader->timeline;
+        signalValues[signalCount++] = value;
+    }
+    if (signalSemaphore) {
+        signalSemaphores[signalCount] = signalSemaphore;
+        signalValues[signalCount++] = 0; // (ignored for binary semaphores)
+    }
+
+    const VkTimelineSemaphoreSubmitInfo timelineInfo = {
+        .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+        .signalSemaphoreValueCount = signalCount,
+        .pSignalSemaphoreValues = signalValues
+    };
+
+    const VkSubmitInfo submitInfo = {
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .pNext = (uploader->timeline) ? &timelineInfo : NULL,
+        .commandBufferCount = 1,
+        .pCommandBuffers = &commandBuffer,
+        .signalSemaphoreCount = signalCount,
+        .pSignalSemaphores = signalSemaphores
+    };
+
+    VkFence fence = VK_NULL_HANDLE;
+    if (!uploader->timeline) {
+        fence = uploader->fences[slot];
+        vkResetFences(device->handle, 1, &fence);
+    }
+
+    if (vkQueueSubmit(uploader->queue, 1, &submitInfo, fence)) {
+        _oriError(ORIERR_VULKAN_QUERY_FAIL, func);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+#   ifdef __oridebug
+        _oriLog("upload submission %llu: %u buffer and %u image upload%s (%s)", (unsigned long long) value, uploader->bufferUploadCount,
+            uploader->imageUploadCount, (uploader->imageUploadCount == 1) ? "" : "s", func);
+#   endif
+
+    uploader->submittedValue = value;
+    uploader->bufferUploadCount = 0;
+    uploader->imageUploadCount = 0;
+
+    _oriRingEndFrame(&uploader->staging, value);
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+// Allocate staging memory, submitting pending uploads and waiting for earlier submissions to free some up if necessary
+// (the uploader's lock must be held).
+// Returns false if there was an error, or if the size is larger than the staging buffer.
+//
+static bool _oriAllocateStaging(
+    const _oriVkDevice_t *device,
+    _oriUploader_t *uploader,
+    const VkDeviceSize size,
+    VkDeviceSize *offsetOut,
+    const char *func
+) {
+    while (!_oriRingAllocate(&uploader->staging, size, offsetOut)) {
+        _oriUpdateCompletedUploads(device, uploader);
+        if (_oriRingAllocate(&uploader->staging, size, offsetOut)) {
+            break;
+        }
+
+        // the staging memory of pending uploads can only be reclaimed once they are submitted
+        if (uploader->bufferUploadCount || uploader->imageUploadCount) {
+            if (_oriSubmitUploadsLocked(device, uploader, VK_NULL_HANDLE, func)) {
+                return false;
+            }
+        }
+
+        if (uploader->completedValue == uploader->submittedValue) {
+            // everything has been reclaimed, and it still doesn't fit
+            _oriError(ORIERR_RING_BUFFER_FULL, func);
+            return false;
+        }
+
+        _oriWaitForUpload(device, uploader, uploader->completedValue + 1);
+    }
+
+    return true;
+}
+
+// Add a buffer upload to the pending list (the uploader's lock must be held).
+//
+static bool _oriAddBufferUpload(
+    _oriUploader_t *uploader,
+    const VkBuffer dst,
+    const VkBufferCopy *region
+) {
+    if (uploader->bufferUploadCount == uploader->bufferUploadCapacity) {
+        const unsigned int capacity = (uploader->bufferUploadCapacity) ? uploader->bufferUploadCapacity * 2 : 64;
+
+        _oriBufferUpload_t *uploads = realloc(uploader->bufferUploads, capacity * sizeof(_oriBufferUpload_t));
+        if (!uploads) {
+            _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+            return false;
+        }
+
+        uploader->bufferUploads = uploads;
+        uploader->bufferUploadCapacity = capacity;
+    }
+
+    _oriBufferUpload_t *upload = &uploader->bufferUploads[uploader->bufferUploadCount];
+    upload->dst = dst;
+    upload->region = *region;
+    upload->order = uploader->bufferUploadCount++;
+
+    return true;
+}
+
+// Add an image upload to the pending list (the uploader's lock must be held).
+//
+static bool _oriAddImageUpload(
+    _oriUploader_t *uploader,
+    const VkImage dst,
+    const VkBufferImageCopy *region
+) {
+    if (uploader->imageUploadCount == uploader->imageUploadCapacity) {
+        const unsigned int capacity = (uploader->imageUploadCapacity) ? uploader->imageUploadCapacity * 2 : 16;
+
+        _oriImageUpload_t *uploads = realloc(uploader->imageUploads, capacity * sizeof(_oriImageUpload_t));
+        if (!uploads) {
+            _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+            return false;
+        }
+
+        uploader->imageUploads = uploads;
+        uploader->imageUploadCapacity = capacity;
+    }
+
+    _oriImageUpload_t *upload = &uploader->imageUploads[uploader->imageUploadCount];
+    upload->dst = dst;
+    upload->region = *region;
+    upload->order = uploader->imageUploadCount++;
+
+    return true;
+}
+
+
+// ----[Private/internal systems]---------------------------------------------- //
+//                                   Uploaders                                  //
+
+// Free the Vulkan objects and arrays of an uploader (any of which may be VK_NULL_HANDLE or NULL), without waiting for its submissions.
+//
+static void _oriFreeUploaderObjects(
+    _oriVkDevice_t *device,
+    _oriUploader_t *uploader
+) {
+    if (uploader->commandPool) {
+        vkDestroyCommandPool(device->handle, uploader->commandPool, _orion.callbacks.vulkanAllocators);
+    }
+    for (unsigned int i = 0; i < MEMORY_UPLOAD_MAX_SUBMISSIONS; i++) {
+        if (uploader->fences[i]) {
+            vkDestroyFence(device->handle, uploader->fences[i], _orion.callbacks.vulkanAllocators);
+        }
+    }
+    if (uploader->timeline) {
+        vkDestroySemaphore(device->handle, uploader->timeline, _orion.callbacks.vulkanAllocators);
+    }
+
+    free(uploader->bufferUploads);
+    free(uploader->imageUploads);
+}
+
+void _oriDestroyDeviceUploader(
+    _oriVkDevice_t *device
+) {
+    _oriUploader_t *uploader = device->uploader;
+    if (!uploader) {
+        return;
+    }
+
+    // uploads that were never submitted are dropped
+    _oriWaitForUpload(device, uploader, uploader->submittedValue);
+
+    _oriFreeUploaderObjects(device, uploader);
+    _oriFreeRing(device, &uploader->staging);
+    mtx_destroy(&uploader->lock);
+
+    free(uploader);
+    device->uploader = NULL;
+}
+
+
+// ============================================================================ //
+// *****                   Orion library public interface                 ***** //
+// ============================================================================ //
+
+
+// ----[Orion library public interface]---------------------------------------- //
+//                           Vulkan memory management                           //
+
+const oriReturnStatus_t oriCreateDeviceUploader(
+    const oriHandle_t device,
+    const unsigned int familyIndex,
+    const unsigned int queueIndex,
+    const VkDeviceSize stagingSize
+) {
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    if (record->uploader) {
+        _oriWarning("device already has an uploader (%s)", __func__);
+        return ORION_RETURN_STATUS_SKIPPED;
+    }
+
+    _oriUploader_t *uploader = calloc(1, sizeof(_oriUploader_t));
+    if (!uploader) {
+        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    vkGetDeviceQueue(record->handle, familyIndex, queueIndex, &uploader->queue);
+
+    const VkCommandPoolCreateInfo poolInfo = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+        .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+        .queueFamilyIndex = familyIndex
+    };
+
+    const VkCommandBufferAllocateInfo commandBufferInfo = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+        .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+        .commandBufferCount = MEMORY_UPLOAD_MAX_SUBMISSIONS
+    };
+
+    bool failed = vkCreateCommandPool(record->handle, &poolInfo, _orion.callbacks.vulkanAllocators, &uploader->commandPool);
+    if (!failed) {
+        VkCommandBufferAllocateInfo info = commandBufferInfo;
+        info.commandPool = uploader->commandPool;
+
+        failed = vkAllocateCommandBuffers(record->handle, &info, uploader->commandBuffers);
+    }
+
+    // a timeline semaphore is used if possible, as the graphics queue can wait on it directly; otherwise, each submission slot
+    // gets a fence
+    if (!failed && (record->features & ORION_DEVICE_FEATURE_TIMELINE_SEMAPHORE_BIT)) {
+        const VkSemaphoreTypeCreateInfo typeInfo = {
+            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+            .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+            .initialValue = 0
+        };
+
+        const VkSemaphoreCreateInfo semaphoreInfo = {
+            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+            .pNext = &typeInfo
+        };
+
+        failed = vkCreateSemaphore(record->handle, &semaphoreInfo, _orion.callbacks.vulkanAllocators, &uploader->timeline);
+    } else if (!failed) {
+        const VkFenceCreateInfo fenceInfo = {
+            .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO
+        };
+
+        for (unsigned int i = 0; !failed && i < MEMORY_UPLOAD_MAX_SUBMISSIONS; i++) {
+            failed = vkCreateFence(record->handle, &fenceInfo, _orion.callbacks.vulkanAllocators, &uploader->fences[i]);
+        }
+    }
+
+    if (failed) {
+        _oriFreeUploaderObjects(record, uploader);
+        free(uploader);
+
+        _oriError(ORIERR_OBJECT_CREATION_FAIL, "failed to create uploader command pool or synchronisation objects");
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    // staging ranges are aligned for both buffer and image copies (texel blocks of up to 16 bytes)
+    if (!_oriInitRing(record, &uploader->staging, (stagingSize) ? stagingSize : 1, record->limits.optimalBufferCopyOffsetMask | 15,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT, ORION_MEMORY_USAGE_STAGING, __func__)
+    ) {
+        _oriFreeUploaderObjects(record, uploader);
+        free(uploader);
+
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    if (mtx_init(&uploader->lock, mtx_plain) != thrd_success) {
+        _oriFreeUploaderObjects(record, uploader);
+        _oriFreeRing(record, &uploader->staging);
+        free(uploader);
+
+        _oriFatalError(ORIFERR_MEMORY_ERROR, __func__);
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    // the uploader is set under the memory lock in case another thread created one at the same time
+    mtx_lock(&record->memory.lock);
+
+    const bool raced = record->uploader != NULL;
+    if (!raced) {
+        record->uploader = uploader;
+    }
+
+    mtx_unlock(&record->memory.lock);
+
+    if (raced) {
+        _oriFreeUploaderObjects(record, uploader);
+        _oriFreeRing(record, &uploader->staging);
+        mtx_destroy(&uploader->lock);
+        free(uploader);
+
+        _oriWarning("device already has an uploader (%s)", __func__);
+        return ORION_RETURN_STATUS_SKIPPED;
+    }
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+const oriReturnStatus_t oriUploadToBuffer(
+    const oriHandle_t device,
+    const VkBuffer buffer,
+    const VkDeviceSize offset,
+    const void *data,
+    const VkDeviceSize size
+) {
+    if (_ORI_CONTRACT_BROKEN(!buffer || !data)) {
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriUploader_t *uploader = record->uploader;
+    if (_ORI_CONTRACT_BROKEN(!uploader)) { // oriCreateDeviceUploader() not called
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    // uploads larger than half of the staging buffer are split, so that one piece can be filled while another is in flight
+    // (the pieces are merged back together when recorded, as long as they don't wrap around the staging buffer)
+    const VkDeviceSize maxPiece = oriAlignDown(uploader->staging.size / 2, uploader->staging.alignmentMask);
+    const unsigned char *src = data;
+
+    oriReturnStatus_t status = ORION_RETURN_STATUS_OK;
+
+    mtx_lock(&uploader->lock);
+
+    for (VkDeviceSize done = 0; !status && done < size;) {
+        VkBufferCopy region = {
+            .dstOffset = offset + done,
+            .size = (size - done < maxPiece || !maxPiece) ? size - done : maxPiece
+        };
+
+        if (!_oriAllocateStaging(record, uploader, region.size, &region.srcOffset, __func__) ||
+            !_oriAddBufferUpload(uploader, buffer, &region)
+        ) {
+            status = ORION_RETURN_STATUS_ERROR;
+            break;
+        }
+
+        memcpy(uploader->staging.data + region.srcOffset, src + done, region.size);
+        done += region.size;
+    }
+
+    mtx_unlock(&uploader->lock);
+
+    return status;
+}
+
+const oriReturnStatus_t oriUploadToImage(
+    const oriHandle_t device,
+    const VkImage image,
+    const VkImageSubresourceLayers *subresource,
+    const VkOffset3D offset,
+    const VkExtent3D extent,
+    const void *data,
+    const VkDeviceSize size
+) {
+    if (_ORI_CONTRACT_BROKEN(!image || !subresource || !data)) {
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriUploader_t *uploader = record->uploader;
+    if (_ORI_CONTRACT_BROKEN(!uploader)) { // oriCreateDeviceUploader() not called
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    // (the data is tightly packed, so the row length and image height are left as 0)
+    VkBufferImageCopy region = {
+        .imageSubresource = *subresource,
+        .imageOffset = offset,
+        .imageExtent = extent
+    };
+
+    oriReturnStatus_t status = ORION_RETURN_STATUS_ERROR;
+
+    mtx_lock(&uploader->lock);
+
+    if (_oriAllocateStaging(record, uploader, size, &region.bufferOffset, __func__) && _oriAddImageUpload(uploader, image, &region)) {
+        memcpy(uploader->staging.data + region.bufferOffset, data, size);
+        status = ORION_RETURN_STATUS_OK;
+    }
+
+    mtx_unlock(&uploader->lock);
+
+    return status;
+}
+
+const oriReturnStatus_t oriSubmitUploads(
+    const oriHandle_t device,
+    const VkSemaphore signalSemaphore,
+    uint64_t *valueOut
+) {
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriUploader_t *uploader = record->uploader;
+    if (_ORI_CONTRACT_BROKEN(!uploader)) { // oriCreateDeviceUploader() not called
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    mtx_lock(&uploader->lock);
+
+    _oriUpdateCompletedUploads(record, uploader);
+    const oriReturnStatus_t status = _oriSubmitUploadsLocked(record, uploader, signalSemaphore, __func__);
+
+    // (if nothing was submitted, waiting for the last submission is just as good)
+    if (valueOut && status != ORION_RETURN_STATUS_ERROR) {
+        *valueOut = uploader->submittedValue;
+    }
+
+    mtx_unlock(&uploader->lock);
+
+    return status;
+}
+
+const oriReturnStatus_t oriGetUploadSemaphore(
+    const oriHandle_t device,
+    VkSemaphore *semaphoreOut
+) {
+    if (!semaphoreOut) {
+        _oriWarning("all output variables NULL in call to %s", __func__);
+        return ORION_RETURN_STATUS_NO_OUTPUT;
+    }
+
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    if (_ORI_CONTRACT_BROKEN(!record->uploader)) { // oriCreateDeviceUploader() not called
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    *semaphoreOut = record->uploader->timeline;
+
+    return ORION_RETURN_STATUS_OK;
+}
+
+const oriReturnStatus_t oriWaitForUploads(
+    const oriHandle_t device,
+    const uint64_t value
+) {
+    _oriVkDevice_t *record = _oriGetDevice(device, __func__);
+    if (!record) {
+        return ORION_RETURN_STATUS_ERROR;
+    }
+
+    _oriUploader_t *uploader = record->uploader;
+    if (_ORI_CONTRACT_BROKEN(!uploader)) { // oriCreateDeviceUploader() not called
+        _oriError(ORIERR_NULL_POINTER, __func__);
+        return ORION_RETURN_STATUS_NULL_POINTER;
+    }
+
+    mtx_lock(&uploader->lock);
+    _oriWaitForUpload(record, uploader, (value < uploader->submittedValue) ? value : uploader->submittedValue);
+    mtx_unlock(&uploader->lock);
+
+    return ORION_RETURN_STATUS_OK;
+}
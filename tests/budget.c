@@ -0,0 +1,100 @@
+#include "headless.h"
+
+#define CHUNK_SIZE 1048576
+#define CHUNK_COUNT 4
+
+headless_t headless;
+
+unsigned int evictionCount;
+
+static bool evict(const oriHandle_t device, const oriHandle_t allocation, const VkDeviceSize size, void *userData) {
+    evictionCount++;
+    return false;
+}
+
+int main() {
+    // ===========================================
+    // initialise program
+    //
+
+    CHECK(!initHeadless(&headless, "Orion memory budget test", 0, NULL), "set up headless device");
+
+    const oriHandle_t deviceHandle = headless.deviceHandle;
+
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    vkGetPhysicalDeviceMemoryProperties(headless.physicalDevice, &memoryProperties);
+
+    // ===========================================
+    // budget
+    //
+
+    oriMemoryBudget_t before;
+    CHECK(!oriGetMemoryBudget(deviceHandle, &before), "get memory budget");
+    CHECK(before.heapCount == memoryProperties.memoryHeapCount, "count memory heaps");
+
+    for (uint32_t i = 0; i < before.heapCount; i++) {
+        CHECK(before.heaps[i].budget && before.heaps[i].budget <= memoryProperties.memoryHeaps[i].size, "estimate heap budgets");
+        CHECK(before.heaps[i].allocationBytes <= before.heaps[i].blockBytes, "count allocated bytes");
+    }
+
+    const VkMemoryRequirements requirements = {
+        .size = CHUNK_SIZE,
+        .alignment = 256,
+        .memoryTypeBits = ~0u
+    };
+
+    oriHandle_t chunks[CHUNK_COUNT];
+    for (unsigned int i = 0; i < CHUNK_COUNT; i++) {
+        CHECK(!oriAllocateMemory(deviceHandle, &requirements, 0, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true, &chunks[i]), "allocate memory");
+    }
+
+    oriAllocationInfo_t info;
+    CHECK(!oriGetAllocationInfo(deviceHandle, chunks[0], &info), "get allocation info");
+    const uint32_t heap = memoryProperties.memoryTypes[info.memoryTypeIndex].heapIndex;
+
+    // allocations are counted in the budget of their heap as soon as they are made
+    oriMemoryBudget_t after;
+    CHECK(!oriGetMemoryBudget(deviceHandle, &after), "get memory budget");
+    CHECK(after.heaps[heap].allocationBytes >= before.heaps[heap].allocationBytes + CHUNK_SIZE * CHUNK_COUNT, "count allocations in budget");
+    CHECK(after.heaps[heap].blockBytes >= after.heaps[heap].allocationBytes, "count allocated blocks in budget");
+    CHECK(after.heaps[heap].usage >= after.heaps[heap].blockBytes || after.budgetExtension, "estimate heap usage");
+
+    // ===========================================
+    // eviction
+    //
+
+    for (unsigned int i = 0; i < CHUNK_COUNT; i++) {
+        CHECK(!oriSetAllocationEvictable(deviceHandle, chunks[i], evict, NULL), "mark allocation as evictable");
+    }
+    CHECK(!oriTouchAllocation(deviceHandle, chunks[0]), "touch allocation");
+
+    // every allocation is in the last block of its memory type, which is never evicted from, whatever the budget
+    CHECK(!oriEnforceMemoryBudget(deviceHandle), "enforce memory budget");
+    CHECK(!evictionCount, "keep the last block of a memory type");
+
+    // allocations can stop being evictable, and touching them then does nothing
+    CHECK(!oriSetAllocationEvictable(deviceHandle, chunks[0], NULL, NULL), "mark allocation as not evictable");
+    CHECK(!oriTouchAllocation(deviceHandle, chunks[0]), "touch allocation");
+
+    // evictable allocations can be freed as any other (and handles that have been freed are rejected, through the debug callback)
+    CHECK(!oriFreeMemory(deviceHandle, chunks[1]), "free evictable memory");
+    CHECK(oriTouchAllocation(deviceHandle, chunks[1]), "reject a freed allocation");
+
+    CHECK(!oriEnforceMemoryBudget(deviceHandle), "enforce memory budget");
+    CHECK(!evictionCount, "keep the last block of a memory type");
+
+    // ===========================================
+    // termination of API
+    //
+
+    oriFreeMemory(deviceHandle, chunks[0]);
+    for (unsigned int i = 2; i < CHUNK_COUNT; i++) {
+        oriFreeMemory(deviceHandle, chunks[i]);
+    }
+
+    terminateHeadless(&headless);
+
+    printf("memory budget test passed\n");
+
+    return 0;
+}
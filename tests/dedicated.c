@@ -0,0 +1,76 @@
+#include "headless.h"
+
+#define CHUNK_SIZE 65536
+#define LARGE_SIZE 67108864     // the size from which allocations are given a dedicated block
+
+headless_t headless;
+
+int main() {
+    // ===========================================
+    // initialise program
+    //
+
+    CHECK(!initHeadless(&headless, "Orion dedicated allocation test", 0, NULL), "set up headless device");
+
+    const oriHandle_t deviceHandle = headless.deviceHandle;
+
+    // ===========================================
+    // raw allocations
+    //
+
+    const VkMemoryRequirements requirements[] = {
+        { .size = CHUNK_SIZE, .alignment = 256, .memoryTypeBits = ~0u },
+        { .size = LARGE_SIZE, .alignment = 256, .memoryTypeBits = ~0u }
+    };
+
+    oriHandle_t small, large;
+    CHECK(!oriAllocateMemory(deviceHandle, &requirements[0], 0, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true, &small), "allocate memory");
+    CHECK(!oriAllocateMemory(deviceHandle, &requirements[1], 0, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true, &large), "allocate memory");
+
+    oriAllocationInfo_t smallInfo, largeInfo;
+    CHECK(!oriGetAllocationInfo(deviceHandle, small, &smallInfo), "get allocation info");
+    CHECK(!oriGetAllocationInfo(deviceHandle, large, &largeInfo), "get allocation info");
+
+    CHECK(!smallInfo.dedicated, "sub-allocate small allocations");
+    CHECK(largeInfo.dedicated && !largeInfo.offset && largeInfo.memory != smallInfo.memory, "give large allocations their own block");
+
+    // a dedicated block is released along with its allocation
+    oriDeviceMemoryStatistics_t before, after;
+    CHECK(!oriGetMemoryStatistics(deviceHandle, &before), "get memory statistics");
+    CHECK(!oriFreeMemory(deviceHandle, large), "free dedicated memory");
+    CHECK(!oriGetMemoryStatistics(deviceHandle, &after), "get memory statistics");
+    CHECK(after.total.blockCount == before.total.blockCount - 1 && after.total.blockBytes <= before.total.blockBytes - LARGE_SIZE,
+        "release a dedicated block");
+
+    // ===========================================
+    // buffers
+    //
+
+    const VkBufferCreateInfo bufferInfo = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size = LARGE_SIZE,
+        .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+    };
+
+    oriHandle_t largeBuffer;
+    VkBuffer buffer;
+    CHECK(!oriCreateBuffer(deviceHandle, &bufferInfo, 0, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &largeBuffer, &buffer), "create buffer");
+
+    oriAllocationInfo_t bufferAllocation;
+    CHECK(!oriGetAllocationInfo(deviceHandle, largeBuffer, &bufferAllocation), "get allocation info");
+    CHECK(bufferAllocation.dedicated && bufferAllocation.buffer == buffer, "give large buffers their own block");
+
+    // ===========================================
+    // termination of API
+    //
+
+    oriFreeMemory(deviceHandle, largeBuffer);
+    oriFreeMemory(deviceHandle, small);
+
+    terminateHeadless(&headless);
+
+    printf("dedicated allocation test passed\n");
+
+    return 0;
+}
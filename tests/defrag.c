@@ -0,0 +1,154 @@
+#include "headless.h"
+
+#define BUFFER_SIZE 1048576
+#define MAX_FILLER_SIZE 33554432    // well below the size at which allocations get their own block
+#define MAX_FILLERS 64
+
+headless_t headless;
+
+// find the statistics of the block that an allocation is in
+//
+static int getBlockStatistics(const VkDeviceMemory memory, oriMemoryStatistics_t *statisticsOut) {
+    oriMemoryBlockStatistics_t blocks[MAX_FILLERS];
+    unsigned int blockCount;
+    CHECK(!oriEnumerateMemoryBlocks(headless.deviceHandle, MAX_FILLERS, &blockCount, blocks), "enumerate memory blocks");
+
+    unsigned int i = 0;
+    while (i < blockCount && blocks[i].memory != memory) {
+        i++;
+    }
+    CHECK(i < blockCount, "find the block of an allocation");
+
+    *statisticsOut = blocks[i].statistics;
+
+    return 0;
+}
+
+int main() {
+    // ===========================================
+    // initialise program
+    //
+
+    CHECK(!initHeadless(&headless, "Orion defragmentation test", 0, NULL), "set up headless device");
+
+    const oriHandle_t deviceHandle = headless.deviceHandle;
+
+    // ===========================================
+    // fragmentation
+    //
+
+    // buffers that can be copied, and aren't shared or dedicated, can be moved by the defragmenter
+    const VkBufferCreateInfo bufferInfo = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size = BUFFER_SIZE,
+        .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+    };
+
+    // (host-coherent memory, so that the buffer contents can be checked without flushing or invalidating)
+    const VkMemoryPropertyFlags flags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+    oriHandle_t first;
+    VkBuffer firstBuffer;
+    CHECK(!oriCreateBuffer(deviceHandle, &bufferInfo, flags, 0, &first, &firstBuffer), "create buffer");
+
+    oriAllocationInfo_t firstInfo;
+    CHECK(!oriGetAllocationInfo(deviceHandle, first, &firstInfo), "get allocation info");
+
+    // fill the rest of the first block, so that the next buffer has to go into a second one
+    const VkMemoryRequirements fillerRequirements = {
+        .alignment = 256,
+        .memoryTypeBits = 1u << firstInfo.memoryTypeIndex
+    };
+
+    oriHandle_t fillers[MAX_FILLERS];
+    unsigned int fillerCount = 0;
+
+    oriMemoryStatistics_t blockStatistics;
+    CHECK(!getBlockStatistics(firstInfo.memory, &blockStatistics), "get block statistics");
+
+    while (blockStatistics.largestFreeRange >= BUFFER_SIZE) {
+        CHECK(fillerCount < MAX_FILLERS, "fill a memory block");
+
+        VkMemoryRequirements requirements = fillerRequirements;
+        requirements.size = oriAlignDown(blockStatistics.largestFreeRange, 255);
+        if (requirements.size > MAX_FILLER_SIZE) {
+            requirements.size = MAX_FILLER_SIZE;
+        }
+
+        CHECK(!oriAllocateMemory(deviceHandle, &requirements, flags, 0, true, &fillers[fillerCount]), "allocate filler memory");
+        fillerCount++;
+
+        CHECK(!getBlockStatistics(firstInfo.memory, &blockStatistics), "get block statistics");
+    }
+
+    oriHandle_t second;
+    VkBuffer secondBuffer;
+    CHECK(!oriCreateBuffer(deviceHandle, &bufferInfo, flags, 0, &second, &secondBuffer), "create buffer");
+
+    oriAllocationInfo_t secondInfo;
+    CHECK(!oriGetAllocationInfo(deviceHandle, second, &secondInfo), "get allocation info");
+    CHECK(secondInfo.memoryTypeIndex == firstInfo.memoryTypeIndex && secondInfo.memory != firstInfo.memory,
+        "put a buffer in a second block");
+    CHECK(secondInfo.mappedData, "map buffer");
+
+    unsigned char *data = secondInfo.mappedData;
+    for (unsigned int i = 0; i < BUFFER_SIZE; i++) {
+        data[i] = (unsigned char) (i * 13 + (i >> 10));
+    }
+
+    // make room in the first block, which the second block's only buffer can now be moved into
+    CHECK(fillerCount, "fill a memory block");
+    CHECK(!oriFreeMemory(deviceHandle, fillers[0]), "free filler memory");
+
+    // ===========================================
+    // defragmentation
+    //
+
+    // (the stats add up over every pass, and a pass with no budget moves nothing, so this only returns them)
+    oriDefragmentStats_t before, after;
+
+    CHECK(!beginHeadlessCommands(&headless), "begin commands");
+    CHECK(!oriDefragment(deviceHandle, headless.commandBuffer, 0, 0, 0, &before), "get defragmentation stats");
+    CHECK(!oriDefragment(deviceHandle, headless.commandBuffer, BUFFER_SIZE * 4, 1, 0, &after), "defragment memory");
+    CHECK(!submitHeadlessCommands(&headless), "submit defragmentation");
+
+    CHECK(after.movedAllocations > before.movedAllocations, "move an allocation");
+    CHECK(after.pendingReleases > before.pendingReleases, "keep the old chunk until the copy has completed");
+
+    // the handle now refers to a new buffer in the first block, which has been given the data of the old one
+    oriAllocationInfo_t movedInfo;
+    CHECK(!oriGetAllocationInfo(deviceHandle, second, &movedInfo), "get allocation info");
+    CHECK(movedInfo.buffer && movedInfo.buffer != secondBuffer, "recreate a moved buffer");
+    CHECK(movedInfo.memory == firstInfo.memory, "move an allocation into another block");
+    CHECK(movedInfo.mappedData, "map moved buffer");
+
+    data = movedInfo.mappedData;
+    for (unsigned int i = 0; i < BUFFER_SIZE; i++) {
+        CHECK(data[i] == (unsigned char) (i * 13 + (i >> 10)), "copy the data of a moved buffer");
+    }
+
+    // once the first pass has completed, the old chunk is released, and with it the (now empty) second block
+    CHECK(!beginHeadlessCommands(&headless), "begin commands");
+    CHECK(!oriDefragment(deviceHandle, headless.commandBuffer, 0, 2, 1, &after), "release defragmented memory");
+    CHECK(!submitHeadlessCommands(&headless), "submit defragmentation");
+
+    CHECK(!after.pendingReleases, "release moved allocations");
+    CHECK(after.releasedBlocks > before.releasedBlocks, "release an emptied block");
+
+    // ===========================================
+    // termination of API
+    //
+
+    for (unsigned int i = 1; i < fillerCount; i++) {
+        oriFreeMemory(deviceHandle, fillers[i]);
+    }
+    oriFreeMemory(deviceHandle, first);
+    oriFreeMemory(deviceHandle, second);
+
+    terminateHeadless(&headless);
+
+    printf("defragmentation test passed\n");
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+#ifndef __HEADLESS_H
+#define __HEADLESS_H
+
+#include "shared.h"
+
+// Setup shared by the tests that need no window or surface, so that they can be run headless on a software implementation
+// such as lavapipe (e.g. with VK_ICD_FILENAMES pointing to lvp_icd.*.json); CPU devices are preferred over any other.
+
+#define CHECK(expression, message) \
+    do { \
+        if (!(expression)) { \
+            printf("failed to %s\n", message); \
+            return -1; \
+        } \
+    } while (0)
+
+typedef struct headless_t {
+    VkInstance instance;
+    VkPhysicalDevice physicalDevice;
+    VkDevice device;
+
+    oriHandle_t instanceHandle;
+    oriHandle_t deviceHandle;
+
+    oriQueueAssignment_t graphics;
+    oriQueueAssignment_t transfer;  // same as graphics if there is no separate transfer queue
+
+    VkQueue graphicsQueue;
+    VkCommandPool commandPool;
+    VkCommandBuffer commandBuffer;  // allocated from commandPool, on the graphics queue family
+} headless_t;
+
+// prefer a CPU implementation (lavapipe), but accept any device
+static bool isCpuDevice(const VkPhysicalDevice physicalDevice) {
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+    return properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU;
+}
+
+// initialise Orion (with Vulkan 1.1, which is needed for dedicated allocations and VK_EXT_external_memory_host) and create a
+// logical device with a graphics and (optionally) a transfer queue
+//
+static int initHeadless(headless_t *headless, const char *name, const unsigned int extensionCount, const char **extensions) {
+    memset(headless, 0, sizeof(headless_t));
+
+    // setup debugging
+    oriConfigureDebugMessages(ORION_DEBUG_SEVERITY_ALL_BIT);
+    oriSetObjectTrackingEnabled(true);
+
+    CHECK(!oriInit(1, &headless->instance, &headless->instanceHandle, 0, VK_API_VERSION_1_1, name, VK_MAKE_VERSION(1, 0, 0),
+        "No Engine", VK_MAKE_VERSION(1, 0, 0), 0, NULL, 0, NULL, NULL), "initialise Orion");
+
+    unsigned int physicalDeviceCount = 1;
+    oriEnumerateSuitablePhysicalDevicesInto(headless->instanceHandle, isCpuDevice, &physicalDeviceCount, &headless->physicalDevice);
+    if (!physicalDeviceCount) {
+        physicalDeviceCount = 1;
+        oriEnumerateSuitablePhysicalDevicesInto(headless->instanceHandle, NULL, &physicalDeviceCount, &headless->physicalDevice);
+    }
+    CHECK(physicalDeviceCount, "find a physical device");
+
+    // no surface, so no present role
+    const oriQueueRoleRequest_t queueRoles[] = {
+        { ORION_QUEUE_ROLE_GRAPHICS,        1.0f,   true },
+        { ORION_QUEUE_ROLE_TRANSFER,        0.5f,   false }
+    };
+
+    oriQueueSolution_t queueSolution;
+    CHECK(!oriSolveQueueFamilies(headless->physicalDevice, VK_NULL_HANDLE, 2, queueRoles, &queueSolution),
+        "find suitable queue families");
+
+    headless->graphics = queueSolution.assignments[ORION_QUEUE_ROLE_GRAPHICS];
+    headless->transfer = (queueSolution.assignments[ORION_QUEUE_ROLE_TRANSFER].assigned) ?
+        queueSolution.assignments[ORION_QUEUE_ROLE_TRANSFER] : headless->graphics;
+
+    for (unsigned int i = 0; i < extensionCount; i++) {
+        CHECK(oriCheckDeviceExtensionAvailability(headless->physicalDevice, extensions[i], NULL), "find a device extension");
+    }
+
+    CHECK(!oriCreateLogicalDevice(&headless->device, &headless->deviceHandle, 0, headless->physicalDevice,
+        queueSolution.queueCreateInfoCount, queueSolution.queueCreateInfos, extensionCount, extensions, NULL, NULL),
+        "create logical device");
+
+    vkGetDeviceQueue(headless->device, headless->graphics.familyIndex, headless->graphics.queueIndex, &headless->graphicsQueue);
+
+    const VkCommandPoolCreateInfo poolInfo = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+        .queueFamilyIndex = headless->graphics.familyIndex
+    };
+    CHECK(!vkCreateCommandPool(headless->device, &poolInfo, oriGetVulkanAllocators(), &headless->commandPool),
+        "create command pool");
+
+    const VkCommandBufferAllocateInfo commandBufferInfo = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+        .commandPool = headless->commandPool,
+        .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+        .commandBufferCount = 1
+    };
+    CHECK(!vkAllocateCommandBuffers(headless->device, &commandBufferInfo, &headless->commandBuffer), "allocate command buffer");
+
+    return 0;
+}
+
+// reset the command pool and begin recording into the command buffer
+//
+static int beginHeadlessCommands(headless_t *headless) {
+    const VkCommandBufferBeginInfo beginInfo = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+    };
+
+    CHECK(!vkResetCommandPool(headless->device, headless->commandPool, 0), "reset command pool");
+    CHECK(!vkBeginCommandBuffer(headless->commandBuffer, &beginInfo), "begin command buffer");
+
+    return 0;
+}
+
+// end the command buffer, submit it to the graphics queue and wait for it to complete
+//
+static int submitHeadlessCommands(headless_t *headless) {
+    const VkSubmitInfo submitInfo = {
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .commandBufferCount = 1,
+        .pCommandBuffers = &headless->commandBuffer
+    };
+
+    CHECK(!vkEndCommandBuffer(headless->commandBuffer), "end command buffer");
+    CHECK(!vkQueueSubmit(headless->graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE), "submit command buffer");
+    CHECK(!vkQueueWaitIdle(headless->graphicsQueue), "wait for command buffer");
+
+    return 0;
+}
+
+// destroy the logical device (and with it any memory left allocated from it) and terminate Orion
+//
+static void terminateHeadless(headless_t *headless) {
+    vkDestroyCommandPool(headless->device, headless->commandPool, oriGetVulkanAllocators());
+    oriDestroyLogicalDevice(headless->deviceHandle);
+
+    // terminate library and destroy the instance created with oriInit().
+    oriTerminate();
+}
+
+#endif // __HEADLESS_H
@@ -0,0 +1,112 @@
+#include "headless.h"
+
+#include <stdlib.h>
+
+#define IMPORT_PAGES 4
+#define DATA_OFFSET 256     // the data doesn't have to start on a page boundary
+
+headless_t headless;
+
+int main() {
+    // ===========================================
+    // initialise program
+    //
+
+    const char *deviceExtensions[] = {
+        VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME
+    };
+
+    CHECK(!initHeadless(&headless, "Orion host memory import test", 1, deviceExtensions), "set up headless device");
+
+    const oriHandle_t deviceHandle = headless.deviceHandle;
+
+    // ===========================================
+    // host memory import
+    //
+
+    oriDeviceLimits_t limits;
+    CHECK(!oriGetDeviceLimits(deviceHandle, &limits), "get device limits");
+    CHECK(limits.minImportedHostPointerAlignment, "get the host pointer alignment");
+
+    const VkDeviceSize pagesSize = limits.minImportedHostPointerAlignment * IMPORT_PAGES;
+    const VkDeviceSize dataSize = pagesSize - DATA_OFFSET * 2;
+
+    unsigned char *hostPages = aligned_alloc(limits.minImportedHostPointerAlignment, pagesSize);
+    CHECK(hostPages, "allocate host memory");
+
+    unsigned char *hostData = hostPages + DATA_OFFSET;
+    for (VkDeviceSize i = 0; i < dataSize; i++) {
+        hostData[i] = (unsigned char) (i * 17 + (i >> 8));
+    }
+
+    oriHandle_t imported;
+    VkBuffer importedBuffer;
+    CHECK(!oriImportHostMemory(deviceHandle, hostData, dataSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, &imported, &importedBuffer),
+        "import host memory");
+
+    // the allocation starts at the data, not at the page it is in
+    oriAllocationInfo_t importedInfo;
+    CHECK(!oriGetAllocationInfo(deviceHandle, imported, &importedInfo), "get allocation info");
+    CHECK(importedInfo.mappedData == hostData && importedInfo.buffer == importedBuffer, "map imported memory");
+    CHECK(importedInfo.dedicated && importedInfo.size >= dataSize, "import host memory as a block of its own");
+
+    oriMemoryBlockStatistics_t blocks[16];
+    unsigned int blockCount;
+    CHECK(!oriEnumerateMemoryBlocks(deviceHandle, 16, &blockCount, blocks), "enumerate memory blocks");
+
+    bool listed = false;
+    for (unsigned int i = 0; i < blockCount; i++) {
+        listed |= blocks[i].memory == importedInfo.memory && blocks[i].imported;
+    }
+    CHECK(listed, "list imported memory blocks");
+
+    // imported memory is written by the application directly, so it is never flushed
+    CHECK(!oriMarkAllocationWritten(deviceHandle, imported, 0, VK_WHOLE_SIZE), "mark imported memory as written");
+    CHECK(oriFlushAllocations(deviceHandle) == ORION_RETURN_STATUS_SKIPPED, "skip flushing imported memory");
+
+    // ===========================================
+    // transfers
+    //
+
+    // the GPU reads the imported data straight from the application's memory
+    const VkBufferCreateInfo readbackInfo = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size = dataSize,
+        .usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+    };
+
+    oriHandle_t readback;
+    VkBuffer readbackBuffer;
+    CHECK(!oriCreateBufferForUsage(deviceHandle, &readbackInfo, ORION_MEMORY_USAGE_GPU_TO_CPU, &readback, &readbackBuffer),
+        "create readback buffer");
+
+    const VkBufferCopy region = {
+        .size = dataSize
+    };
+
+    CHECK(!beginHeadlessCommands(&headless), "begin commands");
+    vkCmdCopyBuffer(headless.commandBuffer, importedBuffer, readbackBuffer, 1, &region);
+    CHECK(!submitHeadlessCommands(&headless), "submit copy");
+
+    oriAllocationInfo_t readbackAllocation;
+    CHECK(!oriGetAllocationInfo(deviceHandle, readback, &readbackAllocation), "get allocation info");
+    CHECK(!oriInvalidateAllocation(deviceHandle, readback, 0, VK_WHOLE_SIZE), "invalidate readback buffer");
+    CHECK(!memcmp(readbackAllocation.mappedData, hostData, dataSize), "read back imported data");
+
+    // ===========================================
+    // termination of API
+    //
+
+    // the host memory can only be freed once the import has been
+    CHECK(!oriFreeMemory(deviceHandle, imported), "free imported memory");
+    free(hostPages);
+
+    oriFreeMemory(deviceHandle, readback);
+
+    terminateHeadless(&headless);
+
+    printf("host memory import test passed\n");
+
+    return 0;
+}
@@ -8,9 +8,11 @@ GLFWwindow *window_Main;
 VkSurfaceKHR surface_Main;
 
 VkInstance instance;
-VkDebugUtilsMessengerEXT debugMessenger;
 VkDevice device;
 
+oriHandle_t instanceHandle;
+oriHandle_t deviceHandle;
+
 int main() {
     // ===========================================
     // initialise program
@@ -24,6 +26,10 @@ int main() {
 
     // setup debugging
     oriConfigureDebugMessages(ORION_DEBUG_SEVERITY_ALL_BIT);
+    oriSetObjectTrackingEnabled(true);
+
+    // cache layer, extension and format queries between runs
+    oriSetStartupCachePath("orion_startup.cache");
 
     // ===========================================
     // create Vulkan instance
@@ -41,26 +47,11 @@ int main() {
         "VK_EXT_debug_utils"
     };
 
-    // create debug messenger
-    VkDebugUtilsMessengerCreateInfoEXT debugUtilsMessengerInfo = {
-        .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT,
-        .flags = 0,
-        .messageSeverity =
-            VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT |
-            VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT,
-        .messageType =
-            VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT |
-            VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT |
-            VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT,
-        .pNext = NULL,
-        .pUserData = NULL,
-        .pfnUserCallback = vulkanCallback
-    };
-
-    // create instance + initialise everything
-    oriInit(
+    // create instance + initialise everything (in the background, as there would usually be other startup work to do here)
+    oriInitAsync(
         1,
         &instance,
+        &instanceHandle,
         0,
         VK_API_VERSION_1_3,
         "Orion application",
@@ -71,21 +62,27 @@ int main() {
         layers,
         3,
         instanceExtensions,
-        &debugUtilsMessengerInfo
+        NULL
     );
 
-    // load necessary non-core Vulkan functions for the program
-    PFN_vkCreateDebugUtilsMessengerEXT CreateDebugUtilsMessengerEXT =
-        (PFN_vkCreateDebugUtilsMessengerEXT) vkGetInstanceProcAddr(instance, "vkCreateDebugUtilsMessengerEXT");
-    PFN_vkDestroyDebugUtilsMessengerEXT DestroyDebugUtilsMessengerEXT =
-        (PFN_vkDestroyDebugUtilsMessengerEXT) vkGetInstanceProcAddr(instance, "vkDestroyDebugUtilsMessengerEXT");
+    if (oriWaitInit()) {
+        printf("failed to initialise Orion\n");
+        return -1;
+    }
 
     // ===========================================
     // create debug messenger
     //
 
-    // create a debug messenger with the same create-info that was passed to oriInit for the instance's pNext
-    if (CreateDebugUtilsMessengerEXT(instance, &debugUtilsMessengerInfo, NULL, &debugMessenger)) {
+    // Orion will forward validation messages to its debug output, and count performance warnings
+    if (oriCreateDebugMessenger(
+        instanceHandle,
+        VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT |
+        VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT,
+        VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT |
+        VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT |
+        VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT
+    )) {
         printf("failed to create debug messenger\n");
         return -1;
     }
@@ -115,57 +112,30 @@ int main() {
     //
 
     // get available physical devices
-    VkPhysicalDevice *suitablePhysicalDevices;
-    unsigned int suitablePhysicalDeviceCount;
-    oriEnumerateSuitablePhysicalDevices(&instance, NULL, &suitablePhysicalDeviceCount, &suitablePhysicalDevices);
-
-    // get available queue families
-    VkQueueFamilyProperties *queueFamilyProperties;
-    unsigned int queueFamilyPropertyCount;
-    oriEnumerateAvailableQueueFamilies(&suitablePhysicalDevices[0], &queueFamilyPropertyCount, &queueFamilyProperties);
-
-    // get necessary queue family indices
-    struct {
-        unsigned int graphics;
-        unsigned int present;
-    } queueFamilyIndices = { 0 };
-    const unsigned int queueFamilyIndexCount = 2;
-
-    for (unsigned int i = 0; i < queueFamilyPropertyCount; i++) {
-        // check for graphics queue
-        if ((queueFamilyProperties[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) == VK_QUEUE_GRAPHICS_BIT) {
-            queueFamilyIndices.graphics = i;
-        }
-
-        // check for surface support; if the queue family has surface support, it is a present queue
-        VkBool32 psupport = false;
-        vkGetPhysicalDeviceSurfaceSupportKHR(suitablePhysicalDevices[0], i, surface_Main, &psupport);
-
-        if (psupport) {
-            queueFamilyIndices.present = i;
-        }
+    // (only the first device is used, so there is no need to allocate space for any more)
+    VkPhysicalDevice suitablePhysicalDevices[1];
+    unsigned int suitablePhysicalDeviceCount = 1;
+    oriEnumerateSuitablePhysicalDevicesInto(instanceHandle, NULL, &suitablePhysicalDeviceCount, suitablePhysicalDevices);
+    if (!suitablePhysicalDeviceCount) {
+        printf("failed to find a physical device\n");
+        return -1;
     }
 
-    // create an initinfo struct for each queue (one from each queue family)
-    VkDeviceQueueCreateInfo queueCreateInfos[queueFamilyIndexCount];
-
-    {
-        float queuePriority = 1.0f;
-
-        // array of unique queue indices
-        unsigned int uniqueQueueIndices[] = {
-            queueFamilyIndices.graphics,
-            queueFamilyIndices.present
-        };
-
-        for (unsigned int i = 0; i < queueFamilyIndexCount; i++) {
-            queueCreateInfos[i].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-            queueCreateInfos[i].pNext = NULL;
-            queueCreateInfos[i].flags = 0;
-            queueCreateInfos[i].queueFamilyIndex = uniqueQueueIndices[i];
-            queueCreateInfos[i].queueCount = 1;
-            queueCreateInfos[i].pQueuePriorities = &queuePriority;
-        }
+    // query the device's format support in the background while the rest of the setup is done
+    oriPrefetchFormatProperties(suitablePhysicalDevices[0], true);
+
+    // choose queue families: graphics and present are required, and an async compute and transfer queue are used if available
+    const oriQueueRoleRequest_t queueRoles[] = {
+        { ORION_QUEUE_ROLE_GRAPHICS,        1.0f,   true },
+        { ORION_QUEUE_ROLE_PRESENT,         1.0f,   true },
+        { ORION_QUEUE_ROLE_ASYNC_COMPUTE,   0.75f,  false },
+        { ORION_QUEUE_ROLE_TRANSFER,        0.5f,   false }
+    };
+
+    oriQueueSolution_t queueSolution;
+    if (oriSolveQueueFamilies(suitablePhysicalDevices[0], surface_Main, 4, queueRoles, &queueSolution)) {
+        printf("failed to find suitable queue families\n");
+        return -1;
     }
 
     // list of device extensions to enable
@@ -174,7 +144,7 @@ int main() {
     };
 
     // create logical device
-    oriCreateLogicalDevice(&device, 0, suitablePhysicalDevices[0], queueFamilyIndexCount, queueCreateInfos, 1, deviceExtensions, NULL, NULL);
+    oriCreateLogicalDevice(&device, &deviceHandle, 0, suitablePhysicalDevices[0], queueSolution.queueCreateInfoCount, queueSolution.queueCreateInfos, 1, deviceExtensions, NULL, NULL);
 
     // ===========================================
     // main loop
@@ -190,10 +160,12 @@ int main() {
     // termination of API
     //
 
-    // destroy Vulkan objects BEFORE oriTerminate(), as that function will destroy the instance
-    DestroyDebugUtilsMessengerEXT(instance, debugMessenger, oriGetVulkanAllocators());
+    // report the most frequent performance warnings
+    oriDumpPerformanceWarnings(instanceHandle, 10);
+
+    // destroy Vulkan objects BEFORE oriTerminate(), as that function will destroy the instance (and the debug messenger)
     vkDestroySurfaceKHR(instance, surface_Main, oriGetVulkanAllocators());
-    vkDestroyDevice(device, oriGetVulkanAllocators());
+    oriDestroyLogicalDevice(deviceHandle);
 
     // terminate library and destroy the instance created with oriInit().
     oriTerminate(true);
@@ -0,0 +1,117 @@
+#include "headless.h"
+
+#define BUFFER_SIZE 65536
+
+headless_t headless;
+
+int main() {
+    // ===========================================
+    // initialise program
+    //
+
+    CHECK(!initHeadless(&headless, "Orion mapped memory test", 0, NULL), "set up headless device");
+
+    const oriHandle_t deviceHandle = headless.deviceHandle;
+
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    vkGetPhysicalDeviceMemoryProperties(headless.physicalDevice, &memoryProperties);
+
+    // ===========================================
+    // flushing
+    //
+
+    const VkBufferCreateInfo bufferInfo = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size = BUFFER_SIZE,
+        .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+    };
+
+    oriHandle_t source, readback;
+    VkBuffer sourceBuffer, readbackBuffer;
+    CHECK(!oriCreateBufferForUsage(deviceHandle, &bufferInfo, ORION_MEMORY_USAGE_CPU_TO_GPU, &source, &sourceBuffer), "create buffer");
+    CHECK(!oriCreateBufferForUsage(deviceHandle, &bufferInfo, ORION_MEMORY_USAGE_GPU_TO_CPU, &readback, &readbackBuffer), "create buffer");
+
+    oriAllocationInfo_t sourceInfo, readbackInfo;
+    CHECK(!oriGetAllocationInfo(deviceHandle, source, &sourceInfo), "get allocation info");
+    CHECK(!oriGetAllocationInfo(deviceHandle, readback, &readbackInfo), "get allocation info");
+    CHECK(sourceInfo.mappedData && readbackInfo.mappedData, "map host-visible memory");
+
+    // written in two overlapping halves, whose ranges are merged
+    unsigned char *data = sourceInfo.mappedData;
+    for (unsigned int i = 0; i < BUFFER_SIZE; i++) {
+        data[i] = (unsigned char) (i * 31 + (i >> 9));
+    }
+
+    CHECK(!oriMarkAllocationWritten(deviceHandle, source, 0, BUFFER_SIZE / 2 + 256), "mark memory as written");
+    CHECK(!oriMarkAllocationWritten(deviceHandle, source, BUFFER_SIZE / 2, VK_WHOLE_SIZE), "mark memory as written");
+
+    // (nothing is recorded for host-coherent memory)
+    const oriReturnStatus_t flushed = oriFlushAllocations(deviceHandle);
+    CHECK(flushed == ((sourceInfo.propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) ? ORION_RETURN_STATUS_SKIPPED : ORION_RETURN_STATUS_OK),
+        "flush written memory");
+    CHECK(oriFlushAllocations(deviceHandle) == ORION_RETURN_STATUS_SKIPPED, "skip flushes with nothing written");
+
+    // ranges outside of the allocation are rejected (through the debug callback)
+    CHECK(oriMarkAllocationWritten(deviceHandle, source, sourceInfo.size, 1), "reject a range past the allocation");
+    CHECK(oriMarkAllocationWritten(deviceHandle, source, sourceInfo.size / 2, sourceInfo.size), "reject a range running past the allocation");
+
+    // ===========================================
+    // invalidation
+    //
+
+    const VkBufferCopy region = {
+        .size = BUFFER_SIZE
+    };
+
+    CHECK(!beginHeadlessCommands(&headless), "begin commands");
+    vkCmdCopyBuffer(headless.commandBuffer, sourceBuffer, readbackBuffer, 1, &region);
+    CHECK(!submitHeadlessCommands(&headless), "submit copy");
+
+    CHECK(!oriInvalidateAllocation(deviceHandle, readback, 0, VK_WHOLE_SIZE), "invalidate readback buffer");
+    CHECK(!memcmp(readbackInfo.mappedData, sourceInfo.mappedData, BUFFER_SIZE), "read back flushed data");
+
+    // ===========================================
+    // non-coherent memory
+    //
+
+    // writes to memory that isn't host-coherent are always recorded, so they must be flushed (if there is any such memory)
+    uint32_t nonCoherentTypes = 0;
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+        const VkMemoryPropertyFlags flags = memoryProperties.memoryTypes[i].propertyFlags;
+        if (flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT && !(flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)) {
+            nonCoherentTypes |= 1u << i;
+        }
+    }
+
+    if (nonCoherentTypes) {
+        const VkMemoryRequirements requirements = {
+            .size = BUFFER_SIZE,
+            .alignment = 256,
+            .memoryTypeBits = nonCoherentTypes
+        };
+
+        oriHandle_t nonCoherent;
+        CHECK(!oriAllocateMemory(deviceHandle, &requirements, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, 0, true, &nonCoherent),
+            "allocate non-coherent memory");
+
+        CHECK(!oriMarkAllocationWritten(deviceHandle, nonCoherent, 1, 1), "mark memory as written");
+        CHECK(!oriFlushAllocations(deviceHandle), "flush written memory");
+        CHECK(oriFlushAllocations(deviceHandle) == ORION_RETURN_STATUS_SKIPPED, "skip flushes with nothing written");
+
+        CHECK(!oriFreeMemory(deviceHandle, nonCoherent), "free memory");
+    }
+
+    // ===========================================
+    // termination of API
+    //
+
+    oriFreeMemory(deviceHandle, source);
+    oriFreeMemory(deviceHandle, readback);
+
+    terminateHeadless(&headless);
+
+    printf("mapped memory test passed\n");
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "headless.h"
+
+#include <stdlib.h>
+
+#define CHUNK_SIZE 65536
+#define LARGE_SIZE 67108864     // large enough to be given a dedicated block
+#define MAX_BLOCKS 16
+#define MAP_PATH "orion_memory_map.json"
+
+headless_t headless;
+
+int main() {
+    // ===========================================
+    // initialise program
+    //
+
+    CHECK(!initHeadless(&headless, "Orion memory map test", 0, NULL), "set up headless device");
+
+    const oriHandle_t deviceHandle = headless.deviceHandle;
+
+    // ===========================================
+    // block enumeration
+    //
+
+    // a sub-allocation and a dedicated allocation are in two blocks
+    const VkMemoryRequirements requirements[] = {
+        { .size = CHUNK_SIZE, .alignment = 256, .memoryTypeBits = ~0u },
+        { .size = LARGE_SIZE, .alignment = 256, .memoryTypeBits = ~0u }
+    };
+
+    oriHandle_t allocations[2];
+    for (unsigned int i = 0; i < 2; i++) {
+        CHECK(!oriAllocateMemory(deviceHandle, &requirements[i], 0, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true, &allocations[i]),
+            "allocate memory");
+    }
+
+    unsigned int blockCount;
+    CHECK(!oriEnumerateMemoryBlocks(deviceHandle, 0, &blockCount, NULL), "count memory blocks");
+    CHECK(blockCount >= 2 && blockCount <= MAX_BLOCKS, "count memory blocks");
+
+    oriMemoryBlockStatistics_t blocks[MAX_BLOCKS];
+    unsigned int count;
+    CHECK(!oriEnumerateMemoryBlocks(deviceHandle, blockCount, &count, blocks), "enumerate memory blocks");
+    CHECK(count == blockCount, "enumerate every memory block");
+
+    // the blocks add up to the totals
+    oriDeviceMemoryStatistics_t statistics;
+    CHECK(!oriGetMemoryStatistics(deviceHandle, &statistics), "get memory statistics");
+
+    unsigned int allocationCount = 0;
+    unsigned int dedicatedCount = 0;
+    VkDeviceSize blockBytes = 0;
+    for (unsigned int i = 0; i < count; i++) {
+        allocationCount += blocks[i].statistics.allocationCount;
+        dedicatedCount += blocks[i].dedicated;
+        blockBytes += blocks[i].statistics.blockBytes;
+    }
+    CHECK(allocationCount == statistics.total.allocationCount && blockBytes == statistics.total.blockBytes, "add up block statistics");
+    CHECK(dedicatedCount, "enumerate dedicated blocks");
+
+    // an array too small for every block is filled, and the enumeration reported as incomplete
+    memset(blocks, 0, sizeof(blocks));
+    CHECK(oriEnumerateMemoryBlocks(deviceHandle, blockCount - 1, &count, blocks) == ORION_RETURN_STATUS_SKIPPED,
+        "report a truncated enumeration");
+    CHECK(count == blockCount - 1 && blocks[blockCount - 2].memory, "fill a truncated enumeration");
+
+    CHECK(oriEnumerateMemoryBlocks(deviceHandle, 0, &count, blocks) == ORION_RETURN_STATUS_SKIPPED && !count,
+        "report a truncated enumeration");
+
+    // ===========================================
+    // memory map
+    //
+
+    CHECK(!oriWriteMemoryMap(deviceHandle, MAP_PATH), "write memory map");
+
+    FILE *file = fopen(MAP_PATH, "rb");
+    CHECK(file, "open memory map");
+
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char *map = malloc(size + 1);
+    CHECK(map, "allocate host memory");
+    map[fread(map, 1, size, file)] = '\0';
+    fclose(file);
+
+    CHECK(map[0] == '{' && strstr(map, "\"total\"") && strstr(map, "\"heaps\"") && strstr(map, "\"memoryTypes\"") &&
+        strstr(map, "\"blocks\"") && strstr(map, "\"ranges\""), "write every section of the memory map");
+    CHECK(strstr(map, "\"dedicated\": true"), "write dedicated blocks to the memory map");
+
+    free(map);
+    remove(MAP_PATH);
+
+    // ===========================================
+    // termination of API
+    //
+
+    for (unsigned int i = 0; i < 2; i++) {
+        oriFreeMemory(deviceHandle, allocations[i]);
+    }
+
+    terminateHeadless(&headless);
+
+    printf("memory map test passed\n");
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include "headless.h"
+
+#define CHUNK_SIZE 65536
+
+headless_t headless;
+
+int main() {
+    // ===========================================
+    // initialise program
+    //
+
+    CHECK(!initHeadless(&headless, "Orion memory test", 0, NULL), "set up headless device");
+
+    const oriHandle_t deviceHandle = headless.deviceHandle;
+
+    // ===========================================
+    // sub-allocation
+    //
+
+    // (done first, so that the blocks hold nothing else)
+    const VkMemoryRequirements requirements = {
+        .size = CHUNK_SIZE,
+        .alignment = 256,
+        .memoryTypeBits = ~0u
+    };
+
+    oriHandle_t chunks[3];
+    for (unsigned int i = 0; i < 3; i++) {
+        CHECK(!oriAllocateMemory(deviceHandle, &requirements, 0, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true, &chunks[i]), "allocate memory");
+    }
+
+    oriDeviceMemoryStatistics_t statistics;
+    CHECK(!oriGetMemoryStatistics(deviceHandle, &statistics), "get memory statistics");
+    CHECK(statistics.total.allocationCount == 3, "count allocations");
+
+    // chunks of one block are placed back to back, and never overlap
+    oriAllocationInfo_t infos[3];
+    for (unsigned int i = 0; i < 3; i++) {
+        CHECK(!oriGetAllocationInfo(deviceHandle, chunks[i], &infos[i]), "get allocation info");
+        CHECK(!infos[i].dedicated && infos[i].size >= CHUNK_SIZE, "sub-allocate memory");
+    }
+    for (unsigned int i = 1; i < 3; i++) {
+        CHECK(infos[i].memory != infos[i - 1].memory || infos[i].offset >= infos[i - 1].offset + infos[i - 1].size,
+            "place chunks without overlap");
+    }
+
+    // ===========================================
+    // binding
+    //
+
+    const VkBufferCreateInfo bufferInfo = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size = CHUNK_SIZE / 2,
+        .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+    };
+
+    VkBuffer buffer;
+    CHECK(!vkCreateBuffer(headless.device, &bufferInfo, oriGetVulkanAllocators(), &buffer), "create buffer");
+
+    VkMemoryRequirements bufferRequirements;
+    vkGetBufferMemoryRequirements(headless.device, buffer, &bufferRequirements);
+
+    // binds that would run past the end of the allocation, or that are misaligned, must be rejected before reaching Vulkan
+    // (these report errors through the debug callback)
+    if (bufferRequirements.memoryTypeBits & (1u << infos[0].memoryTypeIndex) && bufferRequirements.size <= CHUNK_SIZE / 2 &&
+        !(infos[0].offset % bufferRequirements.alignment)
+    ) {
+        CHECK(oriBindBufferMemory(deviceHandle, chunks[0], buffer, CHUNK_SIZE), "reject binding past the allocation");
+        if (bufferRequirements.alignment > 1) {
+            CHECK(oriBindBufferMemory(deviceHandle, chunks[0], buffer, 1), "reject a misaligned bind");
+        }
+
+        CHECK(!oriBindBufferMemory(deviceHandle, chunks[0], buffer, 0), "bind buffer memory");
+    }
+
+    vkDestroyBuffer(headless.device, buffer, oriGetVulkanAllocators());
+
+    // ===========================================
+    // freeing
+    //
+
+    // free the middle chunk first, then its neighbours, which must merge back with it
+    CHECK(!oriFreeMemory(deviceHandle, chunks[1]), "free memory");
+    CHECK(!oriGetMemoryStatistics(deviceHandle, &statistics), "get memory statistics");
+    CHECK(statistics.total.allocationCount == 2, "count allocations after freeing");
+
+    CHECK(!oriFreeMemory(deviceHandle, chunks[0]), "free memory");
+    CHECK(!oriFreeMemory(deviceHandle, chunks[2]), "free memory");
+
+    CHECK(!oriGetMemoryStatistics(deviceHandle, &statistics), "get memory statistics");
+    CHECK(!statistics.total.allocationCount, "free every allocation");
+    CHECK(statistics.total.freeRangeCount == statistics.total.blockCount, "merge freed chunks");
+
+    // ===========================================
+    // termination of API
+    //
+
+    terminateHeadless(&headless);
+
+    printf("memory test passed\n");
+
+    return 0;
+}
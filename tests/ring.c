@@ -0,0 +1,68 @@
+#include "headless.h"
+
+#define RING_SIZE 1048576
+#define RING_FRAME_SIZE 393216
+
+headless_t headless;
+
+int main() {
+    // ===========================================
+    // initialise program
+    //
+
+    CHECK(!initHeadless(&headless, "Orion ring buffer test", 0, NULL), "set up headless device");
+
+    const oriHandle_t deviceHandle = headless.deviceHandle;
+
+    // ===========================================
+    // ring buffer
+    //
+
+    CHECK(!oriCreateDeviceRing(deviceHandle, RING_SIZE, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT), "create ring buffer");
+
+    // two frames don't leave room for a third, so it only fits once the first has been reclaimed
+    oriRingAllocation_t ranges[3];
+    for (uint64_t frame = 1; frame <= 2; frame++) {
+        oriRingAllocation_t *range = &ranges[frame - 1];
+        CHECK(!oriRingAllocate(deviceHandle, RING_FRAME_SIZE, range), "allocate from ring buffer");
+        CHECK(range->data, "map ring buffer");
+        CHECK(range->dynamicOffset == range->offset, "give a dynamic offset");
+        memset(range->data, (int) frame, RING_FRAME_SIZE);
+
+        CHECK(!oriRingEndFrame(deviceHandle, frame), "end ring buffer frame");
+    }
+
+    CHECK(ranges[1].buffer == ranges[0].buffer && ranges[1].offset >= ranges[0].offset + RING_FRAME_SIZE,
+        "place frames one after the other");
+
+    // (this reports an error through the debug callback)
+    CHECK(oriRingAllocate(deviceHandle, RING_FRAME_SIZE, &ranges[2]), "refuse to overwrite frames in flight");
+
+    // nothing is reclaimed until the frame's value is reached
+    CHECK(!oriRingReclaim(deviceHandle, 0), "reclaim ring buffer");
+    CHECK(oriRingAllocate(deviceHandle, RING_FRAME_SIZE, &ranges[2]), "refuse to overwrite frames in flight");
+
+    // the first frame is reclaimed, so the third wraps around into its space
+    CHECK(!oriRingReclaim(deviceHandle, 1), "reclaim ring buffer");
+    CHECK(!oriRingAllocate(deviceHandle, RING_FRAME_SIZE, &ranges[2]), "allocate from reclaimed ring buffer");
+    CHECK(!ranges[2].offset, "wrap around the ring buffer");
+
+    // the second frame is still in flight, and mustn't have been touched
+    const unsigned char *second = ranges[1].data;
+    for (unsigned int i = 0; i < RING_FRAME_SIZE; i++) {
+        CHECK(second[i] == 2, "keep frames in flight intact");
+    }
+
+    CHECK(!oriRingEndFrame(deviceHandle, 3), "end ring buffer frame");
+    CHECK(!oriRingReclaim(deviceHandle, 3), "reclaim ring buffer");
+
+    // ===========================================
+    // termination of API
+    //
+
+    terminateHeadless(&headless);
+
+    printf("ring buffer test passed\n");
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include "headless.h"
+
+#include <stdlib.h>
+
+#define STAGING_SIZE 65536
+#define UPLOAD_SIZE 262144  // larger than the staging buffer, so it must be split and submitted in pieces
+#define OVERLAP_OFFSET 1024
+#define OVERLAP_SIZE 1024
+
+headless_t headless;
+
+int main() {
+    // ===========================================
+    // initialise program
+    //
+
+    CHECK(!initHeadless(&headless, "Orion uploader test", 0, NULL), "set up headless device");
+
+    const oriHandle_t deviceHandle = headless.deviceHandle;
+
+    // ===========================================
+    // uploads
+    //
+
+    CHECK(!oriCreateDeviceUploader(deviceHandle, headless.transfer.familyIndex, headless.transfer.queueIndex, STAGING_SIZE),
+        "create uploader");
+
+    // nothing is pending yet
+    uint64_t uploadValue;
+    CHECK(oriSubmitUploads(deviceHandle, VK_NULL_HANDLE, &uploadValue) == ORION_RETURN_STATUS_SKIPPED, "skip empty submissions");
+
+    const VkBufferCreateInfo readbackInfo = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size = UPLOAD_SIZE,
+        .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+    };
+
+    oriHandle_t readback;
+    VkBuffer readbackBuffer;
+    CHECK(!oriCreateBufferForUsage(deviceHandle, &readbackInfo, ORION_MEMORY_USAGE_GPU_TO_CPU, &readback, &readbackBuffer),
+        "create readback buffer");
+
+    unsigned char *data = malloc(UPLOAD_SIZE);
+    unsigned char *expected = malloc(UPLOAD_SIZE);
+    CHECK(data && expected, "allocate host memory");
+
+    // the second upload overlaps the first, and must win
+    for (unsigned int i = 0; i < UPLOAD_SIZE; i++) {
+        data[i] = (unsigned char) (i * 7 + (i >> 8));
+        expected[i] = (i >= OVERLAP_OFFSET && i < OVERLAP_OFFSET + OVERLAP_SIZE) ? (unsigned char) ~i : data[i];
+    }
+
+    CHECK(!oriUploadToBuffer(deviceHandle, readbackBuffer, 0, data, UPLOAD_SIZE), "upload to buffer");
+
+    // the data is copied straight away, so it can be reused
+    for (unsigned int i = OVERLAP_OFFSET; i < OVERLAP_OFFSET + OVERLAP_SIZE; i++) {
+        data[i] = (unsigned char) ~i;
+    }
+    CHECK(!oriUploadToBuffer(deviceHandle, readbackBuffer, OVERLAP_OFFSET, &data[OVERLAP_OFFSET], OVERLAP_SIZE), "upload to buffer");
+    memset(data, 0, UPLOAD_SIZE);
+
+    CHECK(!oriSubmitUploads(deviceHandle, VK_NULL_HANDLE, &uploadValue), "submit uploads");
+    CHECK(!oriWaitForUploads(deviceHandle, uploadValue), "wait for uploads");
+
+    oriAllocationInfo_t readbackAllocation;
+    CHECK(!oriGetAllocationInfo(deviceHandle, readback, &readbackAllocation), "get allocation info");
+    CHECK(readbackAllocation.mappedData, "map readback buffer");
+    CHECK(!oriInvalidateAllocation(deviceHandle, readback, 0, VK_WHOLE_SIZE), "invalidate readback buffer");
+    CHECK(!memcmp(readbackAllocation.mappedData, expected, UPLOAD_SIZE), "read back uploaded data");
+
+    free(data);
+    free(expected);
+
+    // ===========================================
+    // termination of API
+    //
+
+    oriFreeMemory(deviceHandle, readback);
+    terminateHeadless(&headless);
+
+    printf("uploader test passed\n");
+
+    return 0;
+}
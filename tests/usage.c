@@ -0,0 +1,116 @@
+#include "headless.h"
+
+#define BUFFER_SIZE 65536
+
+headless_t headless;
+
+const VkMemoryPropertyFlags requiredFlags[] = {
+    [ORION_MEMORY_USAGE_GPU_ONLY] = 0,
+    [ORION_MEMORY_USAGE_UPLOAD_ONCE] = 0,
+    [ORION_MEMORY_USAGE_CPU_TO_GPU] = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+    [ORION_MEMORY_USAGE_GPU_TO_CPU] = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+    [ORION_MEMORY_USAGE_STAGING] = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+};
+
+int main() {
+    // ===========================================
+    // initialise program
+    //
+
+    CHECK(!initHeadless(&headless, "Orion memory usage test", 0, NULL), "set up headless device");
+
+    const oriHandle_t deviceHandle = headless.deviceHandle;
+
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    vkGetPhysicalDeviceMemoryProperties(headless.physicalDevice, &memoryProperties);
+
+    bool deviceLocal = false;
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+        deviceLocal |= !!(memoryProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    }
+
+    // ===========================================
+    // memory type choice
+    //
+
+    for (unsigned int usage = 0; usage < sizeof(requiredFlags) / sizeof(requiredFlags[0]); usage++) {
+        uint32_t index;
+        CHECK(!oriFindMemoryTypeForUsage(deviceHandle, usage, ~0u, &index), "find a memory type for a usage");
+        CHECK(index < memoryProperties.memoryTypeCount, "find a memory type for a usage");
+
+        const VkMemoryPropertyFlags flags = memoryProperties.memoryTypes[index].propertyFlags;
+        CHECK((flags & requiredFlags[usage]) == requiredFlags[usage], "find a memory type with the required properties");
+        CHECK(!(flags & (VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT | VK_MEMORY_PROPERTY_PROTECTED_BIT)),
+            "skip lazily allocated and protected memory types");
+
+        // only the memory types allowed by the mask can be chosen
+        uint32_t masked;
+        CHECK(!oriFindMemoryTypeForUsage(deviceHandle, usage, 1u << index, &masked) && masked == index, "find a masked memory type");
+
+        const oriReturnStatus_t status = oriFindMemoryTypeForUsage(deviceHandle, usage, ~(1u << index), &masked);
+        CHECK(status || masked != index, "exclude a masked memory type");
+    }
+
+    uint32_t gpuOnlyIndex;
+    CHECK(!oriFindMemoryTypeForUsage(deviceHandle, ORION_MEMORY_USAGE_GPU_ONLY, ~0u, &gpuOnlyIndex), "find a memory type for a usage");
+    CHECK(!deviceLocal || memoryProperties.memoryTypes[gpuOnlyIndex].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        "prefer device-local memory for GPU-only resources");
+
+    // (these report errors through the debug callback)
+    uint32_t index;
+    CHECK(oriFindMemoryTypeForUsage(deviceHandle, ORION_MEMORY_USAGE_GPU_ONLY, 0, &index), "reject an empty mask");
+    CHECK(oriFindMemoryTypeForUsage(deviceHandle, (oriMemoryUsage_t) 99, ~0u, &index), "reject an unknown usage");
+
+    // ===========================================
+    // allocation
+    //
+
+    const VkBufferCreateInfo bufferInfo = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size = BUFFER_SIZE,
+        .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+    };
+
+    // memory that the CPU writes to is persistently mapped
+    const oriMemoryUsage_t hostUsages[] = { ORION_MEMORY_USAGE_CPU_TO_GPU, ORION_MEMORY_USAGE_STAGING };
+    for (unsigned int i = 0; i < sizeof(hostUsages) / sizeof(hostUsages[0]); i++) {
+        oriHandle_t allocation;
+        VkBuffer buffer;
+        CHECK(!oriCreateBufferForUsage(deviceHandle, &bufferInfo, hostUsages[i], &allocation, &buffer), "create buffer for a usage");
+
+        oriAllocationInfo_t info;
+        CHECK(!oriGetAllocationInfo(deviceHandle, allocation, &info), "get allocation info");
+        CHECK(info.propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT && info.mappedData, "map host-visible memory");
+        CHECK(info.buffer == buffer, "bind buffer memory");
+
+        memset(info.mappedData, 0xff, BUFFER_SIZE);
+
+        CHECK(!oriFreeMemory(deviceHandle, allocation), "free memory");
+    }
+
+    const VkMemoryRequirements requirements = {
+        .size = BUFFER_SIZE,
+        .alignment = 256,
+        .memoryTypeBits = ~0u
+    };
+
+    oriHandle_t allocation;
+    CHECK(!oriAllocateMemoryForUsage(deviceHandle, &requirements, ORION_MEMORY_USAGE_GPU_ONLY, true, &allocation), "allocate memory for a usage");
+
+    oriAllocationInfo_t info;
+    CHECK(!oriGetAllocationInfo(deviceHandle, allocation, &info), "get allocation info");
+    CHECK(info.memoryTypeIndex == gpuOnlyIndex, "allocate from the chosen memory type");
+
+    CHECK(!oriFreeMemory(deviceHandle, allocation), "free memory");
+
+    // ===========================================
+    // termination of API
+    //
+
+    terminateHeadless(&headless);
+
+    printf("memory usage test passed\n");
+
+    return 0;
+}